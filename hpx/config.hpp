@@ -184,6 +184,13 @@
 #  define HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS 4096
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+/// This defines the time (in microseconds) pending decrements of global
+/// reference counts are buffered before being sent to AGAS.
+#if !defined(HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL)
+#  define HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL 1000
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 /// This defines the initial global reference count associated with any created
 /// object.
@@ -457,6 +464,13 @@
 #  define HPX_HUGE_STACK_SIZE     0x2000000       // 32MByte
 #endif
 
+// Stackless threads don't own a stack, they run to completion on the stack of
+// the worker thread executing them. This value is used as their 'stack size'
+// to distinguish them from all other threads.
+#if !defined(HPX_NOSTACK_STACK_SIZE)
+#  define HPX_NOSTACK_STACK_SIZE  0x7fffffff
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 // This limits how deep the internal recursion of future continuations will go
 // before a new operation is re-spawned.
@@ -0,0 +1,13 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_COMPRESSION_ZSTD_MAR_14_2017_0405PM)
+#define HPX_COMPRESSION_ZSTD_MAR_14_2017_0405PM
+
+#include <hpx/config.hpp>
+#include <hpx/plugins/binary_filter/zstd_serialization_filter.hpp>
+
+#endif
+
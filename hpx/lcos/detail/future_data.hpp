@@ -876,6 +876,14 @@ namespace detail
             return threads::invalid_thread_id;
         }
 
+        // return a thread function running this task, this allows to create
+        // the HPX thread for it separately
+        virtual threads::thread_function_type get_thread_function()
+        {
+            HPX_ASSERT(false);      // shouldn't ever be called
+            return threads::thread_function_type();
+        }
+
     protected:
         static threads::thread_result_type run_impl(future_base_type this_)
         {
@@ -16,6 +16,8 @@
 #include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/traits/future_access.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/bind.hpp>
 #include <hpx/util/deferred_call.hpp>
 #include <hpx/util/thread_description.hpp>
 
@@ -137,6 +139,18 @@ namespace hpx { namespace lcos { namespace local
                     return threads::invalid_thread_id;
                 }
             }
+
+            threads::thread_function_type get_thread_function()
+            {
+                HPX_ASSERT(!this->sched_);
+                this->check_started();
+
+                typedef typename Base::future_base_type future_base_type;
+                future_base_type this_(this);
+
+                return util::bind(
+                    util::one_shot(&base_type::run_impl), std::move(this_));
+            }
         };
 
         template <typename Result, typename F>
@@ -377,6 +391,21 @@ namespace hpx { namespace lcos { namespace local
             return task_->apply(policy, priority, stacksize, ec);
         }
 
+        // Mark the task as started and return a thread function running it.
+        // This allows to create the HPX thread executing the task separately,
+        // for instance together with many other threads at once (see
+        // threads::register_work_plain).
+        threads::thread_function_type get_thread_function() const
+        {
+            if (!task_) {
+                HPX_THROW_EXCEPTION(task_moved,
+                    "futures_factory<Result()>::get_thread_function()",
+                    "futures_factory invalid (has it been moved?)");
+                return threads::thread_function_type();
+            }
+            return task_->get_thread_function();
+        }
+
         // This is the same as get_future, except that it moves the
         // shared state into the returned future.
         lcos::future<Result> get_future(error_code& ec = throws)
@@ -19,6 +19,10 @@ namespace hpx { namespace parallel { namespace execution
 {
     /// Refers to the currently used base-executor
     using default_executor = threads::executors::default_executor;
+
+    /// Executor creating stackless threads, those run to completion on the
+    /// stack of the worker thread and must not suspend
+    using stackless_executor = threads::executors::stackless_executor;
 }}}
 
 #if defined(HPX_HAVE_EXECUTOR_COMPATIBILITY)
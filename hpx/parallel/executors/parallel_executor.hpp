@@ -12,19 +12,25 @@
 #include <hpx/apply.hpp>
 #include <hpx/async.hpp>
 #include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/futures_factory.hpp>
 #include <hpx/lcos/when_all.hpp>
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
 #include <hpx/parallel/executors/static_chunk_size.hpp>
 #include <hpx/runtime/launch_policy.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/runtime/threads/thread_init_data.hpp>
 #include <hpx/traits/is_executor.hpp>
 #include <hpx/traits/future_traits.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/bind.hpp>
+#include <hpx/util/deferred_call.hpp>
 #include <hpx/util/range.hpp>
+#include <hpx/util/thread_description.hpp>
 
 #include <algorithm>
 #include <cstddef>
+#include <exception>
 #include <functional>
 #include <type_traits>
 #include <utility>
@@ -168,6 +174,47 @@ namespace hpx { namespace parallel { namespace execution
             // spawn all tasks sequentially
             HPX_ASSERT(base + size <= results.size());
 
+            if (l_ == launch::async)
+            {
+                // register all threads at once, this allows for the
+                // scheduler to distribute them over its queues in one go
+                std::vector<threads::thread_init_data> data;
+                data.reserve(size);
+
+                util::thread_description desc(
+                    func, "parallel_executor::bulk_async_execute");
+
+                try {
+                    for (std::size_t i = 0; i != size; ++i, ++it)
+                    {
+                        lcos::local::futures_factory<Result()> p(
+                            util::deferred_call(func, *it, ts...));
+
+                        data.emplace_back(p.get_thread_function(), desc, 0,
+                            l_.priority());
+                        results[base + i] = p.get_future();
+                    }
+
+                    threads::register_work_plain(data.data(), data.size());
+                }
+                catch (...) {
+                    // The work items are consumed in order, the thread
+                    // functions of the tasks which have not been handed to
+                    // the scheduler are still in place. Those tasks will
+                    // never run, their futures report the error instead.
+                    std::exception_ptr e = std::current_exception();
+                    for (std::size_t i = 0; i != size; ++i)
+                    {
+                        if (i >= data.size() || !data[i].func.empty())
+                        {
+                            results[base + i] =
+                                hpx::make_exceptional_future<Result>(e);
+                        }
+                    }
+                }
+                return hpx::make_ready_future();
+            }
+
             for (std::size_t i = 0; i != size; ++i, ++it)
             {
                 results[base + i] = hpx::async(l_, func, *it, ts...);
@@ -0,0 +1,273 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_BLOCK_COMPRESSION_FILTER_MAR_14_2017_0312PM)
+#define HPX_BLOCK_COMPRESSION_FILTER_MAR_14_2017_0312PM
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/error.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/serialization/binary_filter.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace plugins { namespace compression
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Common base for serialization filters compressing the data in
+    // independent blocks. The blocks are compressed concurrently on HPX
+    // worker threads (if invoked on one), decompression happens block by
+    // block as the data is consumed by the archive.
+    //
+    // The compressed data is laid out as:
+    //
+    //      std::uint32_t num_blocks
+    //      num_blocks x { std::uint32_t raw_size, std::uint32_t size }
+    //      num_blocks x compressed block data
+    //
+    // The Derived type has to expose:
+    //
+    //      static std::size_t compress_bound(std::size_t size);
+    //      static std::size_t compress_block(char const* src,
+    //          std::size_t src_count, char* dst, std::size_t dst_count);
+    //      static void decompress_block(char const* src,
+    //          std::size_t src_count, char* dst, std::size_t dst_count);
+    //
+    template <typename Derived>
+    class block_compression_filter : public serialization::binary_filter
+    {
+    public:
+        static std::size_t const default_block_size = 256 * 1024;
+
+        block_compression_filter(bool compress = false,
+                std::size_t block_size = default_block_size)
+          : block_size_(block_size), compress_(compress), current_(0),
+            compressed_(nullptr), decompressed_size_(0), next_block_(0)
+        {}
+
+        void set_max_length(std::size_t size)
+        {
+            buffer_.reserve(size);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void save(void const* src, std::size_t src_count)
+        {
+            char const* src_begin = static_cast<char const*>(src);
+            std::copy(src_begin, src_begin + src_count,
+                std::back_inserter(buffer_));
+        }
+
+        bool flush(void* dst, std::size_t dst_count, std::size_t& written)
+        {
+            std::size_t const num_blocks =
+                (buffer_.size() + block_size_ - 1) / block_size_;
+            std::size_t const header_size =
+                sizeof(std::uint32_t) * (1 + 2 * num_blocks);
+
+            // make sure we have enough memory for compressing all blocks
+            // side by side
+            std::vector<std::size_t> offsets(num_blocks + 1, header_size);
+            for (std::size_t i = 0; i != num_blocks; ++i)
+            {
+                offsets[i + 1] = offsets[i] +
+                    Derived::compress_bound(raw_block_size(i));
+            }
+
+            if (offsets[num_blocks] > dst_count)
+            {
+                written = 0;
+                return false;
+            }
+
+            char* dst_begin = static_cast<char*>(dst);
+            std::vector<std::size_t> sizes(num_blocks, 0);
+
+            auto compress =
+                [&](std::size_t i)
+                {
+                    sizes[i] = Derived::compress_block(
+                        buffer_.data() + i * block_size_, raw_block_size(i),
+                        dst_begin + offsets[i], offsets[i + 1] - offsets[i]);
+                };
+
+            if (num_blocks > 1 && threads::get_self_ptr() != nullptr)
+            {
+                // compress all but the first block on other threads
+                std::vector<hpx::future<void> > blocks;
+                blocks.reserve(num_blocks - 1);
+                for (std::size_t i = 1; i != num_blocks; ++i)
+                    blocks.push_back(hpx::async(compress, i));
+
+                compress(0);
+
+                hpx::wait_all(blocks);
+                for (hpx::future<void>& f : blocks)
+                    f.get();            // rethrow exceptions, if any
+            }
+            else
+            {
+                for (std::size_t i = 0; i != num_blocks; ++i)
+                    compress(i);
+            }
+
+            // write the block table and move the blocks next to each other
+            char* header = dst_begin;
+            store_value(header, num_blocks);
+
+            std::size_t pos = header_size;
+            for (std::size_t i = 0; i != num_blocks; ++i)
+            {
+                store_value(header, raw_block_size(i));
+                store_value(header, sizes[i]);
+
+                if (pos != offsets[i])
+                {
+                    std::memmove(
+                        dst_begin + pos, dst_begin + offsets[i], sizes[i]);
+                }
+                pos += sizes[i];
+            }
+
+            written = pos;
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        std::size_t init_data(char const* buffer, std::size_t size,
+            std::size_t buffer_size)
+        {
+            // read the block table, the blocks are decompressed on demand
+            if (size < sizeof(std::uint32_t))
+            {
+                HPX_THROW_EXCEPTION(serialization_error,
+                    "block_compression_filter::init_data",
+                    "archive data bstream is too short");
+                return 0;
+            }
+
+            char const* header = buffer;
+            std::size_t const num_blocks = load_value(header);
+            std::size_t const header_size =
+                sizeof(std::uint32_t) * (1 + 2 * num_blocks);
+            if (size < header_size)
+            {
+                HPX_THROW_EXCEPTION(serialization_error,
+                    "block_compression_filter::init_data",
+                    "archive data bstream is too short");
+                return 0;
+            }
+
+            blocks_.resize(num_blocks);
+
+            std::size_t raw_size = 0;
+            std::size_t offset = header_size;
+            for (block& b : blocks_)
+            {
+                b.raw_size_ = load_value(header);
+                b.size_ = load_value(header);
+                b.offset_ = offset;
+                offset += b.size_;
+                raw_size += b.raw_size_;
+            }
+
+            // The decompressed size reported by the archive includes the
+            // (uncompressed) archive header written before the filter was
+            // installed, the blocks cover only the data following it.
+            if (offset > size || raw_size > buffer_size)
+            {
+                HPX_THROW_EXCEPTION(serialization_error,
+                    "block_compression_filter::init_data",
+                    "inconsistent compressed archive data");
+                return 0;
+            }
+
+            compressed_ = buffer;
+            buffer_.resize(raw_size);
+            decompressed_size_ = 0;
+            next_block_ = 0;
+            current_ = 0;
+
+            return raw_size;
+        }
+
+        void load(void* dst, std::size_t dst_count)
+        {
+            if (current_ + dst_count > buffer_.size())
+            {
+                HPX_THROW_EXCEPTION(serialization_error,
+                    "block_compression_filter::load",
+                    "archive data bstream is too short");
+                return;
+            }
+
+            // decompress as many blocks as needed to satisfy the request
+            while (decompressed_size_ < current_ + dst_count)
+            {
+                HPX_ASSERT(next_block_ < blocks_.size());
+
+                block const& b = blocks_[next_block_++];
+                Derived::decompress_block(compressed_ + b.offset_, b.size_,
+                    buffer_.data() + decompressed_size_, b.raw_size_);
+                decompressed_size_ += b.raw_size_;
+            }
+
+            std::memcpy(dst, &buffer_[current_], dst_count);
+            current_ += dst_count;
+        }
+
+    private:
+        std::size_t raw_block_size(std::size_t i) const
+        {
+            return (std::min)(block_size_, buffer_.size() - i * block_size_);
+        }
+
+        static void store_value(char*& p, std::size_t value)
+        {
+            std::uint32_t v = static_cast<std::uint32_t>(value);
+            std::memcpy(p, &v, sizeof(v));
+            p += sizeof(v);
+        }
+
+        static std::size_t load_value(char const*& p)
+        {
+            std::uint32_t v = 0;
+            std::memcpy(&v, p, sizeof(v));
+            p += sizeof(v);
+            return v;
+        }
+
+        struct block
+        {
+            std::size_t raw_size_;
+            std::size_t size_;
+            std::size_t offset_;
+        };
+
+        std::size_t block_size_;
+        std::vector<char> buffer_;
+        bool compress_;
+        std::size_t current_;
+
+        // decompression state
+        char const* compressed_;
+        std::vector<block> blocks_;
+        std::size_t decompressed_size_;
+        std::size_t next_block_;
+    };
+}}}
+
+#endif
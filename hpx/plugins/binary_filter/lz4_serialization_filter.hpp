@@ -0,0 +1,53 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_ACTION_LZ4_SERIALIZATION_FILTER_MAR_14_2017_0345PM)
+#define HPX_ACTION_LZ4_SERIALIZATION_FILTER_MAR_14_2017_0345PM
+
+#include <hpx/config.hpp>
+#include <hpx/plugins/binary_filter/lz4_serialization_filter_registration.hpp>
+
+#if defined(HPX_HAVE_COMPRESSION_LZ4)
+
+#include <hpx/plugins/binary_filter/block_compression_filter.hpp>
+#include <hpx/runtime/serialization/binary_filter.hpp>
+
+#include <cstddef>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace plugins { namespace compression
+{
+    // LZ4 compression of independent blocks, optimized for latency
+    struct HPX_LIBRARY_EXPORT lz4_serialization_filter
+      : public block_compression_filter<lz4_serialization_filter>
+    {
+        lz4_serialization_filter(bool compress = false,
+                serialization::binary_filter* next_filter = nullptr)
+          : block_compression_filter<lz4_serialization_filter>(compress)
+        {}
+
+        static std::size_t compress_bound(std::size_t size);
+        static std::size_t compress_block(char const* src,
+            std::size_t src_count, char* dst, std::size_t dst_count);
+        static void decompress_block(char const* src,
+            std::size_t src_count, char* dst, std::size_t dst_count);
+
+    private:
+        // serialization support
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        HPX_FORCEINLINE void serialize(Archive& ar, const unsigned int) {}
+
+        HPX_SERIALIZATION_POLYMORPHIC(lz4_serialization_filter);
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
+#endif
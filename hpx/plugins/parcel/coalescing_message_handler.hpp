@@ -60,6 +60,8 @@ namespace hpx { namespace plugins { namespace parcel
         std::int64_t get_messages_count(bool reset);
         std::int64_t get_parcels_per_message_count(bool reset);
         std::int64_t get_average_time_between_parcels(bool reset);
+        std::int64_t get_batch_size(bool reset);
+        std::int64_t get_interval(bool reset);
         std::vector<std::int64_t>
             get_time_between_parcels_histogram(bool reset);
         void get_time_between_parcels_histogram_creator(
@@ -78,12 +80,23 @@ namespace hpx { namespace plugins { namespace parcel
 
         void update_num_messages();
         void update_interval();
+        void update_latency_budget();
+
+        void adapt_parameters();
 
     private:
         mutable mutex_type mtx_;
         parcelset::parcelport* pp_;
         std::size_t num_coalesced_parcels_;
         std::size_t interval_;
+
+        // adaptive mode: the number of parcels and the interval are derived
+        // from the observed parcel arrival rate such that coalescing adds at
+        // most latency_budget_ [us] to the time a parcel is sent
+        bool adaptive_;
+        std::size_t max_coalesced_parcels_;
+        std::size_t latency_budget_;
+        double average_arrival_;        // moving average, [ns]
         detail::message_buffer buffer_;
         util::pool_timer timer_;
         bool stopped_;
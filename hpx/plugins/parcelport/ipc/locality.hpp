@@ -0,0 +1,131 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_IPC_LOCALITY_HPP
+#define HPX_PARCELSET_POLICIES_IPC_LOCALITY_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_IPC)
+
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/string.hpp>
+
+#include <boost/io/ios_state.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace hpx { namespace parcelset
+{
+    namespace policies { namespace ipc
+    {
+        // A locality reachable through shared memory is identified by the
+        // name of the host it runs on, by its process id, and by a token
+        // which is chosen randomly for each run. The latter two are used to
+        // derive the name of the shared memory segment the locality receives
+        // its messages through. Process ids are unique only within one pid
+        // namespace, the token keeps processes in different containers
+        // sharing the same /dev/shm from colliding.
+        class locality
+        {
+        public:
+            locality()
+              : pid_(-1), token_(0)
+            {}
+
+            locality(std::string const& host, std::int32_t pid,
+                    std::uint64_t token)
+              : host_(host), pid_(pid), token_(token)
+            {}
+
+            std::string const& host() const
+            {
+                return host_;
+            }
+
+            std::int32_t pid() const
+            {
+                return pid_;
+            }
+
+            std::uint64_t token() const
+            {
+                return token_;
+            }
+
+            /// Return the name of the shared memory segment of this locality
+            std::string segment_name() const
+            {
+                return "/hpx.ipc." + std::to_string(pid_) + "." +
+                    std::to_string(token_);
+            }
+
+            static const char *type()
+            {
+                return "ipc";
+            }
+
+            explicit operator bool() const noexcept
+            {
+                return pid_ != -1;
+            }
+
+            void save(serialization::output_archive & ar) const
+            {
+                ar << host_;
+                ar << pid_;
+                ar << token_;
+            }
+
+            void load(serialization::input_archive & ar)
+            {
+                ar >> host_;
+                ar >> pid_;
+                ar >> token_;
+            }
+
+        private:
+            friend bool operator==(locality const & lhs, locality const & rhs)
+            {
+                return lhs.pid_ == rhs.pid_ && lhs.token_ == rhs.token_ &&
+                    lhs.host_ == rhs.host_;
+            }
+
+            friend bool operator<(locality const & lhs, locality const & rhs)
+            {
+                return lhs.host_ < rhs.host_ ||
+                    (lhs.host_ == rhs.host_ && (lhs.pid_ < rhs.pid_ ||
+                        (lhs.pid_ == rhs.pid_ && lhs.token_ < rhs.token_)));
+            }
+
+            friend std::size_t hash_value(locality const & loc)
+            {
+                return std::hash<std::string>()(loc.host_) ^
+                    std::hash<std::int32_t>()(loc.pid_) ^
+                    std::hash<std::uint64_t>()(loc.token_);
+            }
+
+            friend std::ostream & operator<<(std::ostream & os, locality const & loc)
+            {
+                boost::io::ios_flags_saver ifs(os);
+                os << loc.host_ << ":" << loc.pid_ << "." << loc.token_;
+
+                return os;
+            }
+
+            std::string host_;
+            std::int32_t pid_;
+            std::uint64_t token_;
+        };
+    }}
+}}
+
+#endif
+
+#endif
@@ -0,0 +1,411 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_IPC_RECEIVER_HPP
+#define HPX_PARCELSET_POLICIES_IPC_RECEIVER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_IPC)
+
+#include <hpx/compat/thread.hpp>
+#include <hpx/error_code.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/performance_counters/parcels/data_point.hpp>
+#include <hpx/plugins/parcelport/ipc/shared_memory_segment.hpp>
+#include <hpx/runtime/parcelset/decode_parcels.hpp>
+#include <hpx/runtime/parcelset/parcel_buffer.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/function.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/logging.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace ipc
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Receives the messages written to one slot (ring) of the shared memory
+    // segment. Messages are read piece-wise as they become available.
+    template <typename Parcelport>
+    struct receiver_connection
+    {
+    private:
+        enum connection_state
+        {
+            rcv_size
+          , rcv_data_size
+          , rcv_num_chunks
+          , rcv_transmission_chunks
+          , rcv_data
+          , rcv_chunks
+        };
+
+        typedef std::vector<char> data_type;
+        typedef parcel_buffer<data_type, data_type> buffer_type;
+
+    public:
+        receiver_connection()
+          : state_(rcv_size)
+          , chunks_idx_(0)
+          , offset_(0)
+          , failed_(false)
+        {}
+
+        /// Return whether no message is partially received
+        bool idle() const
+        {
+            return state_ == rcv_size && offset_ == 0;
+        }
+
+        /// Return whether a message has been rejected, no further data is
+        /// received through this connection
+        bool failed() const
+        {
+            return failed_;
+        }
+
+        /// Read whatever is available in the ring, returns whether any
+        /// progress has been made
+        bool receive(Parcelport& pp, shared_memory_segment& segment,
+            std::size_t slot, std::size_t num_thread)
+        {
+            bool has_work = false;
+            while (!failed_ && segment.available(slot) != 0)
+            {
+                has_work = true;
+
+                std::pair<char*, std::size_t> target = current_target();
+                offset_ += segment.read(slot, target.first + offset_,
+                    target.second - offset_);
+
+                if (offset_ != target.second)
+                    break;
+
+                offset_ = 0;
+                next_state(pp, num_thread);
+            }
+
+            // let the sender know that its data is not accepted anymore
+            if (failed_)
+            {
+                segment.fail_slot(slot);
+                segment.discard(slot);
+            }
+            return has_work;
+        }
+
+    private:
+        std::pair<char*, std::size_t> current_target()
+        {
+            switch (state_)
+            {
+            case rcv_size:
+                return std::make_pair(reinterpret_cast<char*>(&buffer_.size_),
+                    sizeof(buffer_.size_));
+
+            case rcv_data_size:
+                return std::make_pair(
+                    reinterpret_cast<char*>(&buffer_.data_size_),
+                    sizeof(buffer_.data_size_));
+
+            case rcv_num_chunks:
+                return std::make_pair(
+                    reinterpret_cast<char*>(&buffer_.num_chunks_),
+                    sizeof(buffer_.num_chunks_));
+
+            case rcv_transmission_chunks:
+                return std::make_pair(
+                    reinterpret_cast<char*>(buffer_.transmission_chunks_.data()),
+                    buffer_.transmission_chunks_.size() *
+                        sizeof(typename buffer_type::transmission_chunk_type));
+
+            case rcv_data:
+                return std::make_pair(buffer_.data_.data(),
+                    buffer_.data_.size());
+
+            case rcv_chunks:
+                return std::make_pair(buffer_.chunks_[chunks_idx_].data(),
+                    buffer_.chunks_[chunks_idx_].size());
+
+            default:
+                HPX_ASSERT(false);
+            }
+            return std::pair<char*, std::size_t>(nullptr, 0);
+        }
+
+        void next_state(Parcelport& pp, std::size_t num_thread)
+        {
+            switch (state_)
+            {
+            case rcv_size:
+                {
+                    performance_counters::parcels::data_point& data =
+                        buffer_.data_point_;
+                    data.time_ = timer_.elapsed_nanoseconds();
+                    data.serialization_time_ = 0;
+                    data.num_parcels_ = 0;
+
+                    std::uint64_t inbound_size = buffer_.size_;
+                    if (inbound_size > static_cast<std::uint64_t>(
+                            pp.get_max_inbound_message_size()))
+                    {
+                        // this is invoked from background work, report the
+                        // problem as a connection error instead of throwing
+                        LPT_(error)
+                            << "ipc::receiver_connection::next_state: "
+                               "received message exceeds the maximal "
+                               "inbound message size (" << inbound_size
+                            << "), closing connection";
+                        failed_ = true;
+                        return;
+                    }
+                    data.bytes_ = static_cast<std::size_t>(inbound_size);
+                    state_ = rcv_data_size;
+                }
+                break;
+
+            case rcv_data_size:
+                state_ = rcv_num_chunks;
+                break;
+
+            case rcv_num_chunks:
+                {
+                    std::size_t num_zero_copy_chunks =
+                        static_cast<std::size_t>(
+                            static_cast<std::uint32_t>(buffer_.num_chunks_.first));
+                    std::size_t num_non_zero_copy_chunks =
+                        static_cast<std::size_t>(
+                            static_cast<std::uint32_t>(buffer_.num_chunks_.second));
+
+                    buffer_.data_.resize(static_cast<std::size_t>(buffer_.size_));
+                    if (num_zero_copy_chunks != 0)
+                    {
+                        buffer_.transmission_chunks_.resize(
+                            num_zero_copy_chunks + num_non_zero_copy_chunks);
+                        state_ = rcv_transmission_chunks;
+                    }
+                    else
+                    {
+                        state_ = rcv_data;
+                        if (buffer_.data_.empty())
+                            next_state(pp, num_thread);
+                    }
+                }
+                break;
+
+            case rcv_transmission_chunks:
+                state_ = rcv_data;
+                if (buffer_.data_.empty())
+                    next_state(pp, num_thread);
+                break;
+
+            case rcv_data:
+                {
+                    std::size_t num_zero_copy_chunks =
+                        static_cast<std::size_t>(
+                            static_cast<std::uint32_t>(buffer_.num_chunks_.first));
+
+                    buffer_.chunks_.resize(num_zero_copy_chunks);
+                    for (std::size_t i = 0; i != num_zero_copy_chunks; ++i)
+                    {
+                        buffer_.chunks_[i].resize(static_cast<std::size_t>(
+                            buffer_.transmission_chunks_[i].second));
+                    }
+
+                    chunks_idx_ = 0;
+                    state_ = rcv_chunks;
+                    skip_empty_chunks(pp, num_thread);
+                }
+                break;
+
+            case rcv_chunks:
+                ++chunks_idx_;
+                skip_empty_chunks(pp, num_thread);
+                break;
+
+            default:
+                HPX_ASSERT(false);
+            }
+        }
+
+        void skip_empty_chunks(Parcelport& pp, std::size_t num_thread)
+        {
+            while (chunks_idx_ != buffer_.chunks_.size() &&
+                buffer_.chunks_[chunks_idx_].empty())
+            {
+                ++chunks_idx_;
+            }
+
+            if (chunks_idx_ == buffer_.chunks_.size())
+                done(pp, num_thread);
+        }
+
+        void done(Parcelport& pp, std::size_t num_thread)
+        {
+            performance_counters::parcels::data_point& data = buffer_.data_point_;
+            data.time_ = timer_.elapsed_nanoseconds() - data.time_;
+
+            decode_parcels(pp, std::move(buffer_), num_thread);
+            buffer_ = buffer_type();
+
+            chunks_idx_ = 0;
+            state_ = rcv_size;
+        }
+
+        util::high_resolution_timer timer_;
+
+        connection_state state_;
+        buffer_type buffer_;
+        std::size_t chunks_idx_;
+        std::size_t offset_;
+        bool failed_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Owns the shared memory segment of this locality and polls its slots
+    // for incoming messages. The slots are polled from background work, a
+    // dedicated OS thread waits on the doorbell of the segment and invokes
+    // the given notification function whenever new data arrives, which
+    // makes sure an idle (parked) worker thread gets woken up to poll.
+    template <typename Parcelport>
+    struct receiver
+    {
+        typedef hpx::lcos::local::spinlock mutex_type;
+        typedef receiver_connection<Parcelport> connection_type;
+
+        // maximal time the doorbell thread sleeps before checking whether
+        // it should exit
+        static std::int64_t const doorbell_timeout_us = 100000;
+
+        receiver(Parcelport & pp)
+          : pp_(pp)
+          , running_(false)
+        {}
+
+        ~receiver()
+        {
+            stop();
+        }
+
+        bool run(std::string const& name, std::size_t num_slots,
+            std::size_t ring_size, util::function_nonser<void()> notify,
+            error_code& ec = throws)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            if (!segment_.create(name, num_slots, ring_size, ec))
+                return false;
+
+            connections_.resize(num_slots);
+
+            notify_ = std::move(notify);
+            running_.store(true);
+            doorbell_thread_ = compat::thread(&receiver::wait_for_data, this);
+            return true;
+        }
+
+        void stop()
+        {
+            if (running_.exchange(false))
+            {
+                segment_.ring_doorbell();
+                doorbell_thread_.join();
+            }
+
+            std::lock_guard<mutex_type> l(mtx_);
+            segment_.close();
+            connections_.clear();
+        }
+
+        bool background_work(std::size_t num_thread)
+        {
+            std::unique_lock<mutex_type> l(mtx_, std::try_to_lock);
+            if (!l || connections_.empty())
+                return false;
+
+            bool has_work = false;
+            for (std::size_t i = 0; i != connections_.size(); ++i)
+            {
+                std::uint32_t state = segment_.slot_state(i);
+                if (state == detail::slot_free)
+                    continue;
+
+                connection_type& c = connections_[i];
+                if (state == detail::slot_failed || c.failed())
+                {
+                    // drop whatever is sent through a rejected connection
+                    segment_.discard(i);
+                }
+                else if (c.receive(pp_, segment_, i, num_thread))
+                {
+                    has_work = true;
+                }
+
+                // the sender is gone, make the slot available once all of
+                // its messages have been received
+                if (state == detail::slot_closed &&
+                    segment_.available(i) == 0 && (c.idle() || c.failed()))
+                {
+                    segment_.free_slot(i);
+                    c = connection_type();
+                }
+            }
+            return has_work;
+        }
+
+        /// Return whether data is waiting to be received
+        bool has_pending_data()
+        {
+            std::unique_lock<mutex_type> l(mtx_, std::try_to_lock);
+            if (!l || connections_.empty())
+                return false;
+
+            for (std::size_t i = 0; i != connections_.size(); ++i)
+            {
+                if (segment_.slot_state(i) != detail::slot_free &&
+                    segment_.available(i) != 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        void wait_for_data()
+        {
+            std::vector<std::uint64_t> heads;
+            while (running_.load())
+            {
+                if (segment_.wait_for_doorbell(heads, doorbell_timeout_us) &&
+                    running_.load())
+                {
+                    notify_();
+                }
+            }
+        }
+
+        Parcelport & pp_;
+
+        mutex_type mtx_;
+        shared_memory_segment segment_;
+        std::vector<connection_type> connections_;
+
+        std::atomic<bool> running_;
+        util::function_nonser<void()> notify_;
+        compat::thread doorbell_thread_;
+    };
+}}}}
+
+#endif
+
+#endif
@@ -0,0 +1,112 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_IPC_SENDER_HPP
+#define HPX_PARCELSET_POLICIES_IPC_SENDER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_IPC)
+
+#include <hpx/error_code.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/plugins/parcelport/ipc/sender_connection.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace hpx { namespace parcelset { namespace policies { namespace ipc
+{
+    // Keeps track of the connections which could not write their message
+    // completely because the ring of the destination was full.
+    struct sender
+    {
+        typedef
+            sender_connection
+            connection_type;
+        typedef std::shared_ptr<connection_type> connection_ptr;
+        typedef std::deque<connection_ptr> connection_list;
+
+        typedef hpx::lcos::local::spinlock mutex_type;
+
+        connection_ptr create_connection(parcelset::locality const& dest,
+            parcelset::parcelport* pp, error_code& ec)
+        {
+            connection_ptr connection =
+                std::make_shared<connection_type>(this, dest, pp);
+            if (!connection->connect(ec))
+                return connection_ptr();
+            return connection;
+        }
+
+        void add(connection_ptr const & ptr)
+        {
+            std::unique_lock<mutex_type> l(connections_mtx_);
+            connections_.push_back(ptr);
+        }
+
+        void send_messages(
+            connection_ptr connection
+        )
+        {
+            // Check if sending has been completed....
+            if (connection->send())
+            {
+                util::unique_function_nonser<
+                    void(
+                        error_code const&
+                      , parcelset::locality const&
+                      , connection_ptr
+                    )
+                > postprocess_handler;
+                std::swap(postprocess_handler, connection->postprocess_handler_);
+                postprocess_handler(
+                    connection->ec_, connection->destination(), connection);
+            }
+            else
+            {
+                std::unique_lock<mutex_type> l(connections_mtx_);
+                connections_.push_back(std::move(connection));
+            }
+        }
+
+        bool background_work()
+        {
+            connection_ptr connection;
+            {
+                std::unique_lock<mutex_type> l(connections_mtx_, std::try_to_lock);
+                if(l && !connections_.empty())
+                {
+                    connection = std::move(connections_.front());
+                    connections_.pop_front();
+                }
+            }
+            if(connection)
+            {
+                send_messages(std::move(connection));
+                return true;
+            }
+            return false;
+        }
+
+        bool has_pending_connections()
+        {
+            std::unique_lock<mutex_type> l(connections_mtx_);
+            return !connections_.empty();
+        }
+
+    private:
+        mutex_type connections_mtx_;
+        connection_list connections_;
+    };
+}}}}
+
+#endif
+
+#endif
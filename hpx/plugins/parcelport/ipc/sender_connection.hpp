@@ -0,0 +1,256 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_IPC_SENDER_CONNECTION_HPP
+#define HPX_PARCELSET_POLICIES_IPC_SENDER_CONNECTION_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_IPC)
+
+#include <hpx/error_code.hpp>
+#include <hpx/performance_counters/parcels/gatherer.hpp>
+#include <hpx/plugins/parcelport/ipc/locality.hpp>
+#include <hpx/plugins/parcelport/ipc/shared_memory_segment.hpp>
+#include <hpx/runtime/parcelset/parcelport.hpp>
+#include <hpx/runtime/parcelset/parcelport_connection.hpp>
+#include <hpx/runtime/parcelset_fwd.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace ipc
+{
+    struct sender;
+    struct sender_connection;
+
+    void add_connection(sender *, std::shared_ptr<sender_connection> const&);
+
+    // A sending connection owns one slot (ring) in the shared memory segment
+    // of the destination locality. Messages are written to the ring using
+    // the same framing as the TCP parcelport. The zero-copy chunks of a
+    // message are copied straight from the memory they refer to into the
+    // ring, they are never staged through an intermediate buffer. Messages
+    // which do not fit into the ring are written piece-wise while the
+    // receiver drains the ring (see sender::background_work).
+    struct sender_connection
+      : parcelset::parcelport_connection<
+            sender_connection
+          , std::vector<char>
+        >
+    {
+    private:
+        typedef sender sender_type;
+
+        typedef std::vector<char> data_type;
+
+        typedef
+            parcelset::parcelport_connection<sender_connection, data_type>
+            base_type;
+
+    public:
+        sender_connection(
+            sender_type * s
+          , parcelset::locality const& there
+          , parcelset::parcelport* pp
+        )
+          : sender_(s)
+          , slot_(std::size_t(-1))
+
+          , buffers_idx_(0)
+          , buffers_offset_(0)
+          , pp_(pp)
+          , there_(there)
+        {
+        }
+
+        ~sender_connection()
+        {
+            if (slot_ != std::size_t(-1))
+                segment_.release_slot(slot_);
+        }
+
+        /// Attach to the segment of the destination and claim a ring
+        bool connect(error_code& ec)
+        {
+            locality const& dest = there_.get<locality>();
+            if (!segment_.open(dest.segment_name(), ec))
+                return false;
+
+            slot_ = segment_.claim_slot();
+            if (slot_ == std::size_t(-1))
+            {
+                HPX_THROWS_IF(ec, network_error,
+                    "ipc::sender_connection::connect",
+                    "no free slot available in the shared memory segment of "
+                    "the destination locality");
+                return false;
+            }
+            return true;
+        }
+
+        parcelset::locality const& destination() const
+        {
+            return there_;
+        }
+
+        void verify_(parcelset::locality const & parcel_locality_id) const
+        {
+        }
+
+        template <typename Handler, typename ParcelPostprocess>
+        void async_write(Handler && handler, ParcelPostprocess && parcel_postprocess)
+        {
+            HPX_ASSERT(!handler_);
+            HPX_ASSERT(!postprocess_handler_);
+            HPX_ASSERT(!buffer_.data_.empty());
+            HPX_ASSERT(slot_ != std::size_t(-1));
+
+            buffer_.data_point_.time_ = util::high_resolution_clock::now();
+
+            handler_ = std::forward<Handler>(handler);
+
+            // collect the pieces of the message, zero-copy chunks are
+            // referred to directly
+            buffers_.clear();
+            buffers_idx_ = 0;
+            buffers_offset_ = 0;
+
+            add_buffer(&buffer_.size_, sizeof(buffer_.size_));
+            add_buffer(&buffer_.data_size_, sizeof(buffer_.data_size_));
+            add_buffer(&buffer_.num_chunks_, sizeof(buffer_.num_chunks_));
+
+            std::vector<parcel_buffer_type::transmission_chunk_type>& chunks =
+                buffer_.transmission_chunks_;
+            if (!chunks.empty())
+            {
+                add_buffer(chunks.data(), chunks.size() *
+                    sizeof(parcel_buffer_type::transmission_chunk_type));
+                add_buffer(buffer_.data_.data(), buffer_.data_.size());
+
+                for (serialization::serialization_chunk& c : buffer_.chunks_)
+                {
+                    if (c.type_ == serialization::chunk_type_pointer)
+                        add_buffer(c.data_.cpos_, c.size_);
+                }
+            }
+            else
+            {
+                add_buffer(buffer_.data_.data(), buffer_.data_.size());
+            }
+
+            if (!send())
+            {
+                postprocess_handler_
+                    = std::forward<ParcelPostprocess>(parcel_postprocess);
+                add_connection(sender_, shared_from_this());
+            }
+            else
+            {
+                HPX_ASSERT(!handler_);
+                parcel_postprocess(ec_, there_, shared_from_this());
+            }
+        }
+
+        /// Write as much of the pending message as fits into the ring,
+        /// returns true if the message has been written completely
+        bool send()
+        {
+            // the receiver has rejected data sent through this connection
+            if (segment_.slot_failed(slot_))
+            {
+                ec_ = error_code(network_error,
+                    "the receiving locality has rejected a message sent "
+                    "through this connection", lightweight);
+                handler_(ec_);
+                handler_.reset();
+                buffer_.clear();
+                buffers_.clear();
+                return true;
+            }
+
+            while (buffers_idx_ != buffers_.size())
+            {
+                std::pair<char const*, std::size_t> const& b =
+                    buffers_[buffers_idx_];
+
+                buffers_offset_ += segment_.write(slot_,
+                    b.first + buffers_offset_, b.second - buffers_offset_);
+
+                if (buffers_offset_ != b.second)
+                    return false;       // the ring is full
+
+                ++buffers_idx_;
+                buffers_offset_ = 0;
+            }
+            return done();
+        }
+
+        bool done()
+        {
+            error_code ec;
+            handler_(ec);
+            handler_.reset();
+            buffer_.data_point_.time_ =
+                util::high_resolution_clock::now() - buffer_.data_point_.time_;
+            pp_->add_sent_data(buffer_.data_point_);
+            buffer_.clear();
+            buffers_.clear();
+
+            return true;
+        }
+
+    private:
+        void add_buffer(void const* data, std::size_t size)
+        {
+            if (size != 0)
+            {
+                buffers_.push_back(std::make_pair(
+                    static_cast<char const*>(data), size));
+            }
+        }
+
+        friend struct sender;
+
+        sender_type * sender_;
+
+        shared_memory_segment segment_;
+        std::size_t slot_;
+
+        /// the result of the last send operation
+        error_code ec_;
+
+        std::vector<std::pair<char const*, std::size_t> > buffers_;
+        std::size_t buffers_idx_;
+        std::size_t buffers_offset_;
+
+        util::unique_function_nonser<
+            void(
+                error_code const&
+            )
+        > handler_;
+        util::unique_function_nonser<
+            void(
+                error_code const&
+              , parcelset::locality const&
+              , std::shared_ptr<sender_connection>
+            )
+        > postprocess_handler_;
+
+        parcelset::parcelport* pp_;
+
+        parcelset::locality there_;
+    };
+}}}}
+
+#endif
+
+#endif
@@ -0,0 +1,530 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_IPC_SHARED_MEMORY_SEGMENT_HPP
+#define HPX_PARCELSET_POLICIES_IPC_SHARED_MEMORY_SEGMENT_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_IPC)
+
+#include <hpx/error_code.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#define HPX_PARCELPORT_IPC_USE_FUTEX
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace ipc
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Every locality owns one shared memory segment through which it receives
+    // messages from the other localities on the same host. The segment holds
+    // a fixed number of slots, each of which is a single-producer,
+    // single-consumer byte ring. A slot is claimed by exactly one sending
+    // connection of another locality and is read by the owning locality only.
+    //
+    // The ring positions are monotonically increasing byte counts, the
+    // sender advances head_, the receiver advances tail_. Both are lock-free
+    // atomics and therefore usable across process boundaries.
+    //
+    // The receiving locality does not poll the rings while it is idle, it
+    // waits on the doorbell word of the segment instead. A sender rings the
+    // doorbell (a futex shared between the processes, where available)
+    // whenever it publishes data to an empty ring while the receiver is
+    // waiting.
+    namespace detail
+    {
+        enum slot_state
+        {
+            slot_free = 0,          // available for a new connection
+            slot_connected = 1,     // in use by a sending connection
+            slot_closed = 2,        // sender is gone, drain and free the slot
+            slot_failed = 3         // receiver has rejected a message
+        };
+
+        struct ring_control
+        {
+            std::atomic<std::uint32_t> state_;
+            char padding0_[64 - sizeof(std::atomic<std::uint32_t>)];
+            std::atomic<std::uint64_t> head_;
+            char padding1_[64 - sizeof(std::atomic<std::uint64_t>)];
+            std::atomic<std::uint64_t> tail_;
+            char padding2_[64 - sizeof(std::atomic<std::uint64_t>)];
+        };
+
+        struct segment_header
+        {
+            std::uint64_t magic_;
+            std::uint64_t ring_size_;
+            std::uint32_t num_slots_;
+            std::atomic<std::uint32_t> ready_;
+
+            // the doorbell is incremented on every ring, the receiver sets
+            // waiting_ while it sleeps on the doorbell
+            std::atomic<std::uint32_t> doorbell_;
+            std::atomic<std::uint32_t> waiting_;
+
+            char padding_[64 - 2 * sizeof(std::uint64_t) -
+                sizeof(std::uint32_t) - 3 * sizeof(std::atomic<std::uint32_t>)];
+        };
+
+        static const std::uint64_t segment_magic = 0x6870782e69706332ull;
+
+#if defined(HPX_PARCELPORT_IPC_USE_FUTEX)
+        // The futex is shared between processes, hence no FUTEX_*_PRIVATE
+        inline void futex_wait(std::atomic<std::uint32_t>& word,
+            std::uint32_t expected, std::int64_t timeout_us)
+        {
+            struct timespec timeout;
+            timeout.tv_sec = static_cast<time_t>(timeout_us / 1000000);
+            timeout.tv_nsec = static_cast<long>((timeout_us % 1000000) * 1000);
+
+            ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+                FUTEX_WAIT, expected, &timeout, nullptr, 0);
+        }
+
+        inline void futex_wake(std::atomic<std::uint32_t>& word)
+        {
+            ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+                FUTEX_WAKE, 1, nullptr, nullptr, 0);
+        }
+#endif
+    }
+
+    class shared_memory_segment
+    {
+    public:
+        shared_memory_segment()
+          : base_(nullptr), size_(0), header_(nullptr), controls_(nullptr),
+            rings_(nullptr), owner_(false)
+        {}
+
+        ~shared_memory_segment()
+        {
+            close();
+        }
+
+        shared_memory_segment(shared_memory_segment const&) = delete;
+        shared_memory_segment& operator=(shared_memory_segment const&) = delete;
+
+        /// Create (and own) the segment with the given name
+        bool create(std::string const& name, std::size_t num_slots,
+            std::size_t ring_size, error_code& ec = throws)
+        {
+            HPX_ASSERT(base_ == nullptr);
+            HPX_ASSERT(num_slots != 0 && ring_size != 0);
+
+            // remove a stale segment left behind by a crashed process which
+            // happened to have the same process id
+            ::shm_unlink(name.c_str());
+
+            int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd == -1)
+            {
+                HPX_THROWS_IF(ec, network_error,
+                    "ipc::shared_memory_segment::create",
+                    "shm_open failed for " + name + ": " +
+                        std::strerror(errno));
+                return false;
+            }
+
+            std::size_t size = segment_size(num_slots, ring_size);
+            if (::ftruncate(fd, static_cast<off_t>(size)) == -1)
+            {
+                int err = errno;
+                ::close(fd);
+                ::shm_unlink(name.c_str());
+                HPX_THROWS_IF(ec, network_error,
+                    "ipc::shared_memory_segment::create",
+                    "ftruncate failed for " + name + ": " +
+                        std::strerror(err));
+                return false;
+            }
+
+            if (!map(fd, size, name, ec))
+            {
+                ::shm_unlink(name.c_str());
+                return false;
+            }
+
+            name_ = name;
+            owner_ = true;
+
+            header_ = new (base_) detail::segment_header;
+            header_->magic_ = detail::segment_magic;
+            header_->ring_size_ = ring_size;
+            header_->num_slots_ = static_cast<std::uint32_t>(num_slots);
+            header_->doorbell_.store(0, std::memory_order_relaxed);
+            header_->waiting_.store(0, std::memory_order_relaxed);
+
+            init_pointers();
+            for (std::size_t i = 0; i != num_slots; ++i)
+            {
+                detail::ring_control* c = new (&controls_[i]) detail::ring_control;
+                c->head_.store(0, std::memory_order_relaxed);
+                c->tail_.store(0, std::memory_order_relaxed);
+                c->state_.store(detail::slot_free, std::memory_order_relaxed);
+            }
+
+            header_->ready_.store(1, std::memory_order_release);
+
+            if (&ec != &throws)
+                ec = make_success_code();
+            return true;
+        }
+
+        /// Attach to the segment created by another locality
+        bool open(std::string const& name, error_code& ec = throws)
+        {
+            HPX_ASSERT(base_ == nullptr);
+
+            int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+            if (fd == -1)
+            {
+                HPX_THROWS_IF(ec, network_error,
+                    "ipc::shared_memory_segment::open",
+                    "shm_open failed for " + name + ": " +
+                        std::strerror(errno));
+                return false;
+            }
+
+            struct stat st;
+            if (::fstat(fd, &st) == -1 ||
+                static_cast<std::size_t>(st.st_size) <
+                    sizeof(detail::segment_header))
+            {
+                ::close(fd);
+                HPX_THROWS_IF(ec, network_error,
+                    "ipc::shared_memory_segment::open",
+                    "invalid shared memory segment: " + name);
+                return false;
+            }
+
+            if (!map(fd, static_cast<std::size_t>(st.st_size), name, ec))
+                return false;
+
+            name_ = name;
+            header_ = reinterpret_cast<detail::segment_header*>(base_);
+
+            if (header_->magic_ != detail::segment_magic ||
+                header_->ready_.load(std::memory_order_acquire) == 0 ||
+                segment_size(header_->num_slots_, header_->ring_size_) > size_)
+            {
+                close();
+                HPX_THROWS_IF(ec, network_error,
+                    "ipc::shared_memory_segment::open",
+                    "shared memory segment is not initialized: " + name);
+                return false;
+            }
+
+            init_pointers();
+
+            if (&ec != &throws)
+                ec = make_success_code();
+            return true;
+        }
+
+        void close()
+        {
+            if (base_ != nullptr)
+            {
+                ::munmap(base_, size_);
+                base_ = nullptr;
+                header_ = nullptr;
+                controls_ = nullptr;
+                rings_ = nullptr;
+                size_ = 0;
+            }
+            if (owner_)
+            {
+                ::shm_unlink(name_.c_str());
+                owner_ = false;
+            }
+        }
+
+        std::size_t num_slots() const
+        {
+            return header_->num_slots_;
+        }
+
+        std::size_t ring_size() const
+        {
+            return static_cast<std::size_t>(header_->ring_size_);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // sending side
+
+        /// Claim a free slot, returns std::size_t(-1) if none is available
+        std::size_t claim_slot()
+        {
+            std::size_t const slots = num_slots();
+            for (std::size_t i = 0; i != slots; ++i)
+            {
+                std::uint32_t expected = detail::slot_free;
+                if (controls_[i].state_.compare_exchange_strong(expected,
+                        detail::slot_connected, std::memory_order_acq_rel))
+                {
+                    return i;
+                }
+            }
+            return std::size_t(-1);
+        }
+
+        /// Hand the slot back, the receiver frees it once drained
+        void release_slot(std::size_t slot)
+        {
+            controls_[slot].state_.store(
+                detail::slot_closed, std::memory_order_release);
+        }
+
+        /// Return whether the receiver has rejected data sent through the
+        /// given slot
+        bool slot_failed(std::size_t slot) const
+        {
+            return controls_[slot].state_.load(std::memory_order_acquire) ==
+                detail::slot_failed;
+        }
+
+        /// Copy as much as fits into the ring of the given slot, returns
+        /// the number of bytes written
+        std::size_t write(std::size_t slot, char const* data, std::size_t size)
+        {
+            detail::ring_control& c = controls_[slot];
+            std::uint64_t const head = c.head_.load(std::memory_order_relaxed);
+            std::uint64_t const tail = c.tail_.load(std::memory_order_acquire);
+
+            std::size_t const ring_size = this->ring_size();
+            std::size_t const space =
+                ring_size - static_cast<std::size_t>(head - tail);
+            std::size_t const count = (std::min)(size, space);
+            if (count == 0)
+                return 0;
+
+            char* ring = rings_ + slot * ring_size;
+            std::size_t const pos = static_cast<std::size_t>(head % ring_size);
+            std::size_t const first = (std::min)(count, ring_size - pos);
+            std::memcpy(ring + pos, data, first);
+            if (first != count)
+                std::memcpy(ring, data + first, count - first);
+
+            c.head_.store(head + count, std::memory_order_release);
+
+            // wake up the receiver if it might be waiting for data
+            if (head == tail)
+                ring_doorbell(false);
+
+            return count;
+        }
+
+        /// Wake up the receiver, if it is waiting (or unconditionally)
+        void ring_doorbell(bool always = true)
+        {
+            // pairs with the fence in wait_for_doorbell
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!always &&
+                header_->waiting_.load(std::memory_order_relaxed) == 0)
+            {
+                return;
+            }
+
+            header_->doorbell_.fetch_add(1, std::memory_order_release);
+#if defined(HPX_PARCELPORT_IPC_USE_FUTEX)
+            detail::futex_wake(header_->doorbell_);
+#endif
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // receiving side
+
+        /// Return the state of the given slot (see detail::slot_state)
+        std::uint32_t slot_state(std::size_t slot) const
+        {
+            return controls_[slot].state_.load(std::memory_order_acquire);
+        }
+
+        /// Return the number of bytes which can be read from the given slot
+        std::size_t available(std::size_t slot) const
+        {
+            detail::ring_control const& c = controls_[slot];
+            return static_cast<std::size_t>(
+                c.head_.load(std::memory_order_acquire) -
+                c.tail_.load(std::memory_order_relaxed));
+        }
+
+        /// Copy up to size bytes out of the ring of the given slot, returns
+        /// the number of bytes read
+        std::size_t read(std::size_t slot, char* data, std::size_t size)
+        {
+            detail::ring_control& c = controls_[slot];
+            std::uint64_t const tail = c.tail_.load(std::memory_order_relaxed);
+            std::uint64_t const head = c.head_.load(std::memory_order_acquire);
+
+            std::size_t const count =
+                (std::min)(size, static_cast<std::size_t>(head - tail));
+            if (count == 0)
+                return 0;
+
+            std::size_t const ring_size = this->ring_size();
+            char const* ring = rings_ + slot * ring_size;
+            std::size_t const pos = static_cast<std::size_t>(tail % ring_size);
+            std::size_t const first = (std::min)(count, ring_size - pos);
+            std::memcpy(data, ring + pos, first);
+            if (first != count)
+                std::memcpy(data + first, ring, count - first);
+
+            c.tail_.store(tail + count, std::memory_order_release);
+            return count;
+        }
+
+        /// Discard all data available in the given slot
+        void discard(std::size_t slot)
+        {
+            detail::ring_control& c = controls_[slot];
+            c.tail_.store(c.head_.load(std::memory_order_acquire),
+                std::memory_order_release);
+        }
+
+        /// Reject any further data sent through the given slot
+        void fail_slot(std::size_t slot)
+        {
+            std::uint32_t expected = detail::slot_connected;
+            controls_[slot].state_.compare_exchange_strong(expected,
+                detail::slot_failed, std::memory_order_acq_rel);
+        }
+
+        /// Wait for the doorbell to be rung or for the timeout to expire.
+        /// Returns whether new data has been published to any of the slots
+        /// since the last call (the last seen ring positions are kept in
+        /// heads).
+        bool wait_for_doorbell(std::vector<std::uint64_t>& heads,
+            std::int64_t timeout_us)
+        {
+            std::uint32_t const doorbell =
+                header_->doorbell_.load(std::memory_order_acquire);
+
+            // announce that we are about to wait before checking the rings
+            // a last time, any sender publishing data after this point will
+            // ring the doorbell
+            header_->waiting_.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            bool has_data = update_heads(heads);
+            if (!has_data)
+            {
+#if defined(HPX_PARCELPORT_IPC_USE_FUTEX)
+                detail::futex_wait(header_->doorbell_, doorbell, timeout_us);
+#else
+                std::this_thread::sleep_for(std::chrono::microseconds(
+                    (std::min)(timeout_us, std::int64_t(100))));
+#endif
+            }
+
+            header_->waiting_.store(0, std::memory_order_relaxed);
+            return has_data || update_heads(heads);
+        }
+
+        /// Make a closed and drained slot available for new connections
+        void free_slot(std::size_t slot)
+        {
+            detail::ring_control& c = controls_[slot];
+            HPX_ASSERT(c.state_.load() == detail::slot_closed);
+            c.head_.store(0, std::memory_order_relaxed);
+            c.tail_.store(0, std::memory_order_relaxed);
+            c.state_.store(detail::slot_free, std::memory_order_release);
+        }
+
+    private:
+        // record the current ring positions, returns whether any of them
+        // has changed
+        bool update_heads(std::vector<std::uint64_t>& heads) const
+        {
+            std::size_t const slots = num_slots();
+            heads.resize(slots, 0);
+
+            bool changed = false;
+            for (std::size_t i = 0; i != slots; ++i)
+            {
+                std::uint64_t const head =
+                    controls_[i].head_.load(std::memory_order_acquire);
+                if (head != heads[i])
+                {
+                    heads[i] = head;
+                    changed = true;
+                }
+            }
+            return changed;
+        }
+
+        static std::size_t segment_size(std::size_t num_slots,
+            std::size_t ring_size)
+        {
+            return sizeof(detail::segment_header) +
+                num_slots * (sizeof(detail::ring_control) + ring_size);
+        }
+
+        bool map(int fd, std::size_t size, std::string const& name,
+            error_code& ec)
+        {
+            void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                MAP_SHARED, fd, 0);
+            int err = errno;
+            ::close(fd);
+
+            if (base == MAP_FAILED)
+            {
+                HPX_THROWS_IF(ec, network_error,
+                    "ipc::shared_memory_segment::map",
+                    "mmap failed for " + name + ": " + std::strerror(err));
+                return false;
+            }
+
+            base_ = static_cast<char*>(base);
+            size_ = size;
+            return true;
+        }
+
+        void init_pointers()
+        {
+            controls_ = reinterpret_cast<detail::ring_control*>(
+                base_ + sizeof(detail::segment_header));
+            rings_ = reinterpret_cast<char*>(controls_ + header_->num_slots_);
+        }
+
+        std::string name_;
+        char* base_;
+        std::size_t size_;
+        detail::segment_header* header_;
+        detail::ring_control* controls_;
+        char* rings_;
+        bool owner_;
+    };
+}}}}
+
+#endif
+
+#endif
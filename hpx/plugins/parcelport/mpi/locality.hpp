@@ -17,7 +17,9 @@
 
 #include <boost/io/ios_state.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 
 namespace hpx { namespace parcelset
 {
@@ -70,6 +72,11 @@ namespace hpx { namespace parcelset
                 return lhs.rank_ < rhs.rank_;
             }
 
+            friend std::size_t hash_value(locality const & loc)
+            {
+                return std::hash<std::int32_t>()(loc.rank_);
+            }
+
             friend std::ostream & operator<<(std::ostream & os, locality const & loc)
             {
                 boost::io::ios_flags_saver ifs(os);
@@ -18,12 +18,14 @@
 #include <hpx/plugins/parcelport/tcp/locality.hpp>
 #include <hpx/runtime/parcelset/locality.hpp>
 #include <hpx/runtime/parcelset/parcelport_impl.hpp>
+#include <hpx/runtime/parcelset/receive_buffer_pool.hpp>
 #include <hpx/util_fwd.hpp>
 
 #include <boost/asio/ip/host_name.hpp>
 #include <boost/asio/ip/tcp.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <set>
 #include <string>
@@ -109,6 +111,33 @@ namespace hpx { namespace parcelset
 
             parcelset::locality create_locality() const;
 
+            /// Return the number of messages which may be in flight on a
+            /// connection before the sender waits for the receiver
+            std::uint32_t get_window_size() const
+            {
+                return window_size_;
+            }
+
+            /// Return the given receive buffer pool statistic
+            std::int64_t get_receive_buffer_pool_statistics(
+                receive_buffer_pool_statistics_type t, bool reset)
+            {
+                switch (t) {
+                    case receive_buffer_pool_hits:
+                        return receive_buffer_pool_.get_hits(reset);
+
+                    case receive_buffer_pool_misses:
+                        return receive_buffer_pool_.get_misses(reset);
+
+                    case receive_buffer_pool_bytes_retained:
+                        return receive_buffer_pool_.get_bytes_retained(reset);
+
+                    default:
+                        break;
+                }
+                return 0;
+            }
+
         private:
             void handle_accept(boost::system::error_code const & e,
                 std::shared_ptr<receiver> receiver_conn);
@@ -118,6 +147,13 @@ namespace hpx { namespace parcelset
             /// Acceptor used to listen for incoming connections.
             boost::asio::ip::tcp::acceptor* acceptor_;
 
+            /// maximal number of unacknowledged messages per connection
+            std::uint32_t window_size_;
+
+            /// Memory for the received messages is drawn from this pool, it
+            /// has to outlive all receive buffers
+            receive_buffer_pool receive_buffer_pool_;
+
             /// The list of accepted connections
             mutable lcos::local::spinlock connections_mtx_;
 
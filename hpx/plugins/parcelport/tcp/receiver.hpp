@@ -21,6 +21,7 @@
 #include <hpx/performance_counters/parcels/gatherer.hpp>
 #include <hpx/runtime/parcelset/decode_parcels.hpp>
 #include <hpx/runtime/parcelset/parcelport_connection.hpp>
+#include <hpx/runtime/parcelset/receive_buffer_pool.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/bind.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
@@ -33,6 +34,7 @@
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -46,15 +48,25 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
     class connection_handler;
 
     class receiver
-      : public parcelport_connection<receiver, std::vector<char>, std::vector<char> >
+      : public parcelport_connection<
+            receiver, pooled_receive_buffer, pooled_receive_buffer>
     {
         typedef hpx::lcos::local::spinlock mutex_type;
+        typedef parcelport_connection<
+                receiver, pooled_receive_buffer, pooled_receive_buffer
+            > base_type;
+
     public:
         receiver(boost::asio::io_service& io_service, std::uint64_t max_inbound_size,
-            connection_handler& parcelport)
-          : socket_(io_service)
+            connection_handler& parcelport, std::uint32_t window_size = 1,
+            receive_buffer_pool* pool = nullptr)
+          : base_type(receive_buffer_allocator<char>(pool))
+          , socket_(io_service)
           , max_inbound_size_(max_inbound_size)
-          , ack_(0)
+          , credit_batch_size_((std::max)(window_size / 2, std::uint32_t(1)))
+          , credits_consumed_(0)
+          , credit_grant_(0)
+          , pool_(pool)
           , parcelport_(parcelport)
           , timer_()
           , mtx_()
@@ -255,7 +267,9 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                     static_cast<std::size_t>(
                         static_cast<std::uint32_t>(buffer_.num_chunks_.first));
 
-                buffer_.chunks_.resize(num_zero_copy_chunks);
+                // the chunk buffers are drawn from the pool as well
+                buffer_.chunks_.resize(num_zero_copy_chunks,
+                    pooled_receive_buffer(receive_buffer_allocator<char>(pool_)));
                 for (std::size_t i = 0; i != num_zero_copy_chunks; ++i)
                 {
                     std::size_t chunk_size = static_cast<std::size_t>(
@@ -310,16 +324,28 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                 buffer_.data_point_.time_ = timer_.elapsed_nanoseconds() -
                     buffer_.data_point_.time_;
 
-                // now send acknowledgment byte
+                // decode the received parcels.
+                decode_parcels(parcelport_, std::move(buffer_), -1);
+                buffer_ = parcel_buffer_type(
+                    receive_buffer_allocator<char>(pool_));
+
+                // Hand back the credits for the processed messages in
+                // batches, the sender keeps writing while it has credits
+                // left. Using half of the window makes sure new credits
+                // arrive before the sender has run out of them.
+                if (++credits_consumed_ < credit_batch_size_)
+                {
+                    handle_write_ack(e, handler);
+                    return;
+                }
+
+                credit_grant_ = credits_consumed_;
+                credits_consumed_ = 0;
+
                 void (receiver::*f)(boost::system::error_code const&,
                         Handler)
                     = &receiver::handle_write_ack<Handler>;
 
-                // decode the received parcels.
-                decode_parcels(parcelport_, std::move(buffer_), -1);
-                buffer_ = parcel_buffer_type();
-
-                ack_ = true;
                 {
                     std::unique_lock<mutex_type> lk(mtx_);
                     if(!socket_.is_open())
@@ -331,7 +357,8 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                         return;
                     }
                     boost::asio::async_write(socket_,
-                        boost::asio::buffer(&ack_, sizeof(ack_)),
+                        boost::asio::buffer(&credit_grant_,
+                            sizeof(credit_grant_)),
                         util::bind(f, shared_from_this(),
                             boost::asio::placeholders::error,
                             util::protect(handler)));
@@ -361,7 +388,13 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 
         std::uint64_t max_inbound_size_;
 
-        bool ack_;
+        /// credits are handed back to the sender in batches of this size
+        std::uint32_t credit_batch_size_;
+        std::uint32_t credits_consumed_;
+        std::uint32_t credit_grant_;
+
+        /// The pool the receive buffers are allocated from
+        receive_buffer_pool* pool_;
 
         /// The handler used to process the incoming request.
         connection_handler& parcelport_;
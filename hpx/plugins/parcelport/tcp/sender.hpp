@@ -14,6 +14,7 @@
 #if defined(HPX_HAVE_PARCELPORT_TCP)
 
 #include <hpx/config/asio.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/performance_counters/parcels/data_point.hpp>
 #include <hpx/performance_counters/parcels/gatherer.hpp>
 #include <hpx/plugins/parcelport/tcp/locality.hpp>
@@ -33,23 +34,48 @@
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
 
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
 #include <vector>
 
 namespace hpx { namespace parcelset { namespace policies { namespace tcp
 {
+    // The sender may have up to 'window_size' messages in flight on a
+    // connection. Each written message consumes one credit, the receiver
+    // hands back credits in batches once it has processed the messages (see
+    // receiver::handle_read_data). The connection is returned to the
+    // connection cache right after a write completes as long as credits are
+    // left, otherwise it waits for the next credit grant from the receiver.
+    // A window size of one is equivalent to acknowledging every message.
+    //
+    // Credit grants are read by a single read operation which is kept
+    // running for the lifetime of the connection, this way no grant is left
+    // unread in the socket (closing a socket with unread data causes the
+    // connection to be reset, dropping any data still in flight).
     class sender
       : public parcelset::parcelport_connection<sender, std::vector<char> >
     {
+        typedef hpx::lcos::local::spinlock mutex_type;
+
+        // maximal time to wait for the receiver to close its end of the
+        // connection while shutting down
+        static std::int64_t const shutdown_timeout_ms = 1000;
+
     public:
         /// Construct a sending parcelport_connection with the given io_service.
         sender(boost::asio::io_service& io_service,
                 parcelset::locality const& locality_id,
-                parcelset::parcelport* pp)
+                parcelset::parcelport* pp, std::uint32_t window_size = 1)
           : socket_(io_service)
-          , ack_(0)
+          , credits_(window_size != 0 ? window_size : 1)
+          , credit_grant_(0)
+          , reading_credits_(false)
+          , waiting_for_credits_(false)
           , there_(locality_id)
           , timer_()
           , pp_(pp)
@@ -61,7 +87,20 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
             // gracefully and portably shutdown the socket
             if (socket_.is_open()) {
                 boost::system::error_code ec;
-                socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+
+                // stop reading credit grants, the pending read operation
+                // does not refer to this object anymore
+                socket_.cancel(ec);
+
+                // Signal the end of the data stream and consume whatever the
+                // receiver still sends until it closes its end. This makes
+                // sure all messages written were received before the socket
+                // is closed.
+                socket_.shutdown(
+                    boost::asio::ip::tcp::socket::shutdown_send, ec);
+                if (!ec)
+                    drain_credits();
+
                 socket_.close(ec);    // close the socket to give it back to the OS
             }
         }
@@ -106,6 +145,20 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
             HPX_ASSERT(!handler_);
             HPX_ASSERT(!postprocess_handler_);
 
+            std::unique_lock<mutex_type> l(mtx_);
+
+            // the connection is handed out only if credits are available
+            HPX_ASSERT(credits_ != 0);
+            HPX_ASSERT(!waiting_for_credits_);
+            --credits_;
+
+            // make sure credit grants are being read from now on
+            if (!reading_credits_)
+            {
+                reading_credits_ = true;
+                async_read_credits();
+            }
+
             handler_ = std::forward<Handler>(handler);
             postprocess_handler_ = std::forward<ParcelPostprocess>(parcel_postprocess);
             HPX_ASSERT(handler_);
@@ -164,6 +217,52 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
         }
 
     private:
+        // start reading the next credit grant, the handler refers to the
+        // connection through a weak pointer only, so that a connection
+        // which is idle (in the connection cache) can still be destroyed
+        void async_read_credits()
+        {
+            std::weak_ptr<sender> this_(shared_from_this());
+            boost::asio::async_read(socket_,
+                boost::asio::buffer(&credit_grant_, sizeof(credit_grant_)),
+                [this_](boost::system::error_code const& e, std::size_t)
+                {
+                    std::shared_ptr<sender> s = this_.lock();
+                    if (s)
+                        s->handle_read_credits(e);
+                });
+        }
+
+        // read and discard data until the receiver has closed its end of the
+        // connection (or the shutdown timeout has expired)
+        void drain_credits()
+        {
+            boost::system::error_code ec;
+            socket_.non_blocking(true, ec);
+            if (ec)
+                return;
+
+            util::high_resolution_timer t;
+            std::uint32_t grant = 0;
+            while (true)
+            {
+                socket_.read_some(
+                    boost::asio::buffer(&grant, sizeof(grant)), ec);
+
+                if (ec != boost::asio::error::would_block)
+                {
+                    if (ec)
+                        break;          // eof or connection error
+                    continue;
+                }
+
+                if (t.elapsed_microseconds() > shutdown_timeout_ms * 1000)
+                    break;
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
         /// handle completed write operation
         void handle_write(boost::system::error_code const& e, std::size_t bytes)
         {
@@ -193,23 +292,63 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                 timer_.elapsed_nanoseconds() - buffer_.data_point_.time_;
             pp_->add_sent_data(buffer_.data_point_);
 
-            // now handle the acknowledgment byte which is sent by the receiver
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+
+                // the connection can be reused right away if there are
+                // credits left, no need to wait for the receiver
+                if (credits_ == 0)
+                {
+                    // otherwise wait for the next credit grant sent by the
+                    // receiver, keep this connection alive in the meantime
+                    waiting_for_credits_ = true;
+                    self_ = shared_from_this();
+
 #if defined(__linux) || defined(linux) || defined(__linux__)
-            boost::asio::detail::socket_option::boolean<
-                IPPROTO_TCP, TCP_QUICKACK> quickack(true);
-            socket_.set_option(quickack);
+                    boost::system::error_code ec;
+                    boost::asio::detail::socket_option::boolean<
+                        IPPROTO_TCP, TCP_QUICKACK> quickack(true);
+                    socket_.set_option(quickack, ec);
 #endif
+                    return;
+                }
+            }
 
-            void (sender::*f)(boost::system::error_code const&)
-                = &sender::handle_read_ack;
+            reuse_connection(e);
+        }
 
-            using util::placeholders::_1;
-            boost::asio::async_read(socket_,
-                boost::asio::buffer(&ack_, sizeof(ack_)),
-                util::bind(f, shared_from_this(), _1));
+        void handle_read_credits(boost::system::error_code const& e)
+        {
+            std::shared_ptr<sender> self;
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+                if (!e)
+                {
+                    HPX_ASSERT(credit_grant_ != 0);
+                    credits_ += credit_grant_;
+                    credit_grant_ = 0;
+
+                    // keep reading credit grants
+                    async_read_credits();
+                }
+                else
+                {
+                    reading_credits_ = false;
+                }
+
+                // nothing else to do if no write is waiting for credits,
+                // read errors will be reported by the next write
+                if (!waiting_for_credits_)
+                    return;
+
+                waiting_for_credits_ = false;
+                std::swap(self, self_);
+            }
+
+            reuse_connection(e);
         }
 
-        void handle_read_ack(boost::system::error_code const& e)
+        void reuse_connection(boost::system::error_code const& e)
         {
 #if defined(HPX_TRACK_STATE_OF_OUTGOING_TCP_CONNECTION)
             state_ = state_handle_read_ack;
@@ -232,7 +371,20 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
         /// Socket for the parcelport_connection.
         boost::asio::ip::tcp::socket socket_;
 
-        bool ack_;
+        /// number of messages which may still be sent before waiting for
+        /// the receiver to grant more credits
+        std::uint32_t credits_;
+        std::uint32_t credit_grant_;
+
+        /// a read operation for credit grants is pending
+        bool reading_credits_;
+
+        /// a completed write is waiting for credits before the connection
+        /// can be reused, the connection keeps itself alive meanwhile
+        bool waiting_for_credits_;
+        std::shared_ptr<sender> self_;
+
+        mutex_type mtx_;
 
         /// the other (receiving) end of this connection
         parcelset::locality there_;
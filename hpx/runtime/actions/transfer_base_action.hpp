@@ -92,6 +92,27 @@ namespace hpx { namespace actions
         private:
             std::unique_ptr<Args> data_;
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // If all arguments of an action are bitwise serializable, the
+        // argument tuple is sent as a single block of memory and is received
+        // directly into the argument storage of the action. This generates
+        // the same data on the wire as the generic serialization of the
+        // tuple, but bypasses it.
+        template <typename Arguments>
+        struct has_bitwise_serializable_arguments
+          : std::false_type
+        {};
+
+        template <typename T, typename ...Ts>
+        struct has_bitwise_serializable_arguments<util::tuple<T, Ts...> >
+          : util::detail::all_of<
+                traits::is_bitwise_serializable<
+                    typename std::remove_const<T>::type>,
+                traits::is_bitwise_serializable<
+                    typename std::remove_const<Ts>::type>...
+            >
+        {};
     }
 }}
 
@@ -358,7 +379,8 @@ namespace hpx { namespace actions
         // loading ...
         void load_base(hpx::serialization::input_archive & ar)
         {
-            ar >> arguments_;
+            load_arguments(ar,
+                detail::has_bitwise_serializable_arguments<arguments_type>());
 
             // Always serialize the parent information to maintain binary
             // compatibility on the wire.
@@ -378,7 +400,8 @@ namespace hpx { namespace actions
         // saving ...
         void save_base(hpx::serialization::output_archive & ar)
         {
-            ar << arguments_;
+            save_arguments(ar,
+                detail::has_bitwise_serializable_arguments<arguments_type>());
 
             // Always serialize the parent information to maintain binary
             // compatibility on the wire.
@@ -394,6 +417,42 @@ namespace hpx { namespace actions
         }
 
     private:
+        void load_arguments(hpx::serialization::input_archive & ar,
+            std::false_type)
+        {
+            ar >> arguments_;
+        }
+
+        void load_arguments(hpx::serialization::input_archive & ar,
+            std::true_type)
+        {
+            if (ar.disable_array_optimization())
+            {
+                ar >> arguments_;
+                return;
+            }
+            serialization::load_binary(
+                ar, &arguments_._impl, sizeof(arguments_._impl));
+        }
+
+        void save_arguments(hpx::serialization::output_archive & ar,
+            std::false_type)
+        {
+            ar << arguments_;
+        }
+
+        void save_arguments(hpx::serialization::output_archive & ar,
+            std::true_type)
+        {
+            if (ar.disable_array_optimization())
+            {
+                ar << arguments_;
+                return;
+            }
+            serialization::save_binary(
+                ar, &arguments_._impl, sizeof(arguments_._impl));
+        }
+
         static std::uint32_t get_locality_id()
         {
             error_code ec(lightweight);      // ignore any errors
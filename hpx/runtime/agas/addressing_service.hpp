@@ -1,6 +1,6 @@
 ////////////////////////////////////////////////////////////////////////////////
 //  Copyright (c) 2011 Bryce Lelbach
-//  Copyright (c) 2011-2016 Hartmut Kaiser
+//  Copyright (c) 2011-2017 Hartmut Kaiser
 //  Copyright (c) 2016 Parsa Amini
 //  Copyright (c) 2016 Thomas Heller
 //
@@ -13,11 +13,14 @@
 
 #include <hpx/config.hpp>
 #include <hpx/exception_fwd.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
 #include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/runtime/runtime_mode.hpp>
 #include <hpx/runtime/agas_fwd.hpp>
 #include <hpx/runtime/agas/gva.hpp>
 #include <hpx/runtime/agas/component_namespace.hpp>
+#include <hpx/runtime/agas/detail/gva_cache.hpp>
 #include <hpx/runtime/agas/locality_namespace.hpp>
 #include <hpx/runtime/agas/symbol_namespace.hpp>
 #include <hpx/runtime/agas/primary_namespace.hpp>
@@ -26,8 +29,6 @@
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/runtime/parcelset_fwd.hpp>
 #include <hpx/state.hpp>
-#include <hpx/util/cache/lru_cache.hpp>
-#include <hpx/util/cache/statistics/local_full_statistics.hpp>
 #include <hpx/util_fwd.hpp>
 #include <hpx/util/function.hpp>
 
@@ -73,19 +74,12 @@ public:
     // }}}
 
     // {{{ gva cache
-    struct gva_cache_key;
-
-    typedef hpx::util::cache::lru_cache<
-        gva_cache_key
-      , gva
-      , hpx::util::cache::statistics::local_full_statistics
-    > gva_cache_type;
+    typedef detail::gva_cache gva_cache_type;
     // }}}
 
     typedef std::set<naming::gid_type> migrated_objects_table_type;
     typedef std::map<naming::gid_type, std::int64_t> refcnt_requests_type;
 
-    mutable mutex_type gva_cache_mtx_;
     std::shared_ptr<gva_cache_type> gva_cache_;
 
     mutable mutex_type migrated_objects_mtx_;
@@ -95,13 +89,45 @@ public:
     std::uint32_t console_cache_;
 
     std::size_t const max_refcnt_requests_;
+    std::uint64_t const refcnt_requests_flush_interval_;    // [ns]
 
     mutex_type refcnt_requests_mtx_;
-    std::size_t refcnt_requests_count_;
+    std::uint64_t refcnt_requests_started_;     // time of the oldest decref
     bool enable_refcnt_caching_;
 
     std::shared_ptr<refcnt_requests_type> refcnt_requests_;
 
+    // Increments of the credits of objects managed by a remote locality. At
+    // most one request is in flight for each of the target localities,
+    // increments arriving in the meantime are merged and sent (together with
+    // the decrements pending for the same locality) as soon as the
+    // outstanding request has been acknowledged.
+    struct incref_requests
+    {
+        incref_requests()
+          : in_flight_(false)
+        {}
+
+        bool in_flight_;
+        refcnt_requests_type requests_;
+        std::shared_ptr<lcos::local::promise<void> > promise_;
+        hpx::shared_future<void> future_;
+    };
+    typedef std::map<std::uint32_t, incref_requests> incref_requests_type;
+
+    incref_requests_type incref_requests_;      // protected by refcnt_requests_mtx_
+
+    std::atomic<std::int64_t> refcnt_merged_count_;
+    std::atomic<std::int64_t> refcnt_sent_count_;
+    std::atomic<std::int64_t> refcnt_messages_count_;
+
+    // statistics of the migration operations started on this locality
+    std::atomic<std::int64_t> migration_count_;
+    std::atomic<std::int64_t> migration_downtime_;
+    std::atomic<std::int64_t> migration_precopy_count_;
+    std::atomic<std::int64_t> migration_recopy_count_;
+    std::atomic<std::int64_t> migration_precopy_time_;
+
     service_mode const service_type;
     runtime_mode const runtime_type;
 
@@ -200,6 +226,13 @@ public:
         error_code& ec = throws
         );
 
+    /// Send the buffered decrements of global reference counts if the
+    /// oldest of them has been waiting for longer than the configured
+    /// interval (hpx.agas.refcnt_flush_interval).
+    void garbage_collect_expired_non_blocking(
+        error_code& ec = throws
+        );
+
     std::int64_t synchronize_with_async_incref(
         hpx::future<std::int64_t> fut
       , naming::id_type const& id
@@ -265,6 +298,18 @@ private:
       , error_code& ec
         );
 
+    /// Assumes that \a refcnt_requests_mtx_ is locked, unlocks it.
+    void send_incref_requests(
+        std::unique_lock<mutex_type>& l
+      , std::uint32_t locality_id
+        );
+
+    void synchronize_with_incref_requests(
+        hpx::future<std::vector<std::int64_t> > f
+      , std::uint32_t locality_id
+      , std::shared_ptr<lcos::local::promise<void> > const& p
+        );
+
     // Helper functions to access the current cache statistics
     std::uint64_t get_cache_entries(bool);
     std::uint64_t get_cache_hits(bool);
@@ -282,6 +327,18 @@ private:
     std::uint64_t get_cache_update_entry_time(bool reset);
     std::uint64_t get_cache_erase_entry_time(bool reset);
 
+    // Helper functions to access the reference counting statistics
+    std::uint64_t get_refcnt_merged_count(bool reset);
+    std::uint64_t get_refcnt_sent_count(bool reset);
+    std::uint64_t get_refcnt_messages_count(bool reset);
+
+    // Helper functions to access the migration statistics
+    std::uint64_t get_migration_count(bool reset);
+    std::uint64_t get_migration_downtime(bool reset);
+    std::uint64_t get_migration_precopy_count(bool reset);
+    std::uint64_t get_migration_recopy_count(bool reset);
+    std::uint64_t get_migration_precopy_time(bool reset);
+
 public:
     /// \brief Add a locality to the runtime.
     bool register_locality(
@@ -1406,6 +1463,17 @@ public:
     /// Remove the given object from the table of migrated objects
     void unmark_as_migrated(naming::gid_type const& gid);
 
+    /// Account for a finished migration of an object which was located on
+    /// this locality. The downtime is the time (in nanoseconds) the object
+    /// was not able to serve any requests.
+    void report_migration_downtime(std::uint64_t downtime);
+
+    /// Account for the state of an object which was copied to its new
+    /// location while the object was still serving requests (in
+    /// nanoseconds). The flag \a recopied tells whether the object was
+    /// modified meanwhile, requiring to copy its state once more.
+    void report_migration_precopy(std::uint64_t precopy_time, bool recopied);
+
     // Pre-cache locality endpoints in hosted locality namespace
     void pre_cache_endpoints(std::vector<parcelset::endpoints_type> const&);
 };
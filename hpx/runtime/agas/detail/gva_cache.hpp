@@ -0,0 +1,693 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_AGAS_DETAIL_GVA_CACHE_HPP)
+#define HPX_AGAS_DETAIL_GVA_CACHE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/agas/gva.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/cache/statistics/local_full_statistics.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace agas { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Concurrent cache of resolved GVA ranges, this is used as the local AGAS
+    // address cache.
+    //
+    // The cache is split into stripes, each of which is protected by its own
+    // lock. Entries for single gids (count == 1, the common case) are stored
+    // in the stripe the gid hashes to, thus consecutive gids (as handed out
+    // by get_next_id) are spread over all stripes.
+    //
+    // A cached range of gids is split into fragments at the boundaries of
+    // the blocks of (1 << block_bits) consecutive gids it covers. Every
+    // fragment is stored in the stripe its block hashes to. Ranges touching
+    // more than max_fragments blocks are cached for their first
+    // max_fragments blocks. Whenever a fragment is evicted, all other
+    // fragments of the same range are removed as well.
+    //
+    // A stripe maintains a hash index from gids (for single gid entries) and
+    // from blocks (for fragments) to its slots. Looking up a gid checks for
+    // an entry for this gid first and scans the (usually very few) fragments
+    // of its block afterwards.
+    //
+    // Each stripe holds a fixed number of slots which are recycled using the
+    // CLOCK algorithm (an approximation of LRU): a successful lookup marks
+    // the entry as referenced, the eviction skips (and resets) referenced
+    // entries.
+    //
+    // The statistics are collected per stripe and are accumulated on demand.
+    class gva_cache
+    {
+    public:
+        typedef lcos::local::spinlock mutex_type;
+        typedef util::cache::statistics::local_full_statistics statistics_type;
+
+        static std::size_t const num_stripes = 64;
+        static std::size_t const block_bits = 12;
+        static std::uint64_t const max_fragments = 16;
+
+    private:
+        typedef statistics_type::update_on_exit update_on_exit;
+
+        struct entry
+        {
+            naming::gid_type block_;        // key of this entry in the index
+            naming::gid_type base_;         // first gid of the cached range
+            std::uint64_t count_;           // zero if the slot is unused
+            gva gva_;
+            bool referenced_;               // CLOCK reference bit
+
+            bool contains(naming::gid_type const& id) const
+            {
+                return base_ <= id && id < base_ + count_;
+            }
+
+            bool overlaps(naming::gid_type const& base,
+                std::uint64_t count) const
+            {
+                return base_ < base + count && base < base_ + count_;
+            }
+        };
+
+        struct key_hash
+        {
+            std::size_t operator()(naming::gid_type const& key) const
+            {
+                return hash_key(key);
+            }
+        };
+
+        typedef std::unordered_multimap<
+                naming::gid_type, std::size_t, key_hash
+            > index_type;
+
+        // ranges which have lost some of their fragments, the remaining
+        // fragments have to be removed as well
+        typedef std::vector<std::pair<naming::gid_type, std::uint64_t> >
+            evicted_ranges_type;
+
+        struct stripe
+        {
+            stripe()
+              : capacity_(0), size_(0), hand_(0)
+            {}
+
+            mutex_type mtx_;
+            std::vector<entry> slots_;
+            std::vector<std::size_t> free_slots_;
+            index_type index_;              // gid or block -> slot
+            std::size_t capacity_;          // max number of slots
+            std::size_t size_;              // number of cached ranges
+            std::size_t hand_;              // CLOCK hand
+            statistics_type statistics_;
+        };
+
+    public:
+        explicit gva_cache(std::size_t max_size = 0)
+          : stripes_(new stripe[num_stripes])
+        {
+            reserve(max_size);
+        }
+
+        gva_cache(gva_cache const&) = delete;
+        gva_cache& operator=(gva_cache const&) = delete;
+
+        ///////////////////////////////////////////////////////////////////////
+        // Change the maximum number of fragments this cache can hold
+        void reserve(std::size_t max_size)
+        {
+            std::size_t const capacity =
+                (max_size + num_stripes - 1) / num_stripes;
+
+            evicted_ranges_type evicted;
+            for (std::size_t i = 0; i != num_stripes; ++i)
+            {
+                stripe& s = stripes_[i];
+                std::lock_guard<mutex_type> l(s.mtx_);
+
+                s.capacity_ = capacity;
+                if (s.slots_.size() <= capacity)
+                    continue;
+
+                // evict all entries stored in slots beyond the new capacity
+                for (std::size_t slot = capacity; slot != s.slots_.size(); ++slot)
+                {
+                    if (is_used(s, slot))
+                        evict_slot(s, slot, evicted);
+                }
+                s.slots_.resize(capacity);
+                s.free_slots_.clear();
+                for (std::size_t slot = 0; slot != capacity; ++slot)
+                {
+                    if (!is_used(s, slot))
+                        s.free_slots_.push_back(slot);
+                }
+                s.hand_ = 0;
+            }
+
+            remove_evicted_ranges(evicted);
+        }
+
+        // Return the number of cached ranges
+        std::size_t size() const
+        {
+            std::size_t result = 0;
+            for (std::size_t i = 0; i != num_stripes; ++i)
+            {
+                stripe& s = stripes_[i];
+                std::lock_guard<mutex_type> l(s.mtx_);
+                result += s.size_;
+            }
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Look up the range the given gid belongs to, returns the base gid of
+        // the range and the corresponding GVA
+        bool get_entry(naming::gid_type const& id, naming::gid_type& base,
+            gva& g)
+        {
+            naming::gid_type const gid = naming::detail::get_stripped_gid(id);
+
+            // look for an entry for this gid first
+            {
+                stripe& s = get_stripe(gid);
+
+                std::lock_guard<mutex_type> l(s.mtx_);
+
+                std::size_t slot = find_single_slot(s, gid);
+                if (slot != std::size_t(-1))
+                {
+                    update_on_exit update(s.statistics_,
+                        util::cache::statistics::method_get_entry);
+
+                    entry& e = s.slots_[slot];
+                    e.referenced_ = true;
+
+                    s.statistics_.got_hit();
+
+                    base = e.base_;
+                    g = e.gva_;
+                    return true;
+                }
+            }
+
+            // now look for a range covering the gid
+            naming::gid_type const block = get_block(gid, 0);
+            stripe& s = get_stripe(block);
+
+            std::lock_guard<mutex_type> l(s.mtx_);
+            update_on_exit update(s.statistics_,
+                util::cache::statistics::method_get_entry);
+
+            std::size_t slot = find_slot(s, block, gid);
+            if (slot == std::size_t(-1))
+            {
+                s.statistics_.got_miss();
+                return false;
+            }
+
+            entry& e = s.slots_[slot];
+            e.referenced_ = true;
+
+            s.statistics_.got_hit();
+
+            base = e.base_;
+            g = e.gva_;
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Insert the given range or update the GVA if the range is cached
+        // already. The update of a range is rejected (and the colliding range
+        // is returned) if the cache holds a different range overlapping with
+        // the first block of the given one.
+        bool update_entry(naming::gid_type const& id, std::uint64_t count,
+            gva const& g, naming::gid_type& collision_base,
+            std::uint64_t& collision_count)
+        {
+            HPX_ASSERT(count != 0);
+
+            naming::gid_type const base = naming::detail::get_stripped_gid(id);
+            collision_count = 0;
+
+            evicted_ranges_type evicted;
+            if (count == 1)
+            {
+                stripe& s = get_stripe(base);
+
+                std::lock_guard<mutex_type> l(s.mtx_);
+                update_on_exit update(s.statistics_,
+                    util::cache::statistics::method_update_entry);
+
+                std::size_t slot = find_single_slot(s, base);
+                if (slot != std::size_t(-1))
+                {
+                    // got hit!
+                    entry& e = s.slots_[slot];
+                    e.gva_ = g;
+                    e.referenced_ = true;
+                    s.statistics_.got_hit();
+                    return true;
+                }
+
+                // got miss
+                s.statistics_.got_miss();
+
+                update_on_exit update_insert(s.statistics_,
+                    util::cache::statistics::method_insert_entry);
+                if (store_fragment(s, base, base, 1, g, evicted))
+                {
+                    ++s.size_;
+                    s.statistics_.got_insertion();
+                }
+            }
+            else
+            {
+                update_range(base, count, g, collision_base, collision_count,
+                    evicted);
+            }
+
+            remove_evicted_ranges(evicted);
+            return collision_count == 0;
+        }
+
+    private:
+        void update_range(naming::gid_type const& base, std::uint64_t count,
+            gva const& g, naming::gid_type& collision_base,
+            std::uint64_t& collision_count, evicted_ranges_type& evicted)
+        {
+            std::uint64_t const num_blocks = get_num_blocks(base, count);
+
+            {
+                naming::gid_type const block = get_block(base, 0);
+                stripe& s = get_stripe(block);
+
+                std::lock_guard<mutex_type> l(s.mtx_);
+                update_on_exit update(s.statistics_,
+                    util::cache::statistics::method_update_entry);
+
+                std::pair<index_type::iterator, index_type::iterator> r =
+                    s.index_.equal_range(block);
+                for (/**/; r.first != r.second; ++r.first)
+                {
+                    entry& e = s.slots_[r.first->second];
+                    if (e.count_ == 1 || !e.overlaps(base, count))
+                        continue;
+
+                    if (e.base_ != base || e.count_ != count)
+                    {
+                        collision_base = e.base_;
+                        collision_count = e.count_;
+                        return;
+                    }
+
+                    // got hit!
+                    e.gva_ = g;
+                    e.referenced_ = true;
+                    s.statistics_.got_hit();
+                    break;
+                }
+
+                if (r.first == r.second)
+                {
+                    // got miss
+                    s.statistics_.got_miss();
+
+                    update_on_exit update(s.statistics_,
+                        util::cache::statistics::method_insert_entry);
+                    if (store_fragment(s, block, base, count, g, evicted))
+                    {
+                        ++s.size_;
+                        s.statistics_.got_insertion();
+                    }
+                }
+            }
+
+            // update the fragments stored for the remaining blocks
+            for (std::uint64_t i = 1; i < num_blocks; ++i)
+            {
+                naming::gid_type const block = get_block(base, i);
+                stripe& s = get_stripe(block);
+
+                std::lock_guard<mutex_type> l(s.mtx_);
+                store_fragment(s, block, base, count, g, evicted);
+            }
+        }
+
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        // Remove the range starting at the given gid, returns whether the
+        // range was cached.
+        bool erase(naming::gid_type const& id)
+        {
+            naming::gid_type const base = naming::detail::get_stripped_gid(id);
+
+            // look for an entry for this gid first
+            {
+                stripe& s = get_stripe(base);
+
+                std::lock_guard<mutex_type> l(s.mtx_);
+
+                std::size_t slot = find_single_slot(s, base);
+                if (slot != std::size_t(-1))
+                {
+                    update_on_exit update(s.statistics_,
+                        util::cache::statistics::method_erase_entry);
+
+                    remove_slot(s, slot);
+                    s.statistics_.got_eviction();
+                    return true;
+                }
+            }
+
+            // Fragments are never left behind if the first fragment of their
+            // range is evicted (see remove_evicted_ranges), thus the range is
+            // not cached if there is no first fragment.
+            std::uint64_t count = 0;
+            {
+                naming::gid_type const block = get_block(base, 0);
+                stripe& s = get_stripe(block);
+
+                std::lock_guard<mutex_type> l(s.mtx_);
+                update_on_exit update(s.statistics_,
+                    util::cache::statistics::method_erase_entry);
+
+                std::pair<index_type::iterator, index_type::iterator> r =
+                    s.index_.equal_range(block);
+                for (/**/; r.first != r.second; ++r.first)
+                {
+                    entry const& e = s.slots_[r.first->second];
+                    if (e.count_ != 1 && e.base_ == base)
+                        break;
+                }
+
+                if (r.first == r.second)
+                    return false;
+
+                count = s.slots_[r.first->second].count_;
+                remove_slot(s, r.first->second);
+                s.statistics_.got_eviction();
+            }
+
+            // remove the fragments stored for the remaining blocks
+            remove_fragments(base, count, 1);
+            return true;
+        }
+
+        // Remove all entries from the cache
+        void clear()
+        {
+            for (std::size_t i = 0; i != num_stripes; ++i)
+            {
+                stripe& s = stripes_[i];
+                std::lock_guard<mutex_type> l(s.mtx_);
+
+                s.slots_.clear();
+                s.free_slots_.clear();
+                s.index_.clear();
+                s.size_ = 0;
+                s.hand_ = 0;
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Accumulate a statistics value over all stripes, f is invoked with
+        // the statistics instance of each of the stripes
+        template <typename F>
+        std::int64_t get_statistics(F && f) const
+        {
+            std::int64_t result = 0;
+            for (std::size_t i = 0; i != num_stripes; ++i)
+            {
+                stripe& s = stripes_[i];
+                std::lock_guard<mutex_type> l(s.mtx_);
+                result += static_cast<std::int64_t>(f(s.statistics_));
+            }
+            return result;
+        }
+
+    private:
+        // Fibonacci hashing spreads neighboring gids (and blocks) over the
+        // stripes
+        static std::size_t hash_key(naming::gid_type const& key)
+        {
+            std::uint64_t h = key.get_msb() ^ key.get_lsb();
+            h *= 0x9e3779b97f4a7c15ull;
+            return static_cast<std::size_t>(h >> 32);
+        }
+
+        // return the stripe responsible for the given gid (or block)
+        stripe& get_stripe(naming::gid_type const& key) const
+        {
+            return stripes_[hash_key(key) & (num_stripes - 1)];
+        }
+
+        // return the n'th block of the range starting at the given gid
+        static naming::gid_type get_block(naming::gid_type const& id,
+            std::uint64_t n)
+        {
+            return naming::gid_type(id.get_msb(),
+                ((id.get_lsb() >> block_bits) + n) << block_bits);
+        }
+
+        static std::uint64_t get_num_blocks(naming::gid_type const& id,
+            std::uint64_t count)
+        {
+            naming::gid_type const upper(id + (count - 1));
+            if (upper.get_msb() != id.get_msb())
+                return max_fragments;
+
+            std::uint64_t const num_blocks =
+                (upper.get_lsb() >> block_bits) - (id.get_lsb() >> block_bits) + 1;
+            return (num_blocks < max_fragments) ? num_blocks : max_fragments;
+        }
+
+        static bool is_used(stripe const& s, std::size_t slot)
+        {
+            return s.slots_[slot].count_ != 0;
+        }
+
+        // find the entry stored for the given (single) gid
+        static std::size_t find_single_slot(stripe& s,
+            naming::gid_type const& id)
+        {
+            std::pair<index_type::iterator, index_type::iterator> r =
+                s.index_.equal_range(id);
+            for (/**/; r.first != r.second; ++r.first)
+            {
+                entry const& e = s.slots_[r.first->second];
+                if (e.count_ == 1 && e.base_ == id)
+                    return r.first->second;
+            }
+            return std::size_t(-1);
+        }
+
+        // find the fragment stored for the given block covering the gid
+        static std::size_t find_slot(stripe& s, naming::gid_type const& block,
+            naming::gid_type const& id)
+        {
+            std::pair<index_type::iterator, index_type::iterator> r =
+                s.index_.equal_range(block);
+            for (/**/; r.first != r.second; ++r.first)
+            {
+                entry const& e = s.slots_[r.first->second];
+                if (e.count_ != 1 && e.contains(id))
+                    return r.first->second;
+            }
+            return std::size_t(-1);
+        }
+
+        // remove the fragments of the given range stored for the blocks
+        // starting at the given one
+        void remove_fragments(naming::gid_type const& base,
+            std::uint64_t count, std::uint64_t first_block)
+        {
+            std::uint64_t const num_blocks = get_num_blocks(base, count);
+            for (std::uint64_t i = first_block; i < num_blocks; ++i)
+            {
+                naming::gid_type const block = get_block(base, i);
+                stripe& s = get_stripe(block);
+
+                std::lock_guard<mutex_type> l(s.mtx_);
+
+                std::pair<index_type::iterator, index_type::iterator> r =
+                    s.index_.equal_range(block);
+                for (/**/; r.first != r.second; ++r.first)
+                {
+                    entry const& e = s.slots_[r.first->second];
+                    if (e.count_ == count && e.base_ == base)
+                    {
+                        remove_slot(s, r.first->second);
+                        break;
+                    }
+                }
+            }
+        }
+
+        // remove all fragments of ranges which have lost some of their
+        // fragments, this has to be called without holding any lock
+        void remove_evicted_ranges(evicted_ranges_type const& evicted)
+        {
+            for (auto const& r : evicted)
+                remove_fragments(r.first, r.second, 0);
+        }
+
+        // Store a fragment of the given range in the given stripe (or an
+        // entry for a single gid, in which case the key is the gid itself),
+        // any existing fragments overlapping with the range are replaced.
+        // Returns whether a new fragment was stored.
+        bool store_fragment(stripe& s, naming::gid_type const& key,
+            naming::gid_type const& base, std::uint64_t count, gva const& g,
+            evicted_ranges_type& evicted)
+        {
+            bool found = false;
+
+            std::pair<index_type::iterator, index_type::iterator> r =
+                s.index_.equal_range(key);
+            while (r.first != r.second)
+            {
+                std::size_t slot = (r.first++)->second;
+                entry& e = s.slots_[slot];
+
+                // single gids and ranges are indexed independently
+                if ((e.count_ == 1) != (count == 1))
+                    continue;
+
+                if (e.base_ == base && e.count_ == count)
+                {
+                    e.gva_ = g;
+                    found = true;
+                }
+                else if (e.overlaps(base, count))
+                {
+                    // the cached range is stale
+                    evict_slot(s, slot, evicted);
+                    s.statistics_.got_eviction();
+                }
+            }
+
+            if (found)
+                return false;
+
+            std::size_t slot = allocate_slot(s, evicted);
+            if (slot == std::size_t(-1))
+                return false;
+
+            entry& e = s.slots_[slot];
+            e.block_ = key;
+            e.base_ = base;
+            e.count_ = count;
+            e.gva_ = g;
+            e.referenced_ = false;
+
+            s.index_.insert(index_type::value_type(key, slot));
+            return true;
+        }
+
+        // Find a slot for a new fragment, evicts an existing fragment if
+        // necessary
+        static std::size_t allocate_slot(stripe& s,
+            evicted_ranges_type& evicted)
+        {
+            if (!s.free_slots_.empty())
+            {
+                std::size_t slot = s.free_slots_.back();
+                s.free_slots_.pop_back();
+                return slot;
+            }
+
+            if (s.slots_.size() < s.capacity_)
+            {
+                s.slots_.push_back(entry());
+                return s.slots_.size() - 1;
+            }
+
+            if (s.slots_.empty())
+                return std::size_t(-1);
+
+            // CLOCK: evict the first entry which was not referenced since
+            // the hand passed it the last time
+            while (true)
+            {
+                std::size_t slot = s.hand_;
+                s.hand_ = (s.hand_ + 1) % s.slots_.size();
+
+                entry& e = s.slots_[slot];
+                if (e.referenced_)
+                {
+                    e.referenced_ = false;
+                    continue;
+                }
+
+                evict_slot(s, slot, evicted);
+                s.statistics_.got_eviction();
+
+                HPX_ASSERT(!s.free_slots_.empty() &&
+                    s.free_slots_.back() == slot);
+                s.free_slots_.pop_back();
+                return slot;
+            }
+        }
+
+        // remove the fragment stored in the given slot
+        static void remove_slot(stripe& s, std::size_t slot)
+        {
+            entry& e = s.slots_[slot];
+            HPX_ASSERT(e.count_ != 0);
+
+            std::pair<index_type::iterator, index_type::iterator> r =
+                s.index_.equal_range(e.block_);
+            for (/**/; r.first != r.second; ++r.first)
+            {
+                if (r.first->second == slot)
+                {
+                    s.index_.erase(r.first);
+                    break;
+                }
+            }
+
+            // only the first fragment of a range accounts for the size
+            if (e.count_ == 1 || e.block_ == get_block(e.base_, 0))
+            {
+                HPX_ASSERT(s.size_ != 0);
+                --s.size_;
+            }
+
+            e = entry();
+            s.free_slots_.push_back(slot);
+        }
+
+        // Remove the fragment stored in the given slot, remember its range
+        // if the range has fragments stored for other blocks. Those have to
+        // be removed as well, which may be done only after the lock of the
+        // stripe has been released.
+        static void evict_slot(stripe& s, std::size_t slot,
+            evicted_ranges_type& evicted)
+        {
+            entry const& e = s.slots_[slot];
+            if (e.count_ != 1 && get_num_blocks(e.base_, e.count_) > 1)
+                evicted.push_back(std::make_pair(e.base_, e.count_));
+
+            remove_slot(s, slot);
+        }
+
+        std::unique_ptr<stripe[]> stripes_;
+    };
+}}}
+
+#endif
@@ -395,6 +395,13 @@ HPX_API_EXPORT void garbage_collect(
     error_code& ec = throws
     );
 
+/// \brief Send the buffered decrements of global reference counts if the
+///        oldest of them has been waiting for longer than the configured
+///        interval (hpx.agas.refcnt_flush_interval).
+HPX_API_EXPORT void garbage_collect_expired_non_blocking(
+    error_code& ec = throws
+    );
+
 ///////////////////////////////////////////////////////////////////////////////
 /// \brief Invoke an asynchronous garbage collection step on the given target
 ///        locality.
@@ -494,6 +501,10 @@ HPX_API_EXPORT std::pair<bool, components::pinned_ptr>
         util::unique_function_nonser<components::pinned_ptr()> && f);
 
 HPX_API_EXPORT void unmark_as_migrated(naming::gid_type const& gid);
+
+HPX_API_EXPORT void report_migration_downtime(std::uint64_t downtime);
+HPX_API_EXPORT void report_migration_precopy(
+    std::uint64_t precopy_time, bool recopied);
 }}
 
 #endif // HPX_A55506A4_4AC7_4FD0_AB0D_ED0D1368FCC5
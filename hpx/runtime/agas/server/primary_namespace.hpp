@@ -1,6 +1,6 @@
 ////////////////////////////////////////////////////////////////////////////////
 //  Copyright (c) 2011 Bryce Adelstein-Lelbach
-//  Copyright (c) 2012-2016 Hartmut Kaiser
+//  Copyright (c) 2012-2017 Hartmut Kaiser
 //  Copyright (c) 2016 Thomas Heller
 //
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
@@ -19,6 +19,7 @@
 #include <hpx/runtime/components/server/fixed_component_base.hpp>
 #include <hpx/runtime/naming/id_type.hpp>
 #include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/parcelset/parcel.hpp>
 #include <hpx/traits/action_message_handler.hpp>
 #include <hpx/traits/action_serialization_filter.hpp>
 #include <hpx/util/tuple.hpp>
@@ -132,21 +133,82 @@ struct HPX_EXPORT primary_namespace
     // }}}
 
   private:
-    // REVIEW: Separate mutexes might reduce contention here. This has to be
-    // investigated carefully.
-    mutex_type mutex_;
-
-    gva_table_type gvas_;
-    refcnt_table_type refcnts_;
+    // An entry in the migration table holds the flag marking the object as
+    // being migrated, the number of threads waiting for the migration to
+    // finish, the condition variable they are waiting on, and the parcels
+    // which were routed to the object while it was being migrated (those
+    // are routed again once the migration has finished).
     typedef std::map<
             naming::gid_type,
-            hpx::util::tuple<bool, std::size_t, lcos::local::condition_variable_any>
+            hpx::util::tuple<
+                bool, std::size_t, lcos::local::condition_variable_any,
+                std::vector<parcelset::parcel>
+            >
         > migration_table_type;
 
+    // The GVA, reference count, and migration tables are split into shards,
+    // each of which is protected by its own lock. This allows for operations
+    // on unrelated gids to proceed concurrently. A gid is assigned to a shard
+    // based on the block of (1 << gid_block_bits) consecutive ids it belongs
+    // to.
+    //
+    // A bound GVA range is split into fragments at the block boundaries, each
+    // fragment is stored in the shard of its block, thus a gid can always be
+    // resolved by looking at its own shard only. Ranges touching more than
+    // max_range_fragments blocks are stored in a separate table instead (see
+    // large_gvas_), which is consulted whenever the lookup in the shard does
+    // not succeed.
+    static std::size_t const num_shards = 64;
+    static std::size_t const gid_block_bits = 12;
+    static std::uint64_t const max_range_fragments = 16;
+
+    struct gva_fragment
+    {
+        naming::gid_type base_;         // first gid of the range
+        gva_table_data_type data_;
+    };
+    typedef std::map<naming::gid_type, gva_fragment> gva_fragment_table_type;
+
+    struct shard
+    {
+        mutex_type mutex_;
+        gva_fragment_table_type gvas_;
+        refcnt_table_type refcnts_;
+        migration_table_type migrating_objects_;
+    };
+
+    static std::size_t get_shard_index(naming::gid_type const& id);
+
+    shard& get_shard(naming::gid_type const& id)
+    {
+        return shards_[get_shard_index(id)];
+    }
+
+    static naming::gid_type get_block_base(
+        naming::gid_type const& id, std::uint64_t block);
+    static std::uint64_t get_num_blocks(
+        naming::gid_type const& id, std::uint64_t count);
+
+    void store_range_fragments(
+        naming::gid_type const& id
+      , std::uint64_t num_blocks
+      , gva_table_data_type const& data
+        );
+    void erase_range_fragments(
+        naming::gid_type const& id
+      , std::uint64_t num_blocks
+        );
+
+    shard shards_[num_shards];
+
+    // GVA ranges touching too many blocks, this lock is always acquired
+    // after the lock of a shard (if any)
+    mutex_type large_gvas_mutex_;
+    gva_table_type large_gvas_;
+
     std::string instance_name_;
     naming::gid_type next_id_;      // next available gid
     naming::gid_type locality_;     // our locality id
-    migration_table_type migrating_objects_;
 
     struct update_time_on_exit;
 
@@ -222,19 +284,17 @@ struct HPX_EXPORT primary_namespace
     counter_data counter_data_;
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
-    /// Dump the credit counts of all matching ranges. Expects that \p l
-    /// is locked.
+    /// Dump the credit counts of all matching ranges. Acquires the locks of
+    /// the involved shards.
     void dump_refcnt_matches(
-        refcnt_table_type::iterator lower_it
-      , refcnt_table_type::iterator upper_it
-      , naming::gid_type const& lower
+        naming::gid_type const& lower
       , naming::gid_type const& upper
-      , std::unique_lock<mutex_type>& l
       , const char* func_name
         );
 #endif
 
-    // helper function
+    // helper function, expects that \p l holds the lock of the shard \p id
+    // belongs to
     void wait_for_migration_locked(
         std::unique_lock<mutex_type>& l
       , naming::gid_type id
@@ -243,7 +303,7 @@ struct HPX_EXPORT primary_namespace
   public:
     primary_namespace()
       : base_type(HPX_AGAS_PRIMARY_NS_MSB, HPX_AGAS_PRIMARY_NS_LSB)
-      , mutex_()
+      , large_gvas_mutex_()
       , instance_name_()
       , next_id_(naming::invalid_gid)
       , locality_(naming::invalid_gid)
@@ -302,6 +362,9 @@ struct HPX_EXPORT primary_namespace
       , naming::gid_type upper
         );
 
+    /// Apply a list of reference count updates. Negative credits are
+    /// decrements, positive ones are increments. The updates are applied in
+    /// the given order.
     std::vector<std::int64_t> decrement_credit(
         std::vector<
             hpx::util::tuple<std::int64_t, naming::gid_type, naming::gid_type>
@@ -313,6 +376,7 @@ struct HPX_EXPORT primary_namespace
     naming::gid_type statistics_counter(std::string const& name);
 
   private:
+    // expects that \p l holds the lock of the shard \p gid belongs to
     resolved_type resolve_gid_locked(
         std::unique_lock<mutex_type>& l
       , naming::gid_type const& gid
@@ -340,7 +404,8 @@ struct HPX_EXPORT primary_namespace
     };
 
     void resolve_free_list(
-        std::unique_lock<mutex_type>& l
+        shard& s
+      , std::unique_lock<mutex_type>& l
       , std::list<refcnt_table_type::iterator> const& free_list
       , std::list<free_entry>& free_entry_list
       , naming::gid_type const& lower
@@ -158,6 +158,146 @@ namespace hpx { namespace components
         return Derived(migrate<component_type>(to_migrate.get_id(),
             target_locality));
     }
+
+    /// Migrate the given component to the specified target locality while
+    /// the component keeps serving requests for most of the time
+    ///
+    /// The function \a live_migrate<Component> will migrate the component
+    /// referenced by \a to_migrate to the locality specified with
+    /// \a policy. In contrast to \a migrate, the state of the component is
+    /// copied to the target locality while the component still serves
+    /// requests. The component is unavailable only while its global id is
+    /// re-bound to the copy (and while its state is copied again if it
+    /// was accessed after the first copy was started). Requests which arrive
+    /// during this time are forwarded to the new location of the component.
+    ///
+    /// \param to_migrate      [in] The client side representation of the
+    ///                        component to migrate.
+    /// \param policy          [in] A distribution policy which will be used to
+    ///                        determine the locality to migrate this object to.
+    ///
+    /// \tparam  Component     Specifies the component type of the
+    ///                        component to migrate.
+    /// \tparam  DistPolicy    Specifies the distribution policy to use to
+    ///                        determine the destination locality.
+    ///
+    /// \returns A future representing the global id of the migrated
+    ///          component instance. This should be the same as \a migrate_to.
+    ///
+    /// \note The serialization of the component has to be safe to be
+    ///       executed concurrently with the actions of the component. A
+    ///       component declares this by implementing a static member
+    ///       function \a supports_live_migration() returning true.
+    ///       Components which don't are migrated as if \a migrate was
+    ///       called.
+    ///
+    template <typename Component, typename DistPolicy>
+#if defined(DOXYGEN)
+    future<naming::id_type>
+#else
+    inline typename std::enable_if<
+        traits::is_component<Component>::value &&
+            traits::is_distribution_policy<DistPolicy>::value,
+        future<naming::id_type>
+    >::type
+#endif
+    live_migrate(naming::id_type const& to_migrate, DistPolicy const& policy)
+    {
+        typedef server::perform_live_migrate_component_action<
+                Component, DistPolicy
+            > action_type;
+        return hpx::detail::async_colocated<action_type>(to_migrate,
+            to_migrate, policy);
+    }
+
+    /// Migrate the given component to the specified target locality while
+    /// the component keeps serving requests for most of the time (see
+    /// \a live_migrate above)
+    ///
+    /// \param to_migrate      [in] The client side representation of the
+    ///                        component to migrate.
+    /// \param policy          [in] A distribution policy which will be used to
+    ///                        determine the locality to migrate this object to.
+    ///
+    /// \tparam  Derived       Specifies the component type of the
+    ///                        component to migrate.
+    /// \tparam  DistPolicy    Specifies the distribution policy to use to
+    ///                        determine the destination locality.
+    ///
+    /// \returns A client side representation of representing of the migrated
+    ///          component instance. This should be the same as \a migrate_to.
+    ///
+    template <typename Derived, typename Stub, typename DistPolicy>
+#if defined(DOXYGEN)
+    Derived
+#else
+    inline typename std::enable_if<
+        traits::is_distribution_policy<DistPolicy>::value, Derived
+    >::type
+#endif
+    live_migrate(client_base<Derived, Stub> const& to_migrate,
+        DistPolicy const& policy)
+    {
+        typedef typename client_base<Derived, Stub>::server_component_type
+            component_type;
+        return Derived(live_migrate<component_type>(to_migrate.get_id(),
+            policy));
+    }
+
+    /// Migrate the component with the given id to the specified target
+    /// locality while the component keeps serving requests for most of the
+    /// time (see \a live_migrate above)
+    ///
+    /// \param to_migrate      [in] The global id of the component to migrate.
+    /// \param target_locality [in] The locality where the component should be
+    ///                        migrated to.
+    ///
+    /// \tparam  Component     Specifies the component type of the
+    ///          component to migrate.
+    ///
+    /// \returns A future representing the global id of the migrated
+    ///          component instance. This should be the same as \a migrate_to.
+    ///
+    template <typename Component>
+#if defined(DOXYGEN)
+    future<naming::id_type>
+#else
+    inline typename std::enable_if<
+        traits::is_component<Component>::value, future<naming::id_type>
+    >::type
+#endif
+    live_migrate(naming::id_type const& to_migrate,
+        naming::id_type const& target_locality)
+    {
+        return live_migrate<Component>(to_migrate,
+            hpx::target(target_locality));
+    }
+
+    /// Migrate the given component to the specified target locality while
+    /// the component keeps serving requests for most of the time (see
+    /// \a live_migrate above)
+    ///
+    /// \param to_migrate      [in] The client side representation of the
+    ///                        component to migrate.
+    /// \param target_locality [in] The id of the locality to migrate
+    ///                        this object to.
+    ///
+    /// \tparam  Derived       Specifies the component type of the
+    ///                        component to migrate.
+    ///
+    /// \returns A client side representation of representing of the migrated
+    ///          component instance. This should be the same as \a migrate_to.
+    ///
+    template <typename Derived, typename Stub>
+    inline Derived
+    live_migrate(client_base<Derived, Stub> const& to_migrate,
+        naming::id_type const& target_locality)
+    {
+        typedef typename client_base<Derived, Stub>::server_component_type
+            component_type;
+        return Derived(live_migrate<component_type>(to_migrate.get_id(),
+            target_locality));
+    }
 }}
 
 #endif
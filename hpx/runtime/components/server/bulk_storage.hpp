@@ -0,0 +1,65 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_COMPONENTS_SERVER_BULK_STORAGE_HPP)
+#define HPX_COMPONENTS_SERVER_BULK_STORAGE_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/naming_fwd.hpp>
+#include <hpx/traits/detail/wrap_int.hpp>
+
+#include <cstddef>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace components { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Storage for component instances which are created in bulk (see
+    // server::bulk_create). All instances of one block are placed next to
+    // each other, which allows to bind them in AGAS as a single range of
+    // gids. The block is released (and the range of gids is unbound) as soon
+    // as the last of its instances has been freed.
+
+    // Allocate a new block of storage for count instances of the given size
+    HPX_EXPORT void* allocate_bulk_storage(std::size_t count, std::size_t size);
+
+    // Remember the range of gids the instances in the given block have been
+    // bound to
+    HPX_EXPORT void set_bulk_storage_gid(void* storage,
+        naming::gid_type const& base_gid);
+
+    // Release count instances starting at the given address, returns false
+    // if the instances are not located in a block of storage
+    HPX_EXPORT bool free_bulk_storage(void* p, std::size_t count);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Only instances of components derived from component_base can be created
+    // in bulk, those know whether they were.
+    struct is_bulk_created_helper
+    {
+        template <typename Component>
+        static bool call(traits::detail::wrap_int, Component const&)
+        {
+            return false;
+        }
+
+        template <typename Component>
+        static auto call(int, Component const& c)
+        ->  decltype(c.is_bulk_created())
+        {
+            return c.is_bulk_created();
+        }
+    };
+
+    // Return whether the given instance was created in bulk, this has to be
+    // queried before the instance is destroyed
+    template <typename Component>
+    bool is_bulk_created(Component const& c)
+    {
+        return is_bulk_created_helper::call(0, c);
+    }
+}}}
+
+#endif
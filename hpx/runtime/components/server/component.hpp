@@ -9,6 +9,7 @@
 #define HPX_RUNTIME_COMPONENTS_SERVER_COMPONENT_HPP
 
 #include <hpx/config.hpp>
+#include <hpx/runtime/components/server/bulk_storage.hpp>
 #include <hpx/util/assert.hpp>
 
 #include <cstddef>
@@ -19,17 +20,29 @@ namespace hpx { namespace components {
 
     namespace detail {
         ///////////////////////////////////////////////////////////////////////
+        // Instances are allocated one by one, except if more than one is
+        // requested at once (see server::bulk_create). Those are placed
+        // next to each other into one block of storage.
         template <typename Component>
         struct simple_heap
         {
             void* alloc(std::size_t count)
             {
-                HPX_ASSERT(1 == count);
+                HPX_ASSERT(0 != count);
+                if (count != 1)
+                    return allocate_bulk_storage(count, sizeof(Component));
                 return ::operator new(sizeof(Component));
             }
+            // Single instances which were created in bulk are released
+            // using free_bulk_storage (see server::destroy)
             void free(void* p, std::size_t count)
             {
-                HPX_ASSERT(1 == count);
+                HPX_ASSERT(0 != count);
+                if (count != 1)
+                {
+                    HPX_VERIFY(free_bulk_storage(p, count));
+                    return;
+                }
                 ::operator delete(p);
             }
         };
@@ -64,13 +64,16 @@ namespace hpx { namespace components {
 
         /// \brief Construct an empty component
         component_base()
+          : bulk_created_(false)
         {
         }
 
         /// \brief Destruct a component
         ~component_base()
         {
-            if (gid_)
+            // instances created in bulk share one range of gids, which is
+            // unbound when their storage is released
+            if (gid_ && !bulk_created_)
             {
                 error_code ec;
                 agas::unbind(launch::sync, gid_, 1, ec);
@@ -79,6 +82,7 @@ namespace hpx { namespace components {
 
         // Copy construction and copy assignment should not copy the gid_.
         component_base(component_base const&)
+          : bulk_created_(false)
         {
         }
 
@@ -89,7 +93,7 @@ namespace hpx { namespace components {
 
         // just move our gid_
         component_base(component_base&& rhs)
-          : gid_(std::move(rhs.gid_))
+          : gid_(std::move(rhs.gid_)), bulk_created_(false)
         {
         }
 
@@ -106,6 +110,13 @@ namespace hpx { namespace components {
         {
         }
 
+        // Return whether this instance was created in bulk, its storage has
+        // to be released using detail::free_bulk_storage
+        bool is_bulk_created() const
+        {
+            return bulk_created_;
+        }
+
         naming::address get_current_address() const
         {
             return naming::address(get_locality(),
@@ -125,9 +136,22 @@ namespace hpx { namespace components {
             naming::gid_type const& gid, void** p, Ts&&...ts);
 
         template <typename Component_, typename...Ts>
-        friend std::vector<naming::gid_type> bulk_create(std::size_t count, Ts&&...ts);
+        friend std::vector<naming::gid_type> server::bulk_create(
+            std::size_t count, Ts&&...ts);
+
+        template <typename Component_>
+        friend struct server::detail::bulk_create_helper;
 #endif
 
+        // Assign a GID which has been bound in AGAS already as part of a
+        // range of GIDs (used for instances created in bulk)
+        void set_base_gid(naming::gid_type const& gid) const
+        {
+            HPX_ASSERT(!gid_);
+            gid_ = gid;
+            bulk_created_ = true;
+        }
+
         // Create a new GID (if called for the first time), assign this
         // GID to this instance of a component and register this gid
         // with the AGAS service
@@ -256,6 +280,7 @@ namespace hpx { namespace components {
 
     protected:
         mutable naming::gid_type gid_;
+        mutable bool bulk_created_;
     };
 }}
 
@@ -8,13 +8,25 @@
 #define HPX_COMPONENTS_SERVER_CREATE_COMPONENT_JUN_02_2008_0146PM
 
 #include <hpx/config.hpp>
+#include <hpx/lcos/local/latch.hpp>
+#include <hpx/runtime/applier/bind_naming_wrappers.hpp>
+#include <hpx/runtime/components/server/bulk_storage.hpp>
+#include <hpx/runtime/components/server/component.hpp>
+#include <hpx/runtime/components/server/component_base.hpp>
 #include <hpx/runtime/components/server/create_component_fwd.hpp>
 #include <hpx/runtime/components/server/component_heap.hpp>
 #include <hpx/runtime/components/component_type.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
 #include <hpx/runtime/naming/address.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/runtime_fwd.hpp>
 #include <hpx/throw_exception.hpp>
+#include <hpx/traits/component_supports_migration.hpp>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <sstream>
 #include <utility>
 #include <vector>
@@ -116,63 +128,291 @@ namespace hpx { namespace components { namespace server
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    /// Create count components and forward the passed parameters
+    /// Create a component which is not bound to any global id yet, this is
+    /// used to receive the state of an object which is being migrated while
+    /// the object still serves requests (see bind_precopied)
     template <typename Component, typename...Ts>
-    std::vector<naming::gid_type> bulk_create(std::size_t count, Ts&&...ts)
+    Component* create_precopied(Ts&&...ts)
     {
         component_type type = get_component_type<typename Component::wrapped_type>();
-        std::vector<naming::gid_type> gids;
         if(!enabled(type))
         {
             HPX_THROW_EXCEPTION(bad_request,
-                "components::server::bulk_create",
+                "components::server::create_precopied",
                 "the component is disabled for this locality (" +
                 get_component_type_name(type) + ")");
-            return gids;
+            return nullptr;
         }
 
-        gids.reserve(count);
+        void *storage = component_heap<Component>().alloc(1);
 
-        Component *storage =
-            static_cast<Component*>(component_heap<Component>().alloc(count));
-        Component *storage_it = storage;
-        std::size_t succeeded = 0;
         try
         {
-            // Call constructors and try to get the GID...
-            for (std::size_t i = 0; i != count; ++i, ++storage_it)
+            return new(storage) Component(std::forward<Ts>(ts)...);
+        }
+        catch(...)
+        {
+            component_heap<Component>().free(storage, 1);
+            throw;
+        }
+    }
+
+    /// Bind a component created by create_precopied to the global id of the
+    /// object it was copied from
+    template <typename Component>
+    naming::gid_type bind_precopied(Component* c, naming::gid_type const& gid)
+    {
+        naming::gid_type assigned_gid = c->get_base_gid(gid);
+        if (assigned_gid && assigned_gid == gid)
+        {
+            ++instance_count(
+                get_component_type<typename Component::wrapped_type>());
+            return gid;
+        }
+
+        c->finalize();
+        c->~Component();
+        component_heap<Component>().free(c, 1);
+
+        std::ostringstream strm;
+        strm << "global id " << gid <<
+            " is already bound to a different component instance";
+        HPX_THROW_EXCEPTION(hpx::duplicate_component_address,
+            "bind_precopied<Component>", strm.str());
+
+        return naming::invalid_gid;
+    }
+
+    /// Destroy a component created by create_precopied which was not bound
+    /// to a global id
+    template <typename Component>
+    void destroy_precopied(Component* c)
+    {
+        c->finalize();
+        c->~Component();
+        component_heap<Component>().free(c, 1);
+    }
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Construct count instances starting at the given storage, destroy
+        // the instances constructed so far if one of the constructors throws.
+        template <typename Component, typename...Ts>
+        void construct_range(Component* storage, std::size_t count,
+            Ts&...ts)
+        {
+            std::size_t i = 0;
+            try
+            {
+                for (/**/; i != count; ++i)
+                    new(storage + i) Component(ts...);
+            }
+            catch (...)
             {
-                Component* c = nullptr;
-                c = new(storage_it) Component(std::forward<Ts>(ts)...);
-                naming::gid_type gid = c->get_base_gid();
-                if (!gid)
+                while (i != 0)
                 {
-                    c->finalize();
-                    c->~Component();
-                    HPX_THROW_EXCEPTION(hpx::unknown_component_address,
-                        "bulk_create<Component>",
-                        "can't assign global id");
+                    --i;
+                    storage[i].finalize();
+                    storage[i].~Component();
                 }
-                gids.push_back(std::move(gid));
-                ++instance_count(type);
-                ++succeeded;
+                throw;
             }
         }
-        catch(...)
+
+        // Construct count instances, large numbers of instances are
+        // constructed concurrently on several HPX threads.
+        template <typename Component, typename...Ts>
+        void construct_bulk(Component* storage, std::size_t count, Ts&...ts)
         {
-            // If an exception wsa thrown, roll back
-            storage_it = storage;
-            for (std::size_t i = 0; i != succeeded; ++i, ++storage_it)
+            // minimal number of instances constructed by one HPX thread
+            std::size_t const min_chunk_size = 1024;
+
+            std::size_t num_chunks =
+                (std::min)(hpx::get_os_thread_count(), count / min_chunk_size);
+            if (num_chunks <= 1 || threads::get_self_ptr() == nullptr)
             {
-                storage_it->finalize();
-                storage_it->~Component();
-                --instance_count(type);
+                construct_range(storage, count, ts...);
+                return;
             }
-            component_heap<Component>().free(storage, count);
-            throw;
+
+            std::size_t const chunk_size = (count + num_chunks - 1) / num_chunks;
+            num_chunks = (count + chunk_size - 1) / chunk_size;
+
+            std::vector<std::exception_ptr> errors(num_chunks);
+            lcos::local::latch l(static_cast<std::ptrdiff_t>(num_chunks));
+
+            for (std::size_t i = 1; i != num_chunks; ++i)
+            {
+                threads::register_thread_nullary(
+                    [&, i]()
+                    {
+                        std::size_t const first = i * chunk_size;
+                        try {
+                            construct_range(storage + first,
+                                (std::min)(chunk_size, count - first), ts...);
+                        }
+                        catch (...) {
+                            errors[i] = std::current_exception();
+                        }
+                        l.count_down(1);
+                    },
+                    "components::server::bulk_create");
+            }
+
+            // the first chunk is handled by this thread
+            try {
+                construct_range(storage, chunk_size, ts...);
+            }
+            catch (...) {
+                errors[0] = std::current_exception();
+            }
+            l.count_down_and_wait();
+
+            std::exception_ptr error;
+            for (std::size_t i = 0; i != num_chunks && !error; ++i)
+                error = errors[i];
+
+            if (!error)
+                return;
+
+            // destroy all instances if one of the constructors has failed
+            for (std::size_t i = 0; i != num_chunks; ++i)
+            {
+                if (errors[i])
+                    continue;
+
+                std::size_t const first = i * chunk_size;
+                std::size_t const last = (std::min)(first + chunk_size, count);
+                for (std::size_t j = first; j != last; ++j)
+                {
+                    storage[j].finalize();
+                    storage[j].~Component();
+                }
+            }
+            std::rethrow_exception(error);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Component, typename...Ts>
+        std::vector<naming::gid_type>
+        create_one_by_one(std::size_t count, Ts&...ts)
+        {
+            std::vector<naming::gid_type> gids;
+            gids.reserve(count);
+            for (std::size_t i = 0; i != count; ++i)
+                gids.push_back(create<Component>(ts...));
+            return gids;
+        }
+
+        // By default the instances are created one by one
+        template <typename Component>
+        struct bulk_create_helper
+        {
+            template <typename...Ts>
+            static std::vector<naming::gid_type>
+            call(component_type, std::size_t count, Ts&...ts)
+            {
+                return create_one_by_one<Component>(count, ts...);
+            }
+        };
+
+        // Instances of components derived from component_base are placed
+        // next to each other into one block of storage. All of them are
+        // bound in AGAS as a single range of gids (the GVA of the range
+        // refers to the first instance, the offset is the size of one
+        // instance). Components supporting migration are bound one by one
+        // as they will have to be re-bound individually.
+        template <typename Component>
+        struct bulk_create_helper<component<Component> >
+        {
+            typedef component<Component> component_type;
+
+            template <typename...Ts>
+            static std::vector<naming::gid_type>
+            call(components::component_type type, std::size_t count, Ts&...ts)
+            {
+                if (count <= 1 ||
+                    traits::component_supports_migration<Component>::call())
+                {
+                    return create_one_by_one<component_type>(count, ts...);
+                }
+
+                typedef typename component_type::heap_type heap_type;
+                heap_type& heap = component_heap<component_type>();
+
+                component_type* storage =
+                    static_cast<component_type*>(heap.alloc(count));
+
+                try
+                {
+                    construct_bulk(storage, count, ts...);
+                }
+                catch (...)
+                {
+                    heap.free(storage, count);
+                    throw;
+                }
+
+                std::vector<naming::gid_type> gids;
+                try
+                {
+                    naming::gid_type const base_gid =
+                        hpx::detail::get_next_id(count);
+
+                    naming::address addr(get_locality(), type,
+                        reinterpret_cast<std::uint64_t>(storage));
+                    if (!applier::bind_range_local(
+                            base_gid, count, addr, sizeof(component_type)))
+                    {
+                        HPX_THROW_EXCEPTION(duplicate_component_address,
+                            "bulk_create<Component>",
+                            "failed to bind range of global ids");
+                    }
+                    components::detail::set_bulk_storage_gid(
+                        storage, base_gid);
+
+                    gids.reserve(count);
+                    for (std::size_t i = 0; i != count; ++i)
+                    {
+                        storage[i].set_base_gid(base_gid + i);
+                        gids.push_back(storage[i].get_base_gid());
+                    }
+                }
+                catch (...)
+                {
+                    for (std::size_t i = 0; i != count; ++i)
+                    {
+                        storage[i].finalize();
+                        storage[i].~component_type();
+                    }
+                    heap.free(storage, count);
+                    throw;
+                }
+
+                instance_count(type) += static_cast<long>(count);
+                return gids;
+            }
+        };
+
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Create count components and forward the passed parameters
+    template <typename Component, typename...Ts>
+    std::vector<naming::gid_type> bulk_create(std::size_t count, Ts&&...ts)
+    {
+        component_type type = get_component_type<typename Component::wrapped_type>();
+        if(!enabled(type))
+        {
+            HPX_THROW_EXCEPTION(bad_request,
+                "components::server::bulk_create",
+                "the component is disabled for this locality (" +
+                get_component_type_name(type) + ")");
+            return std::vector<naming::gid_type>();
         }
 
-        return gids;
+        return detail::bulk_create_helper<Component>::call(type, count, ts...);
     }
 }}}
 
@@ -31,6 +31,12 @@ namespace hpx { namespace components { namespace server
     template <typename Component, typename...Ts>
     std::vector<naming::gid_type> bulk_create(std::size_t count, Ts&&...ts);
 
+    namespace detail
+    {
+        template <typename Component>
+        struct bulk_create_helper;
+    }
+
     template <typename Component, typename...Ts>
     inline naming::gid_type construct(Ts&&...ts)
     {
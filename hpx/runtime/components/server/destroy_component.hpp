@@ -10,6 +10,7 @@
 #include <hpx/config.hpp>
 #include <hpx/error_code.hpp>
 #include <hpx/runtime_fwd.hpp>
+#include <hpx/runtime/components/server/bulk_storage.hpp>
 #include <hpx/runtime/components/server/component_heap.hpp>
 #include <hpx/runtime/naming/address.hpp>
 #include <hpx/runtime/naming/resolver_client.hpp>
@@ -56,9 +57,15 @@ namespace hpx { namespace components { namespace server
 
         // delete the local instances
         Component *c = reinterpret_cast<Component*>(addr.address_);
+        bool const bulk_created = components::detail::is_bulk_created(*c);
+
         c->finalize();
         c->~Component();
-        component_heap<Component>().free(c, 1);
+
+        if (bulk_created)
+            components::detail::free_bulk_storage(c, 1);
+        else
+            component_heap<Component>().free(c, 1);
     }
 
     template <typename Component>
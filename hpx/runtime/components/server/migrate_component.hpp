@@ -14,6 +14,8 @@
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/traits/component_supports_migration.hpp>
 #include <hpx/traits/is_component.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
 
 #include <cstdint>
 #include <memory>
@@ -105,6 +107,42 @@ namespace hpx { namespace components { namespace server
     //    of the object. Eventually this entry will have to be cleaned up no
     //    later than when the object is destroyed.
     //
+    // Any parcels which are routed to the object while it is being migrated
+    // (between `agas::begin_migration` and `agas::end_migration`) are held by
+    // AGAS, they are routed to the new location of the object as soon as the
+    // migration has finished.
+    //
+    // Live migration
+    // --------------
+    //
+    // The steps above make the object unavailable while its state is being
+    // serialized, transferred, and re-bound. Live migration (see
+    // `hpx::components::live_migrate()`) reduces this time by copying the
+    // state of the object to the target locality before step 1b, while the
+    // object still serves requests (pre-copy). The pre-copied instance is
+    // not bound to the global id of the object.
+    //
+    // Once the object has been marked as migrated, the migration proceeds as
+    // described above, except that step 3b binds the global id of the object
+    // to the pre-copied instance. The state of the object is copied again
+    // during this step only if the object was accessed after the pre-copy
+    // was started.
+    //
+    // Note that the component's serialization has to be safe to be executed
+    // concurrently with its actions for live migration to be usable.
+    // Components declare this by implementing a static member function
+    // `supports_live_migration()` returning true (see
+    // `traits::component_supports_live_migration`). All other components
+    // are migrated without pre-copying their state.
+    //
+    // A pre-copied instance which could not be bound is released using
+    // `runtime_support::discard_precopied_component`. This is done on every
+    // error path after the pre-copy has finished and is harmless if the
+    // instance was already released.
+    //
+    // The time during which objects are unavailable is exposed by the
+    // performance counter `/agas/time/migration/downtime`.
+    //
     ///////////////////////////////////////////////////////////////////////////
 
     ///////////////////////////////////////////////////////////////////////////
@@ -114,6 +152,41 @@ namespace hpx { namespace components { namespace server
     // to be migrated
     namespace detail
     {
+        // account for the time the object is not available, which starts
+        // when the object is marked as migrated (start) and ends once the
+        // migration has finished
+        inline future<id_type> report_migration_downtime(
+            future<id_type> && f, std::uint64_t start)
+        {
+            return f.then(
+                [start](future<id_type> && f) -> id_type
+                {
+                    id_type id = f.get();       // rethrow exceptions
+                    agas::report_migration_downtime(
+                        util::high_resolution_clock::now() - start);
+                    return id;
+                });
+        }
+
+        // release the pre-copied instance of an object if its live migration
+        // did not succeed
+        template <typename Component>
+        future<id_type> discard_precopied_on_error(future<id_type> && f,
+            id_type const& target, naming::address::address_type lva)
+        {
+            return f.then(
+                [target, lva](future<id_type> && f) -> id_type
+                {
+                    if (f.has_exception())
+                    {
+                        components::stubs::runtime_support::
+                            discard_precopied_component<Component>(
+                                target, lva);
+                    }
+                    return f.get();     // rethrow exceptions
+                });
+        }
+
         // clean up (source) memory of migrated object
         template <typename Component>
         id_type migrate_component_cleanup(
@@ -281,10 +354,15 @@ namespace hpx { namespace components { namespace server
                 [=](future<std::shared_ptr<Component> > && f) -> future<id_type>
                 {
                     future<void> trigger_migration;
+                    std::uint64_t start = 0;
 
                     {
                         std::shared_ptr<Component> ptr = f.get();
 
+                        // The object is not available anymore once it has
+                        // been marked as migrated.
+                        start = util::high_resolution_clock::now();
+
                         // Delay the start of the migration operation until no
                         // more actions (threads) are pending or currently
                         // running for the given object (until the object is
@@ -309,9 +387,11 @@ namespace hpx { namespace components { namespace server
                                         Component, DistPolicy
                                     > action_type;
 
-                                return async<action_type>(
-                                    naming::get_locality_from_id(to_migrate),
-                                    to_migrate, policy);
+                                return detail::report_migration_downtime(
+                                    async<action_type>(
+                                        naming::get_locality_from_id(to_migrate),
+                                        to_migrate, policy),
+                                    start);
                             });
                 });
     }
@@ -323,6 +403,249 @@ namespace hpx { namespace components { namespace server
           , &perform_migrate_component<Component, DistPolicy>
           , perform_migrate_component_action<Component, DistPolicy> >
     {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    // This is step 3 of the live migration process
+    //
+    // This will be executed on the locality where the object lives which is
+    // to be migrated. The object has been pre-copied to the target locality
+    // (lva is the address of the unbound copy).
+    template <typename Component>
+    future<id_type> migrate_precopied_component(
+        id_type const& to_migrate, naming::address const& addr,
+        id_type const& target, naming::address::address_type lva,
+        bool modified)
+    {
+        using components::stubs::runtime_support;
+
+        // retrieve pointer to object (must be local)
+        std::shared_ptr<Component> ptr =
+            hpx::detail::get_ptr_for_migration<Component>(addr, to_migrate);
+
+        // the pre-copied instance is discarded by the caller if this fails
+        std::uint32_t pin_count = ptr->pin_count();
+        if (pin_count == ~0x0u || pin_count > 1)
+        {
+            return hpx::make_exceptional_future<id_type>(
+                HPX_GET_EXCEPTION(invalid_status,
+                    "hpx::components::server::migrate_precopied_component",
+                    "attempting to migrate an instance of a component "
+                    "which was already migrated or which is currently "
+                    "pinned"));
+        }
+
+        // send the state of the object only if the pre-copied state is stale
+        std::shared_ptr<Component> state;
+        if (modified)
+            state = ptr;
+
+        return runtime_support::migrate_precopied_component_async<Component>(
+                    target, lva, state, to_migrate)
+            .then(util::bind(
+                &detail::migrate_component_cleanup<Component>,
+                util::placeholders::_1, ptr, to_migrate));
+    }
+
+    template <typename Component>
+    struct migrate_precopied_component_action
+      : ::hpx::actions::action<
+            future<id_type> (*)(id_type const&, naming::address const&,
+                id_type const&, naming::address::address_type, bool)
+          , &migrate_precopied_component<Component>
+          , migrate_precopied_component_action<Component> >
+    {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    // This is step 2 of the live migration process
+    //
+    // This is executed on the locality responsible for managing the address
+    // resolution for the given object.
+    template <typename Component>
+    future<id_type> trigger_migrate_precopied_component(
+        id_type const& to_migrate, id_type const& target,
+        naming::address::address_type lva, bool modified)
+    {
+        if (naming::get_locality_id_from_id(to_migrate) != get_locality_id())
+        {
+            return hpx::make_exceptional_future<id_type>(
+                HPX_GET_EXCEPTION(invalid_status,
+                    "hpx::components::server::"
+                        "trigger_migrate_precopied_component",
+                    "this function has to be executed on the locality "
+                    "responsible for managing the address of the given object"));
+        }
+
+        // the pre-copied instance is not bound to any global id, it has to be
+        // released if any of the steps below fails
+        return detail::discard_precopied_on_error<Component>(
+            agas::begin_migration(to_migrate)
+                .then(
+                    [=](future<std::pair<id_type, naming::address> > && f)
+                        -> future<id_type>
+                    {
+                        // rethrow errors
+                        std::pair<id_type, naming::address> r = f.get();
+
+                        // bind the pre-copied object
+                        typedef migrate_precopied_component_action<Component>
+                            action_type;
+                        return async<action_type>(r.first, to_migrate,
+                            r.second, target, lva, modified);
+                    })
+                .then(
+                    [to_migrate](future<id_type> && f) -> id_type
+                    {
+                        agas::end_migration(to_migrate).get();
+                        return f.get();
+                    }),
+            target, lva);
+    }
+
+    template <typename Component>
+    struct trigger_migrate_precopied_component_action
+      : ::hpx::actions::action<
+            future<id_type> (*)(id_type const&, id_type const&,
+                naming::address::address_type, bool)
+          , &trigger_migrate_precopied_component<Component>
+          , trigger_migrate_precopied_component_action<Component> >
+    {};
+
+    ///////////////////////////////////////////////////////////////////////////
+    // This is step 1 of the live migration process
+    //
+    // This is executed on the locality where the object to migrate is
+    // currently located.
+    template <typename Component, typename DistPolicy>
+    future<id_type> perform_live_migrate_component(
+        id_type const& to_migrate, DistPolicy const& policy)
+    {
+        using components::stubs::runtime_support;
+
+        if (!traits::component_supports_migration<Component>::call())
+        {
+            return hpx::make_exceptional_future<id_type>(
+                HPX_GET_EXCEPTION(invalid_status,
+                    "hpx::components::server::perform_live_migrate_component",
+                    "attempting to migrate an instance of a component which "
+                    "does not support migration"));
+        }
+
+        // Copying the state of an object while it is serving requests is
+        // safe only for components which explicitly allow for this, all
+        // others are migrated without pre-copying their state.
+        if (!traits::component_supports_live_migration<Component>::call())
+        {
+            return perform_migrate_component<Component>(to_migrate, policy);
+        }
+
+        // 'migration' to same locality as before is a no-op
+        id_type target = policy.get_next_target();
+        if (target == hpx::find_here())
+        {
+            return make_ready_future(to_migrate);
+        }
+
+        // retrieve pointer to object (must be local)
+        return hpx::get_ptr<Component>(to_migrate)
+            .then(
+                [=](future<std::shared_ptr<Component> > && f) -> future<id_type>
+                {
+                    std::shared_ptr<Component> ptr = f.get();
+
+                    // Copy the state of the object to the target locality
+                    // while it still serves requests. The token allows to
+                    // detect whether the object was accessed after this
+                    // point.
+                    std::uint64_t token = ptr->get_precopy_token();
+                    std::uint64_t start = util::high_resolution_clock::now();
+
+                    future<naming::address::address_type> precopied =
+                        runtime_support::precopy_component_async<Component>(
+                            target, ptr);
+
+                    return precopied.then(
+                        [=](future<naming::address::address_type> && f)
+                            mutable -> future<id_type>
+                        {
+                            // rethrow exceptions
+                            naming::address::address_type lva = f.get();
+
+                            future<void> trigger_migration;
+                            bool modified = true;
+                            std::uint64_t downtime_start = 0;
+
+                            try {
+                                std::shared_ptr<Component> p = std::move(ptr);
+
+                                // The object is not available anymore once it
+                                // has been marked as migrated.
+                                downtime_start =
+                                    util::high_resolution_clock::now();
+
+                                // Delay the final step of the migration until
+                                // no more actions (threads) are pending or
+                                // currently running for the given object.
+                                trigger_migration =
+                                    p->mark_as_migrated(to_migrate);
+
+                                // The object is not accessed anymore once it
+                                // has been marked as migrated.
+                                modified = p->was_modified_since(token);
+
+                                // Unpin the object, will trigger migration if
+                                // this is the only pin-count.
+                            }
+                            catch (...) {
+                                runtime_support::
+                                    discard_precopied_component<Component>(
+                                        target, lva);
+                                throw;
+                            }
+
+                            agas::report_migration_precopy(
+                                downtime_start - start, modified);
+
+                            return trigger_migration
+                                .then(
+                                    launch::async,  // run on separate thread
+                                    [=](future<void> && f) -> future<id_type>
+                                    {
+                                        if (f.has_exception())
+                                        {
+                                            runtime_support::
+                                                discard_precopied_component<
+                                                    Component>(target, lva);
+                                            f.get();    // rethrow exceptions
+                                        }
+
+                                        // now trigger 2nd step of migration
+                                        typedef
+                                            trigger_migrate_precopied_component_action<
+                                                Component
+                                            > action_type;
+
+                                        return detail::report_migration_downtime(
+                                            detail::discard_precopied_on_error<
+                                                Component>(
+                                                async<action_type>(
+                                                    naming::get_locality_from_id(
+                                                        to_migrate),
+                                                    to_migrate, target, lva,
+                                                    modified),
+                                                target, lva),
+                                            downtime_start);
+                                    });
+                        });
+                });
+    }
+
+    template <typename Component, typename DistPolicy>
+    struct perform_live_migrate_component_action
+      : ::hpx::actions::action<
+            future<id_type> (*)(id_type const&, DistPolicy const&)
+          , &perform_live_migrate_component<Component, DistPolicy>
+          , perform_live_migrate_component_action<Component, DistPolicy> >
+    {};
 }}}
 
 #endif
@@ -40,6 +40,7 @@ namespace hpx { namespace components
         migration_support(Arg &&... arg)
           : base_type(std::forward<Arg>(arg)...)
           , pin_count_(0)
+          , access_count_(0)
           , was_marked_for_migration_(false)
         {}
 
@@ -69,7 +70,10 @@ namespace hpx { namespace components
             std::lock_guard<mutex_type> l(mtx_);
             HPX_ASSERT(pin_count_ != ~0x0u);
             if (pin_count_ != ~0x0u)
+            {
                 ++pin_count_;
+                ++access_count_;
+            }
         }
         void unpin()
         {
@@ -115,6 +119,28 @@ namespace hpx { namespace components
             pin_count_ = ~0x0u;
         }
 
+        // Support for live migration: the state of the object is copied to
+        // its new location while the object is still serving requests. The
+        // object has to be copied again once it has stopped serving requests
+        // if it was accessed after the copy was started.
+        //
+        // Return a token identifying the current state of the object. The
+        // caller is expected to hold the only pin of the object, otherwise
+        // the returned token marks the object as modified.
+        std::uint64_t get_precopy_token() const
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            return (1 == pin_count_) ? access_count_ : ~0x0ull;
+        }
+
+        // Return whether the object was accessed since the given token was
+        // retrieved.
+        bool was_modified_since(std::uint64_t token) const
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            return token == ~0x0ull || token != access_count_;
+        }
+
         hpx::future<void> mark_as_migrated(hpx::id_type const& to_migrate)
         {
             // we need to first lock the AGAS migrated objects table, only then
@@ -201,6 +227,7 @@ namespace hpx { namespace components
     private:
         mutable mutex_type mtx_;
         std::uint32_t pin_count_;
+        std::uint64_t access_count_;
         hpx::lcos::local::promise<void> trigger_migration_;
         bool was_marked_for_migration_;
     };
@@ -143,6 +143,18 @@ namespace hpx { namespace components { namespace server
         naming::gid_type migrate_component_to_here(
             std::shared_ptr<Component> const& p, naming::id_type);
 
+        template <typename Component>
+        naming::address::address_type precopy_component_to_here(
+            std::shared_ptr<Component> const& p);
+
+        template <typename Component>
+        naming::gid_type migrate_precopied_component_to_here(
+            naming::address::address_type lva,
+            std::shared_ptr<Component> const& p, naming::id_type);
+
+        template <typename Component>
+        void discard_precopied_component(naming::address::address_type lva);
+
         /// \brief Action to create new memory block
         naming::gid_type create_memory_block(std::size_t count,
             hpx::actions::manage_object_action_base const& act);
@@ -385,6 +397,11 @@ namespace hpx { namespace components { namespace server
         std::list<startup_function_type> startup_functions_;
         std::list<shutdown_function_type> pre_shutdown_functions_;
         std::list<shutdown_function_type> shutdown_functions_;
+
+        // pre-copied instances which are not bound to a global id yet, an
+        // instance is removed once it is either bound or discarded
+        lcos::local::spinlock precopied_mtx_;
+        std::set<naming::address::address_type> precopied_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -447,15 +464,9 @@ namespace hpx { namespace components { namespace server
             components::get_component_type<
                 typename Component::wrapped_type>();
 
-
-        std::vector<naming::gid_type> ids;
-        ids.reserve(count);
-
         typedef typename Component::wrapping_type wrapping_type;
-        for (std::size_t i = 0; i != count; ++i)
-        {
-            ids.push_back(create<wrapping_type>());
-        }
+        std::vector<naming::gid_type> ids =
+            bulk_create<wrapping_type>(count);
 
         LRT_(info) << "successfully created " << count //-V128
                    << " component(s) of type: "
@@ -472,14 +483,9 @@ namespace hpx { namespace components { namespace server
             components::get_component_type<
                 typename Component::wrapped_type>();
 
-        std::vector<naming::gid_type> ids;
-        ids.reserve(count);
-
         typedef typename Component::wrapping_type wrapping_type;
-        for (std::size_t i = 0; i != count; ++i)
-        {
-            ids.push_back(create<wrapping_type>(v, vs...));
-        }
+        std::vector<naming::gid_type> ids =
+            bulk_create<wrapping_type>(count, v, vs...);
 
         LRT_(info) << "successfully created " << count //-V128
                    << " component(s) of type: "
@@ -567,6 +573,114 @@ namespace hpx { namespace components { namespace server
 
         return id;
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Create a local copy of the given object which is not bound to a global
+    // id yet, return its local virtual address
+    template <typename Component>
+    naming::address::address_type runtime_support::precopy_component_to_here(
+        std::shared_ptr<Component> const& p)
+    {
+        typedef typename Component::wrapping_type wrapping_type;
+        wrapping_type* new_instance =
+            create_precopied<wrapping_type>(std::move(*p));
+
+        naming::address::address_type lva =
+            reinterpret_cast<naming::address::address_type>(new_instance);
+
+        {
+            std::lock_guard<lcos::local::spinlock> l(precopied_mtx_);
+            precopied_.insert(lva);
+        }
+
+        LRT_(info) << "successfully pre-copied component of type: "
+            << components::get_component_type_name(
+                    components::get_component_type<
+                        typename Component::wrapped_type>())
+            << " to locality: " << find_here();
+
+        return lva;
+    }
+
+    // Finish the migration of an object which was pre-copied to this
+    // locality. The pre-copied instance is replaced if the object has been
+    // modified after it was pre-copied (p is not empty in this case).
+    template <typename Component>
+    naming::gid_type runtime_support::migrate_precopied_component_to_here(
+        naming::address::address_type lva,
+        std::shared_ptr<Component> const& p, naming::id_type to_migrate)
+    {
+        typedef typename Component::wrapping_type wrapping_type;
+        wrapping_type* precopied = reinterpret_cast<wrapping_type*>(lva);
+
+        bool found = false;
+        {
+            std::lock_guard<lcos::local::spinlock> l(precopied_mtx_);
+            found = precopied_.erase(lva) != 0;
+        }
+
+        if (!found)
+        {
+            HPX_THROW_EXCEPTION(hpx::invalid_status,
+                "runtime_support::migrate_precopied_component_to_here",
+                "the pre-copied component was already discarded");
+            return naming::invalid_gid;
+        }
+
+        if (p)
+        {
+            destroy_precopied(precopied);
+            return migrate_component_to_here(p, std::move(to_migrate));
+        }
+
+        naming::gid_type migrated_id = to_migrate.get_gid();
+        naming::gid_type id = bind_precopied(precopied, migrated_id);
+
+        // sanity checks
+        if (id != migrated_id)
+        {
+            // we should not get here (the ids should be the same)
+            HPX_THROW_EXCEPTION(hpx::invalid_status,
+                "runtime_support::migrate_precopied_component_to_here",
+                "could not bind pre-copied component (the new id is "
+                    "different from the original id)");
+            return naming::invalid_gid;
+        }
+
+        LRT_(info) << "successfully migrated pre-copied component " << id
+            << " of type: "
+            << components::get_component_type_name(
+                    components::get_component_type<
+                        typename Component::wrapped_type>())
+            << " to locality: " << find_here();
+
+        // inform the newly bound component that it has been migrated
+        typedef typename wrapping_type::derived_type derived_type;
+        static_cast<derived_type*>(precopied)->on_migrated();
+
+        // see migrate_component_to_here
+        agas::unmark_as_migrated(id);
+
+        to_migrate.make_unmanaged();
+
+        return id;
+    }
+
+    // Release a pre-copied instance if its migration could not be completed,
+    // this is a no-op if the instance was already bound or discarded
+    template <typename Component>
+    void runtime_support::discard_precopied_component(
+        naming::address::address_type lva)
+    {
+        {
+            std::lock_guard<lcos::local::spinlock> l(precopied_mtx_);
+            if (precopied_.erase(lva) == 0)
+                return;
+        }
+
+        typedef typename Component::wrapping_type wrapping_type;
+        destroy_precopied(reinterpret_cast<wrapping_type*>(lva));
+    }
 }}}
 
 #include <hpx/config/warnings_suffix.hpp>
@@ -710,6 +824,31 @@ namespace hpx { namespace components { namespace server
           , &runtime_support::migrate_component_to_here<Component>
           , migrate_component_here_action<Component> >
     {};
+
+    template <typename Component>
+    struct precopy_component_here_action
+      : ::hpx::actions::action<
+            naming::address::address_type (runtime_support::*)(
+                std::shared_ptr<Component> const&)
+          , &runtime_support::precopy_component_to_here<Component>
+          , precopy_component_here_action<Component> >
+    {};
+    template <typename Component>
+    struct migrate_precopied_component_here_action
+      : ::hpx::actions::action<
+            naming::gid_type (runtime_support::*)(
+                naming::address::address_type,
+                std::shared_ptr<Component> const&, naming::id_type)
+          , &runtime_support::migrate_precopied_component_to_here<Component>
+          , migrate_precopied_component_here_action<Component> >
+    {};
+    template <typename Component>
+    struct discard_precopied_component_action
+      : ::hpx::actions::action<
+            void (runtime_support::*)(naming::address::address_type)
+          , &runtime_support::discard_precopied_component<Component>
+          , discard_precopied_component_action<Component> >
+    {};
 }}}
 
 namespace hpx { namespace traits
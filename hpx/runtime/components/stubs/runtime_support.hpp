@@ -8,6 +8,7 @@
 #define HPX_COMPONENTS_STUBS_RUNTIME_SUPPORT_JUN_09_2008_0503PM
 
 #include <hpx/config.hpp>
+#include <hpx/apply.hpp>
 #include <hpx/async.hpp>
 #include <hpx/lcos/detail/async_colocated_fwd.hpp>
 #include <hpx/lcos/future.hpp>
@@ -228,6 +229,50 @@ namespace hpx { namespace components { namespace stubs
                 target, p, to_migrate).get();
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // copy the state of a component which is being migrated while it
+        // still serves requests, this returns the local virtual address of
+        // the (unbound) copy
+        template <typename Component>
+        static lcos::future<naming::address::address_type>
+        precopy_component_async(naming::id_type const& target_locality,
+            std::shared_ptr<Component> const& p)
+        {
+            typedef typename server::precopy_component_here_action<Component>
+                action_type;
+            return hpx::async<action_type>(target_locality, p);
+        }
+
+        // finish the migration of a pre-copied component, p refers to the
+        // current state of the object if it was modified after being
+        // pre-copied (p is empty otherwise)
+        template <typename Component>
+        static lcos::future<naming::id_type>
+        migrate_precopied_component_async(
+            naming::id_type const& target_locality,
+            naming::address::address_type lva,
+            std::shared_ptr<Component> const& p,
+            naming::id_type const& to_migrate)
+        {
+            typedef typename
+                server::migrate_precopied_component_here_action<Component>
+                action_type;
+            return hpx::async<action_type>(target_locality, lva, p,
+                to_migrate);
+        }
+
+        // release a pre-copied component if the migration has failed
+        template <typename Component>
+        static void discard_precopied_component(
+            naming::id_type const& target_locality,
+            naming::address::address_type lva)
+        {
+            typedef typename
+                server::discard_precopied_component_action<Component>
+                action_type;
+            hpx::apply<action_type>(target_locality, lva);
+        }
+
         ///////////////////////////////////////////////////////////////////////
         /// Create a new memory block using the runtime_support with the
         /// given \a targetgid. This is a non-blocking call. The caller needs
@@ -397,7 +397,9 @@ namespace hpx
         HPX_EXPORT static const detail::async_policy async;
 
         /// Predefined launch policy representing asynchronous execution.The
-        /// new thread is executed in a preferred way
+        /// new thread is executed in a preferred way: the launching thread
+        /// runs the new thread right away (work-first execution), while its
+        /// own continuation can be stolen by other worker threads.
         HPX_EXPORT static const detail::fork_policy fork;
 
         /// Predefined launch policy representing synchronous execution
@@ -16,8 +16,10 @@
 #include <hpx/runtime/parcelset/parcel.hpp>
 #include <hpx/runtime/parcelset/detail/parcel_route_handler.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/runtime_fwd.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/bind.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/util/logging.hpp>
 
@@ -158,7 +160,16 @@ namespace hpx { namespace parcelset
 
 #if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
                         performance_counters::parcels::data_point action_data;
-                        action_data.bytes_ = archive.current_pos() - archive_pos;
+                        action_data.raw_bytes_ =
+                            archive.current_pos() - archive_pos;
+                        // attribute the (possibly compressed) size of the
+                        // message to the parcels it holds
+                        action_data.bytes_ = inbound_data_size == 0 ?
+                            action_data.raw_bytes_ :
+                            static_cast<std::size_t>(
+                                double(action_data.raw_bytes_) *
+                                    static_cast<std::uint64_t>(buffer.size_) /
+                                    inbound_data_size);
                         action_data.serialization_time_ =
                             add_parcel_time - serialize_time;
                         action_data.num_parcels_ = 1;
@@ -281,42 +292,46 @@ namespace hpx { namespace parcelset
             parcel_count, chunks, num_thread);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Decode the received message either right away or on a new HPX worker
+    // thread. Large messages (which usually carry many coalesced parcels) are
+    // handed off, this frees the network thread for receiving the next
+    // message and allows for several messages to be decoded concurrently.
     template <typename Parcelport, typename Buffer>
-    void decode_parcel(Parcelport & parcelport, Buffer buffer, std::size_t num_thread)
+    void decode_message_async(Parcelport & parcelport, Buffer buffer,
+        std::size_t parcel_count, std::size_t num_thread)
     {
-//         if(hpx::is_running() && parcelport.async_serialization())
-//         {
-//             hpx::applier::register_thread_nullary(
-//                 util::bind(
-//                     util::one_shot(&decode_message<Parcelport, Buffer>),
-//                     std::ref(parcelport), std::move(buffer), 1, num_thread),
-//                 "decode_parcels",
-//                 threads::pending, true, threads::thread_priority_boost,
-//                 parcelport.get_next_num_thread());
-//         }
-//         else
+        std::size_t inbound_data_size = static_cast<std::size_t>(
+            static_cast<std::uint64_t>(buffer.data_size_));
+
+        if (parcelport.async_decode(inbound_data_size))
+        {
+            hpx::applier::register_thread_nullary(
+                util::bind(
+                    util::one_shot(&decode_message<Parcelport, Buffer>),
+                    std::ref(parcelport), std::move(buffer), parcel_count,
+                    num_thread),
+                "decode_parcels",
+                threads::pending, true, threads::thread_priority_boost,
+                num_thread, threads::thread_stacksize_default);
+        }
+        else
         {
-            decode_message(parcelport, std::move(buffer), 1, num_thread);
+            decode_message(parcelport, std::move(buffer), parcel_count,
+                num_thread);
         }
     }
 
+    template <typename Parcelport, typename Buffer>
+    void decode_parcel(Parcelport & parcelport, Buffer buffer, std::size_t num_thread)
+    {
+        decode_message_async(parcelport, std::move(buffer), 1, num_thread);
+    }
+
     template <typename Parcelport, typename Buffer>
     void decode_parcels(Parcelport & parcelport, Buffer buffer, std::size_t num_thread)
     {
-//         if(hpx::is_running() && parcelport.async_serialization())
-//         {
-//             hpx::applier::register_thread_nullary(
-//                 util::bind(
-//                     util::one_shot(&decode_message<Parcelport, Buffer>),
-//                     std::ref(parcelport), std::move(buffer), 0, num_thread),
-//                 "decode_parcels",
-//                 threads::pending, true, threads::thread_priority_boost,
-//                 parcelport.get_next_num_thread());
-//         }
-//         else
-        {
-            decode_message(parcelport, std::move(buffer), 0, num_thread);
-        }
+        decode_message_async(parcelport, std::move(buffer), 0, num_thread);
     }
 
 }}
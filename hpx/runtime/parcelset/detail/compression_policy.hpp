@@ -0,0 +1,77 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARCELSET_DETAIL_COMPRESSION_POLICY_HPP)
+#define HPX_PARCELSET_DETAIL_COMPRESSION_POLICY_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace hpx { namespace parcelset { namespace detail
+{
+    // Decides whether the serialization filter registered for an action is
+    // applied to an outgoing message. Messages smaller than the configured
+    // threshold are never compressed. For all other messages the achieved
+    // compression ratio is sampled per action, compression is disabled for
+    // an action if it does not shrink the data sufficiently. Once disabled,
+    // every sample_interval'th message of the action is compressed anyway
+    // to detect changes in the compressibility of its arguments.
+    class HPX_EXPORT compression_policy
+    {
+    private:
+        typedef hpx::lcos::local::spinlock mutex_type;
+
+        struct action_state
+        {
+            action_state()
+              : raw_bytes_(0), compressed_bytes_(0), num_samples_(0),
+                num_skipped_(0), disabled_(false)
+            {}
+
+            std::uint64_t raw_bytes_;
+            std::uint64_t compressed_bytes_;
+            std::uint32_t num_samples_;
+            std::uint32_t num_skipped_;
+            bool disabled_;
+        };
+
+        // number of messages the compression ratio is averaged over
+        static std::uint32_t const num_samples = 16;
+
+    public:
+        compression_policy(std::size_t threshold, double max_ratio,
+            std::size_t sample_interval);
+
+        // Messages smaller than this are never compressed
+        std::size_t threshold() const
+        {
+            return threshold_;
+        }
+
+        // Return whether a message of the given size holding parcels for
+        // the given action should be compressed. The action name is used
+        // as a key only, it has to be a string with static storage duration
+        // (as returned by base_action::get_action_name()).
+        bool use_compression(char const* action, std::size_t size);
+
+        // Record the outcome of compressing a message
+        void add_sample(char const* action, std::size_t raw_bytes,
+            std::size_t compressed_bytes);
+
+    private:
+        std::size_t const threshold_;
+        double const max_ratio_;
+        std::uint32_t const sample_interval_;
+
+        mutex_type mtx_;
+        std::unordered_map<char const*, action_state> data_;
+    };
+}}}
+
+#endif
@@ -0,0 +1,369 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARCELSET_DETAIL_OUTGOING_PARCEL_QUEUES_HPP)
+#define HPX_PARCELSET_DETAIL_OUTGOING_PARCEL_QUEUES_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/parcelset/parcel.hpp>
+#include <hpx/runtime/parcelset_fwd.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/function.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Unbounded multi-producer/single-consumer queue of the parcels (and
+    // their write handlers) waiting to be sent to one destination.
+    //
+    // Enqueuing is a single atomic exchange on the head of the list of
+    // nodes. Only one thread at a time may dequeue parcels, the consumer
+    // side is protected by a try-lock as any thread finding the queue busy
+    // can rely on the current consumer (or on the next round of background
+    // work) to pick up the parcels.
+    class outgoing_parcel_queue
+    {
+    private:
+        struct node
+        {
+            node()
+              : next_(nullptr)
+            {}
+
+            node(parcel&& p, write_handler_type&& f)
+              : parcel_(std::move(p)), handler_(std::move(f)), next_(nullptr)
+            {}
+
+            parcel parcel_;
+            write_handler_type handler_;
+            std::atomic<node*> next_;
+        };
+
+    public:
+        outgoing_parcel_queue(locality const& dest,
+                std::atomic<std::size_t>& num_active)
+          : destination_(dest), head_(new node), tail_(head_.load()),
+            size_(0), consumer_(false), num_active_(num_active),
+            next_in_bucket_(nullptr), next_queue_(nullptr)
+        {}
+
+        ~outgoing_parcel_queue()
+        {
+            node* n = tail_;
+            while (n != nullptr)
+            {
+                node* next = n->next_.load(std::memory_order_relaxed);
+                delete n;
+                n = next;
+            }
+        }
+
+        outgoing_parcel_queue(outgoing_parcel_queue const&) = delete;
+        outgoing_parcel_queue& operator=(outgoing_parcel_queue const&) = delete;
+
+        locality const& destination() const
+        {
+            return destination_;
+        }
+
+        // The number of parcels currently held, this includes parcels which
+        // are in the process of being enqueued.
+        std::size_t size() const
+        {
+            return size_.load(std::memory_order_acquire);
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // may be called concurrently by any number of threads
+        void push(parcel&& p, write_handler_type&& f)
+        {
+            node* n = new node(std::move(p), std::move(f));
+            add_size(1);
+            link(n, n);
+        }
+
+        void push(std::vector<parcel>&& parcels,
+            std::vector<write_handler_type>&& handlers)
+        {
+            HPX_ASSERT(parcels.size() == handlers.size());
+            if (parcels.empty())
+                return;
+
+            // build the list of new nodes first, then publish all of them
+            // at once
+            node* first = new node(std::move(parcels[0]), std::move(handlers[0]));
+            node* last = first;
+            for (std::size_t i = 1; i != parcels.size(); ++i)
+            {
+                node* n = new node(std::move(parcels[i]), std::move(handlers[i]));
+                last->next_.store(n, std::memory_order_relaxed);
+                last = n;
+            }
+
+            add_size(parcels.size());
+            link(first, last);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // acquire/release the right to dequeue parcels
+        bool try_lock()
+        {
+            return !consumer_.load(std::memory_order_relaxed) &&
+                !consumer_.exchange(true, std::memory_order_acquire);
+        }
+
+        void unlock()
+        {
+            consumer_.store(false, std::memory_order_release);
+        }
+
+        // The functions below may be invoked only while holding the consumer
+        // lock.
+        bool pop(parcel& p, write_handler_type& f)
+        {
+            node* tail = tail_;
+            node* next = tail->next_.load(std::memory_order_acquire);
+            if (next == nullptr)
+                return false;
+
+            // the dequeued node becomes the new (empty) tail
+            p = std::move(next->parcel_);
+            f = std::move(next->handler_);
+            tail_ = next;
+            delete tail;
+
+            remove_size(1);
+            return true;
+        }
+
+        // Move all parcels which are currently available to the given
+        // vectors, returns the number of dequeued parcels.
+        std::size_t pop_all(std::vector<parcel>& parcels,
+            std::vector<write_handler_type>& handlers)
+        {
+            HPX_ASSERT(parcels.size() == handlers.size());
+
+            // don't let producers keep the consumer busy forever
+            std::size_t const max_count = size();
+            parcels.reserve(parcels.size() + max_count);
+            handlers.reserve(handlers.size() + max_count);
+
+            std::size_t count = 0;
+            while (count != max_count)
+            {
+                node* next = tail_->next_.load(std::memory_order_acquire);
+                if (next == nullptr)
+                    break;
+
+                parcels.push_back(std::move(next->parcel_));
+                handlers.push_back(std::move(next->handler_));
+
+                delete tail_;
+                tail_ = next;
+                ++count;
+            }
+
+            if (count != 0)
+                remove_size(count);
+            return count;
+        }
+
+    private:
+        friend class outgoing_parcel_queues;
+
+        void link(node* first, node* last)
+        {
+            node* prev = head_.exchange(last, std::memory_order_acq_rel);
+            prev->next_.store(first, std::memory_order_release);
+        }
+
+        // keep track of the number of non-empty queues, this touches the
+        // shared counter only if the queue changes between being empty and
+        // non-empty
+        void add_size(std::size_t count)
+        {
+            if (size_.fetch_add(count, std::memory_order_acq_rel) == 0)
+                ++num_active_;
+        }
+
+        void remove_size(std::size_t count)
+        {
+            std::size_t size = size_.fetch_sub(count, std::memory_order_acq_rel);
+            HPX_ASSERT(size >= count);
+            if (size == count)
+            {
+                HPX_ASSERT(num_active_.load() != 0);
+                --num_active_;
+            }
+        }
+
+        locality const destination_;
+
+        std::atomic<node*> head_;           // producers enqueue here
+        node* tail_;                        // consumer dequeues here
+        std::atomic<std::size_t> size_;
+        std::atomic<bool> consumer_;
+        std::atomic<std::size_t>& num_active_;
+
+        // links used by outgoing_parcel_queues, both are set before the
+        // queue is published and stay unchanged afterwards
+        outgoing_parcel_queue* next_in_bucket_;
+        outgoing_parcel_queue* next_queue_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Concurrent hash map from a destination to its outgoing_parcel_queue.
+    //
+    // Queues are inserted into the buckets using a CAS on the bucket head
+    // and are never removed before the map is destroyed (the number of
+    // destinations is bounded by the number of localities), thus looking
+    // up a queue does not require any synchronization beyond an acquire
+    // load. Senders contend only if they target the same destination.
+    class outgoing_parcel_queues
+    {
+    public:
+        explicit outgoing_parcel_queues(std::size_t num_buckets = 256)
+          : num_buckets_(round_up_to_power_of_2(num_buckets)),
+            buckets_(new std::atomic<outgoing_parcel_queue*>[num_buckets_]),
+            queues_(nullptr), num_active_(0)
+        {
+            for (std::size_t i = 0; i != num_buckets_; ++i)
+                buckets_[i].store(nullptr, std::memory_order_relaxed);
+        }
+
+        ~outgoing_parcel_queues()
+        {
+            outgoing_parcel_queue* q = queues_.load(std::memory_order_acquire);
+            while (q != nullptr)
+            {
+                outgoing_parcel_queue* next = q->next_queue_;
+                delete q;
+                q = next;
+            }
+        }
+
+        outgoing_parcel_queues(outgoing_parcel_queues const&) = delete;
+        outgoing_parcel_queues& operator=(outgoing_parcel_queues const&) = delete;
+
+        // Return the queue for the given destination, nullptr if there is
+        // none yet
+        outgoing_parcel_queue* find(locality const& dest) const
+        {
+            return find_in_bucket(
+                bucket(dest).load(std::memory_order_acquire), dest);
+        }
+
+        // Return the queue for the given destination, create it if needed
+        outgoing_parcel_queue& get(locality const& dest)
+        {
+            std::atomic<outgoing_parcel_queue*>& b = bucket(dest);
+
+            outgoing_parcel_queue* head = b.load(std::memory_order_acquire);
+            if (outgoing_parcel_queue* q = find_in_bucket(head, dest))
+                return *q;
+
+            std::unique_ptr<outgoing_parcel_queue> q(
+                new outgoing_parcel_queue(dest, num_active_));
+            do
+            {
+                q->next_in_bucket_ = head;
+                if (b.compare_exchange_weak(head, q.get(),
+                        std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    break;
+                }
+
+                // somebody else has modified the bucket, it might have
+                // inserted the same destination
+                if (outgoing_parcel_queue* other = find_in_bucket(head, dest))
+                    return *other;
+
+            } while (true);
+
+            // add the new queue to the list of all queues
+            outgoing_parcel_queue* p = q.release();
+            outgoing_parcel_queue* first =
+                queues_.load(std::memory_order_relaxed);
+            do
+            {
+                p->next_queue_ = first;
+            } while (!queues_.compare_exchange_weak(first, p,
+                std::memory_order_release, std::memory_order_relaxed));
+
+            return *p;
+        }
+
+        // Iterate over all queues (the queues stay valid as long as this
+        // object is alive)
+        outgoing_parcel_queue* front() const
+        {
+            return queues_.load(std::memory_order_acquire);
+        }
+
+        static outgoing_parcel_queue* next(outgoing_parcel_queue const* q)
+        {
+            return q->next_queue_;
+        }
+
+        // Return the number of queues currently holding parcels
+        std::size_t num_active() const
+        {
+            return num_active_.load(std::memory_order_relaxed);
+        }
+
+        // Return the overall number of parcels held by all queues
+        std::size_t size() const
+        {
+            std::size_t count = 0;
+            for (outgoing_parcel_queue* q = front(); q != nullptr; q = next(q))
+                count += q->size();
+            return count;
+        }
+
+    private:
+        static std::size_t round_up_to_power_of_2(std::size_t n)
+        {
+            std::size_t result = 1;
+            while (result < n)
+                result <<= 1;
+            return result;
+        }
+
+        std::atomic<outgoing_parcel_queue*>& bucket(locality const& dest) const
+        {
+            return buckets_[hash_value(dest) & (num_buckets_ - 1)];
+        }
+
+        static outgoing_parcel_queue* find_in_bucket(
+            outgoing_parcel_queue* q, locality const& dest)
+        {
+            for (/**/; q != nullptr; q = q->next_in_bucket_)
+            {
+                if (q->destination_ == dest)
+                    return q;
+            }
+            return nullptr;
+        }
+
+        std::size_t const num_buckets_;
+        std::unique_ptr<std::atomic<outgoing_parcel_queue*>[]> buckets_;
+        std::atomic<outgoing_parcel_queue*> queues_;
+        std::atomic<std::size_t> num_active_;
+    };
+}}}
+
+#endif
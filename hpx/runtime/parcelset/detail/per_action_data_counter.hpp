@@ -44,6 +44,10 @@ namespace hpx { namespace parcelset { namespace detail
         std::int64_t total_bytes(
             std::string const& action, bool reset);
 
+        // total data managed, uncompressed (bytes)
+        std::int64_t total_raw_bytes(
+            std::string const& action, bool reset);
+
     private:
         typedef std::unordered_map<
                 std::string, performance_counters::parcels::gatherer_nolock,
@@ -32,6 +32,7 @@
 #include <exception>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace hpx
@@ -149,14 +150,6 @@ namespace hpx
             // guard against serialization errors
             try {
                 try {
-                    std::unique_ptr<serialization::binary_filter> filter(
-                        ps[0].get_serialization_filter());
-
-                    int archive_flags = archive_flags_;
-                    if (filter.get() != nullptr)
-                        archive_flags |= serialization::enable_compression;
-
-
                     // preallocate data
                     for (/**/; parcels_sent != parcels_size; ++parcels_sent)
                     {
@@ -166,6 +159,30 @@ namespace hpx
                         num_chunks += ps[parcels_sent].num_chunks();
                     }
 
+                    // apply the serialization filter only if the message is
+                    // large enough and compression has paid off for the
+                    // action before
+                    detail::compression_policy& policy =
+                        pp.get_compression_policy();
+
+                    std::unique_ptr<serialization::binary_filter> filter;
+                    char const* filter_action = nullptr;
+                    if (arg_size >= policy.threshold())
+                    {
+                        filter.reset(ps[0].get_serialization_filter());
+                        if (filter.get() != nullptr)
+                        {
+                            filter_action =
+                                ps[0].get_action()->get_action_name();
+                            if (!policy.use_compression(filter_action, arg_size))
+                                filter.reset();
+                        }
+                    }
+
+                    int archive_flags = archive_flags_;
+                    if (filter.get() != nullptr)
+                        archive_flags |= serialization::enable_compression;
+
                     buffer.data_.reserve(arg_size);
 
                     buffer.chunks_.reserve(num_chunks);
@@ -173,6 +190,16 @@ namespace hpx
                     // mark start of serialization
                     util::high_resolution_timer timer;
 
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+                    // the per-action data is reported once the compressed
+                    // size of the message is known
+                    std::vector<std::pair<
+                            char const*, performance_counters::parcels::data_point
+                        > > action_data;
+                    action_data.reserve(parcels_sent);
+                    std::int64_t compression_time = 0;
+#endif
+
                     {
                         // Serialize the data
                         if (filter.get() != nullptr)
@@ -200,20 +227,54 @@ namespace hpx
                             archive << ps[i];
 
 #if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
-                            performance_counters::parcels::data_point action_data;
-                            action_data.bytes_ = archive.current_pos() - archive_pos;
-                            action_data.serialization_time_ =
+                            performance_counters::parcels::data_point data;
+                            data.bytes_ = archive.current_pos() - archive_pos;
+                            data.raw_bytes_ = data.bytes_;
+                            data.serialization_time_ =
                                 timer.elapsed_nanoseconds() - serialize_time;
-                            action_data.num_parcels_ = 1;
-                            pp.add_sent_data(
-                                ps[i].get_action()->get_action_name(),
-                                action_data);
+                            data.num_parcels_ = 1;
+                            action_data.push_back(std::make_pair(
+                                ps[i].get_action()->get_action_name(), data));
 #endif
                         }
+
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+                        std::int64_t flush_time = timer.elapsed_nanoseconds();
+#endif
                         archive.flush();
                         arg_size = archive.bytes_written();
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+                        compression_time =
+                            timer.elapsed_nanoseconds() - flush_time;
+#endif
+                    }
+
+                    if (filter.get() != nullptr)
+                    {
+                        policy.add_sample(
+                            filter_action, arg_size, buffer.data_.size());
                     }
 
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+                    // attribute the compressed size of the message and the
+                    // time spent compressing to the parcels it holds
+                    for (auto& p : action_data)
+                    {
+                        performance_counters::parcels::data_point& data =
+                            p.second;
+                        if (filter.get() != nullptr && arg_size != 0)
+                        {
+                            double share = double(data.raw_bytes_) / arg_size;
+                            data.bytes_ = static_cast<std::size_t>(
+                                share * buffer.data_.size());
+                            data.serialization_time_ +=
+                                static_cast<std::int64_t>(
+                                    share * compression_time);
+                        }
+                        pp.add_sent_data(p.first, data);
+                    }
+#endif
+
                     // store the time required for serialization
                     buffer.data_point_.serialization_time_ =
                         timer.elapsed_nanoseconds();
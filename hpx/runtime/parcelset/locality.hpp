@@ -17,6 +17,7 @@
 #include <hpx/traits/is_iterator.hpp>
 #include <hpx/util/assert.hpp>
 
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <string>
@@ -28,6 +29,17 @@
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace parcelset
 {
+    namespace detail
+    {
+        // fallback for parcelport specific locality types which do not
+        // provide a hash function, all of those end up with the same hash
+        template <typename Impl>
+        std::size_t hash_value(Impl const&)
+        {
+            return 0;
+        }
+    }
+
     class HPX_EXPORT locality
     {
         template <typename Impl>
@@ -40,6 +52,7 @@ namespace hpx { namespace parcelset
 
             virtual bool equal(impl_base const & rhs) const = 0;
             virtual bool less_than(impl_base const & rhs) const = 0;
+            virtual std::size_t hash() const = 0;
             virtual bool valid() const = 0;
             virtual const char *type() const = 0;
             virtual std::ostream & print(std::ostream & os) const = 0;
@@ -164,6 +177,11 @@ namespace hpx { namespace parcelset
             return lhs.impl_->less_than(*rhs.impl_);
         }
 
+        friend std::size_t hash_value(locality const& l)
+        {
+            return l.impl_ ? l.impl_->hash() : 0;
+        }
+
         friend bool operator> (locality const& lhs, locality const& rhs)
         {
             if(lhs.impl_ == rhs.impl_) return false;
@@ -207,6 +225,12 @@ namespace hpx { namespace parcelset
                     (type() == rhs.type() && impl_ < rhs.get<Impl>());
             }
 
+            std::size_t hash() const
+            {
+                using detail::hash_value;
+                return hash_value(impl_);
+            }
+
             bool valid() const
             {
                 return !!impl_;
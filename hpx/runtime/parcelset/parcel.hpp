@@ -16,12 +16,12 @@
 #include <hpx/runtime/naming/address.hpp>
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/runtime/parcelset_fwd.hpp>
+#include <hpx/runtime/serialization/detail/flat_hash_map.hpp>
 #include <hpx/runtime/serialization/serialization_fwd.hpp>
 #include <hpx/traits/is_bitwise_serializable.hpp>
 
 #include <cstddef>
 #include <cstdint>
-#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -72,8 +72,9 @@ namespace hpx { namespace parcelset
     private:
 
         typedef
-            std::map<const naming::gid_type*, naming::gid_type>
-            split_gids_type;
+            serialization::detail::flat_hash_map<
+                const naming::gid_type*, naming::gid_type
+            > split_gids_type;
 
 #if defined(HPX_DEBUG)
         bool is_valid() const;
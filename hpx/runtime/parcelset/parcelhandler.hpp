@@ -120,6 +120,10 @@ namespace hpx { namespace parcelset
         bool do_background_work(std::size_t num_thread = 0,
             bool stop_buffering = false);
 
+        /// \brief Return whether any of the parcelports has operations in
+        ///        flight which complete only if background work is done
+        bool has_pending_background_work();
+
         /// \brief Allow access to AGAS resolver instance.
         ///
         /// This accessor returns a reference to the AGAS resolver client
@@ -400,12 +404,29 @@ namespace hpx { namespace parcelset
         // total data received (bytes)
         std::int64_t get_action_data_received(std::string const& pp_type,
             std::string const& action, bool reset) const;
+
+        // total data (uncompressed) sent (bytes)
+        std::int64_t get_action_raw_data_sent(std::string const& pp_type,
+            std::string const& action, bool reset) const;
+
+        // total data (uncompressed) received (bytes)
+        std::int64_t get_action_raw_data_received(std::string const& pp_type,
+            std::string const& action, bool reset) const;
 #endif
 
         //
         std::int64_t get_connection_cache_statistics(std::string const& pp_type,
             parcelport::connection_cache_statistics_type stat_type, bool) const;
 
+        std::int64_t get_receive_buffer_pool_statistics(
+            std::string const& pp_type,
+            parcelport::receive_buffer_pool_statistics_type stat_type,
+            bool) const;
+
+        // decode statistics
+        std::int64_t get_decode_statistics(std::string const& pp_type,
+            parcelport::decode_statistics_type stat_type, bool) const;
+
         void list_parcelports(std::ostringstream& strm) const;
         void list_parcelport(std::ostringstream& strm,
             std::string const& ppname, int priority, bool bootstrap) const;
@@ -443,6 +464,9 @@ namespace hpx { namespace parcelset
 
         void register_counter_types(std::string const& pp_type);
         void register_connection_cache_counter_types(std::string const& pp_type);
+        void register_receive_buffer_pool_counter_types(
+            std::string const& pp_type);
+        void register_decode_counter_types(std::string const& pp_type);
 
     private:
         int get_priority(std::string const& name) const
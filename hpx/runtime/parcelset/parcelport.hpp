@@ -15,6 +15,8 @@
 #include <hpx/performance_counters/parcels/data_point.hpp>
 #include <hpx/performance_counters/parcels/gatherer.hpp>
 #include <hpx/runtime/applier_fwd.hpp>
+#include <hpx/runtime/parcelset/detail/compression_policy.hpp>
+#include <hpx/runtime/parcelset/detail/outgoing_parcel_queues.hpp>
 #include <hpx/runtime/parcelset/detail/per_action_data_counter.hpp>
 #include <hpx/runtime/parcelset/locality.hpp>
 #include <hpx/runtime/parcelset/parcel.hpp>
@@ -174,10 +176,44 @@ namespace hpx { namespace parcelset
         // invoke pending background work
         virtual bool do_background_work(std::size_t num_thread) = 0;
 
+        // return whether operations are in flight which make progress only
+        // if background work is invoked
+        virtual bool has_pending_background_work()
+        {
+            return false;
+        }
+
         // retrieve performance counter value for given statistics type
         virtual std::int64_t get_connection_cache_statistics(
             connection_cache_statistics_type, bool reset) = 0;
 
+        /// Return the given receive buffer pool statistic
+        enum receive_buffer_pool_statistics_type
+        {
+            receive_buffer_pool_hits = 0,
+            receive_buffer_pool_misses = 1,
+            receive_buffer_pool_bytes_retained = 2
+        };
+
+        // retrieve performance counter value for given statistics type, the
+        // default is for parcelports which do not pool their receive buffers
+        virtual std::int64_t get_receive_buffer_pool_statistics(
+            receive_buffer_pool_statistics_type, bool reset)
+        {
+            return 0;
+        }
+
+        /// Return the given decode statistic
+        enum decode_statistics_type
+        {
+            decode_inline = 0,
+            decode_offloaded = 1
+        };
+
+        // retrieve performance counter value for given statistics type
+        std::int64_t get_decode_statistics(
+            decode_statistics_type stat_type, bool reset);
+
         /// Return the name of this locality
         virtual std::string get_locality_name() const = 0;
 
@@ -270,6 +306,14 @@ namespace hpx { namespace parcelset
         // total data received (bytes)
         std::int64_t get_action_data_received(
             std::string const&, bool reset);
+
+        // total data (uncompressed) sent (bytes)
+        std::int64_t get_action_raw_data_sent(
+            std::string const&, bool reset);
+
+        // total data (uncompressed) received (bytes)
+        std::int64_t get_action_raw_data_received(
+            std::string const&, bool reset);
 #endif
 
         ///////////////////////////////////////////////////////////////////////
@@ -326,6 +370,18 @@ namespace hpx { namespace parcelset
             return async_serialization_;
         }
 
+        /// Decide whether a received message holding the given number of
+        /// (uncompressed) bytes should be decoded on a HPX worker thread
+        /// instead of the thread which received it, record the decision
+        bool async_decode(std::size_t inbound_data_size);
+
+        /// Return the policy deciding whether outgoing messages are
+        /// compressed
+        detail::compression_policy& get_compression_policy()
+        {
+            return compression_policy_;
+        }
+
         // callback while bootstrap the parcel layer
         void early_pending_parcel_handler(boost::system::error_code const& ec,
             parcel const & p);
@@ -336,17 +392,8 @@ namespace hpx { namespace parcelset
 
         hpx::applier::applier *applier_;
 
-        /// The cache for pending parcels
-        typedef util::tuple<
-            std::vector<parcel>
-          , std::vector<write_handler_type>
-        > map_second_type;
-        typedef std::map<locality, map_second_type> pending_parcels_map;
-        pending_parcels_map pending_parcels_;
-
-        typedef std::set<locality> pending_parcels_destinations;
-        pending_parcels_destinations parcel_destinations_;
-        std::atomic<std::uint32_t> num_parcel_destinations_;
+        /// The queues of pending parcels, one for each destination
+        detail::outgoing_parcel_queues pending_parcels_;
 
         /// The local locality
         locality here_;
@@ -375,6 +422,15 @@ namespace hpx { namespace parcelset
         /// async serialization of parcels
         bool async_serialization_;
 
+        /// received messages of at least this size are decoded on a HPX
+        /// worker thread
+        std::size_t async_decode_threshold_;
+        std::atomic<std::int64_t> decodes_inline_;
+        std::atomic<std::int64_t> decodes_offloaded_;
+
+        /// decides whether outgoing messages are compressed
+        detail::compression_policy compression_policy_;
+
         /// priority of the parcelport
         int priority_;
         std::string type_;
@@ -299,6 +299,19 @@ namespace hpx { namespace parcelset
             return do_background_work_impl<ConnectionHandler>(num_thread);
         }
 
+        bool has_pending_background_work()
+        {
+            // parcels waiting for a connection are sent from background work,
+            // parcelports relying on being polled complete their operations
+            // in background work as well
+            if (get_pending_parcels_count(false) != 0)
+                return true;
+
+            return connection_handler_traits<
+                    ConnectionHandler
+                >::do_background_work::value && operations_in_flight_ != 0;
+        }
+
         /// support enable_shared_from_this
         std::shared_ptr<parcelport_impl> shared_from_this()
         {
@@ -613,132 +626,55 @@ namespace hpx { namespace parcelset
         void enqueue_parcel(locality const& locality_id,
             parcel&& p, write_handler_type&& f)
         {
-            typedef pending_parcels_map::mapped_type mapped_type;
-
-            std::unique_lock<lcos::local::spinlock> l(mtx_);
-            // We ignore the lock here. It might happen that while enqueuing,
-            // we need to acquire a lock. This should not cause any problems
-            // (famous last words)
-            util::ignore_while_checking<
-                std::unique_lock<lcos::local::spinlock>
-            > il(&l);
-
-            mapped_type& e = pending_parcels_[locality_id];
-            util::get<0>(e).push_back(std::move(p));
-            util::get<1>(e).push_back(std::move(f));
-
-            parcel_destinations_.insert(locality_id);
-            ++num_parcel_destinations_;
+            pending_parcels_.get(locality_id).push(std::move(p), std::move(f));
         }
 
         void enqueue_parcels(locality const& locality_id,
             std::vector<parcel>&& parcels,
             std::vector<write_handler_type>&& handlers)
         {
-            typedef pending_parcels_map::mapped_type mapped_type;
-
-            std::unique_lock<lcos::local::spinlock> l(mtx_);
-            // We ignore the lock here. It might happen that while enqueuing,
-            // we need to acquire a lock. This should not cause any problems
-            // (famous last words)
-            util::ignore_while_checking<
-                std::unique_lock<lcos::local::spinlock>
-            > il(&l);
-
             HPX_ASSERT(parcels.size() == handlers.size());
 
-            mapped_type& e = pending_parcels_[locality_id];
-            if (util::get<0>(e).empty())
-            {
-                HPX_ASSERT(util::get<1>(e).empty());
-                std::swap(util::get<0>(e), parcels);
-                std::swap(util::get<1>(e), handlers);
-            }
-            else
-            {
-                HPX_ASSERT(util::get<0>(e).size() == util::get<1>(e).size());
-                std::size_t new_size = util::get<0>(e).size() + parcels.size();
-                util::get<0>(e).reserve(new_size);
-
-                std::move(parcels.begin(), parcels.end(),
-                    std::back_inserter(util::get<0>(e)));
-                util::get<1>(e).reserve(new_size);
-                std::move(handlers.begin(), handlers.end(),
-                    std::back_inserter(util::get<1>(e)));
-            }
-
-            parcel_destinations_.insert(locality_id);
-            ++num_parcel_destinations_;
+            pending_parcels_.get(locality_id).push(
+                std::move(parcels), std::move(handlers));
         }
 
         bool dequeue_parcels(locality const& locality_id,
             std::vector<parcel>& parcels,
             std::vector<write_handler_type>& handlers)
         {
-            typedef pending_parcels_map::iterator iterator;
-
-            {
-                std::unique_lock<lcos::local::spinlock> l(mtx_, std::try_to_lock);
-
-                if (!l) return false;
-
-                iterator it = pending_parcels_.find(locality_id);
-
-                // do nothing if parcels have already been picked up by
-                // another thread
-                if (it != pending_parcels_.end() && !util::get<0>(it->second).empty())
-                {
-                    HPX_ASSERT(it->first == locality_id);
-                    HPX_ASSERT(handlers.size() == 0);
-                    HPX_ASSERT(handlers.size() == parcels.size());
-                    std::swap(parcels, util::get<0>(it->second));
-                    HPX_ASSERT(util::get<0>(it->second).size() == 0);
-                    std::swap(handlers, util::get<1>(it->second));
-                    HPX_ASSERT(handlers.size() == parcels.size());
-
-                    HPX_ASSERT(!handlers.empty());
-                }
-                else
-                {
-                    HPX_ASSERT(util::get<1>(it->second).empty());
-                    return false;
-                }
+            HPX_ASSERT(handlers.size() == 0);
+            HPX_ASSERT(handlers.size() == parcels.size());
 
-                parcel_destinations_.erase(locality_id);
+            // do nothing if parcels have already been picked up by
+            // another thread
+            detail::outgoing_parcel_queue* q =
+                pending_parcels_.find(locality_id);
+            if (q == nullptr || q->empty())
+                return false;
 
-                HPX_ASSERT(0 != num_parcel_destinations_.load());
-                --num_parcel_destinations_;
+            std::unique_lock<detail::outgoing_parcel_queue> l(
+                *q, std::try_to_lock);
+            if (!l) return false;
 
-                return true;
-            }
+            return q->pop_all(parcels, handlers) != 0;
         }
 
     protected:
         bool dequeue_parcel(locality& dest, parcel& p, write_handler_type& handler)
         {
+            for (detail::outgoing_parcel_queue* q = pending_parcels_.front();
+                 q != nullptr; q = pending_parcels_.next(q))
             {
-                std::unique_lock<lcos::local::spinlock> l(mtx_, std::try_to_lock);
+                if (q->empty())
+                    continue;
 
-                if (!l) return false;
-
-                for (auto &pending: pending_parcels_)
+                std::unique_lock<detail::outgoing_parcel_queue> l(
+                    *q, std::try_to_lock);
+                if (l && q->pop(p, handler))
                 {
-                    auto &parcels = util::get<0>(pending.second);
-                    if (!parcels.empty())
-                    {
-                        auto& handlers = util::get<1>(pending.second);
-                        dest = pending.first;
-                        p = std::move(parcels.back());
-                        parcels.pop_back();
-                        handler = std::move(handlers.back());
-                        handlers.pop_back();
-
-                        if (parcels.empty())
-                        {
-                            pending_parcels_.erase(dest);
-                        }
-                        return true;
-                    }
+                    dest = q->destination();
+                    return true;
                 }
             }
             return false;
@@ -746,31 +682,17 @@ namespace hpx { namespace parcelset
 
         bool trigger_pending_work()
         {
-            if (0 == num_parcel_destinations_.load(std::memory_order_relaxed))
+            if (0 == pending_parcels_.num_active())
                 return true;
 
-            std::vector<locality> destinations;
-
-            {
-                std::unique_lock<lcos::local::spinlock> l(mtx_, std::try_to_lock);
-                if(l.owns_lock())
-                {
-                    if (parcel_destinations_.empty())
-                        return true;
-
-                    destinations.reserve(parcel_destinations_.size());
-                    for (locality const& loc : parcel_destinations_)
-                    {
-                        destinations.push_back(loc);
-                    }
-                }
-            }
-
             // Create new HPX threads which send the parcels that are still
-            // pending.
-            for (locality const& loc : destinations)
+            // pending. The queues (and their destinations) stay alive as
+            // long as this parcelport exists.
+            for (detail::outgoing_parcel_queue* q = pending_parcels_.front();
+                 q != nullptr; q = pending_parcels_.next(q))
             {
-                get_connection_and_send_parcels(loc);
+                if (!q->empty())
+                    get_connection_and_send_parcels(q->destination());
             }
 
             return true;
@@ -856,14 +778,12 @@ namespace hpx { namespace parcelset
                 // remove this connection from cache
                 connection_cache_.clear(locality_id, sender_connection);
             }
-            {
-                std::lock_guard<lcos::local::spinlock> l(mtx_);
 
-//                HPX_ASSERT(locality_id == sender_connection->destination());
-                pending_parcels_map::iterator it = pending_parcels_.find(locality_id);
-                if (it == pending_parcels_.end() || util::get<0>(it->second).empty())
-                    return;
-            }
+//            HPX_ASSERT(locality_id == sender_connection->destination());
+            detail::outgoing_parcel_queue* q =
+                pending_parcels_.find(locality_id);
+            if (q == nullptr || q->empty())
+                return;
 
             // Create a new HPX thread which sends parcels that are still
             // pending.
@@ -0,0 +1,146 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_RECEIVE_BUFFER_POOL_HPP
+#define HPX_PARCELSET_RECEIVE_BUFFER_POOL_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace parcelset
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The receive_buffer_pool keeps the memory of the buffers received
+    /// messages are read into for reuse by later messages. Requests are
+    /// rounded up to the next power of two (size class) and served from the
+    /// free list of that size class, if possible. The overall amount of
+    /// memory retained in the free lists is bounded, requests larger than
+    /// the largest size class are never pooled.
+    class HPX_EXPORT receive_buffer_pool
+    {
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+        // size classes are 2^min_size_class ... 2^max_size_class bytes
+        static std::size_t const min_size_class = 6;       // 64 bytes
+        static std::size_t const max_size_class = 22;      // 4 MBytes
+        static std::size_t const num_size_classes =
+            max_size_class - min_size_class + 1;
+
+        struct free_list
+        {
+            mutex_type mtx_;
+            std::vector<void*> blocks_;
+        };
+
+    public:
+        HPX_NON_COPYABLE(receive_buffer_pool);
+
+    public:
+        explicit receive_buffer_pool(std::size_t max_retained_bytes);
+        ~receive_buffer_pool();
+
+        /// Allocate a block of (at least) the given number of bytes
+        void* allocate(std::size_t size);
+
+        /// Hand a block back, size has to be the same as was passed to
+        /// allocate()
+        void deallocate(void* p, std::size_t size);
+
+        /// Release all retained memory
+        void clear();
+
+        // performance counter data
+        std::int64_t get_hits(bool reset);
+        std::int64_t get_misses(bool reset);
+        std::int64_t get_bytes_retained(bool reset) const;
+
+    private:
+        static std::size_t size_class(std::size_t size);
+
+        std::size_t const max_retained_bytes_;
+        std::atomic<std::size_t> retained_bytes_;
+
+        std::atomic<std::int64_t> hits_;
+        std::atomic<std::int64_t> misses_;
+
+        free_list free_lists_[num_size_classes];
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Allocator drawing its memory from a receive_buffer_pool, falls back to
+    /// std::allocator if no pool is given. The pool travels with the
+    /// containers on move and swap, which allows for the buffers to be
+    /// handed off for decoding and released on any thread.
+    template <typename T>
+    struct receive_buffer_allocator
+    {
+        typedef T value_type;
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type propagate_on_container_swap;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef receive_buffer_allocator<U> other;
+        };
+
+        receive_buffer_allocator(receive_buffer_pool* pool = nullptr) noexcept
+          : pool_(pool)
+        {}
+
+        template <typename U>
+        receive_buffer_allocator(
+                receive_buffer_allocator<U> const& rhs) noexcept
+          : pool_(rhs.pool_)
+        {}
+
+        T* allocate(std::size_t n)
+        {
+            if (pool_ == nullptr)
+                return std::allocator<T>().allocate(n);
+            return static_cast<T*>(pool_->allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t n)
+        {
+            if (pool_ == nullptr)
+                std::allocator<T>().deallocate(p, n);
+            else
+                pool_->deallocate(p, n * sizeof(T));
+        }
+
+        friend bool operator==(receive_buffer_allocator const& lhs,
+            receive_buffer_allocator const& rhs) noexcept
+        {
+            return lhs.pool_ == rhs.pool_;
+        }
+
+        friend bool operator!=(receive_buffer_allocator const& lhs,
+            receive_buffer_allocator const& rhs) noexcept
+        {
+            return lhs.pool_ != rhs.pool_;
+        }
+
+        receive_buffer_pool* pool_;
+    };
+
+    /// The buffer type used for pooled receive buffers
+    typedef std::vector<char, receive_buffer_allocator<char> >
+        pooled_receive_buffer;
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -42,6 +42,7 @@ namespace hpx {
             error_code& ec = throws);
 
         HPX_API_EXPORT bool do_background_work(std::size_t num_thread = 0);
+        HPX_API_EXPORT bool has_pending_background_work();
 
         typedef util::function_nonser<
             void(boost::system::error_code const&, parcel const&)
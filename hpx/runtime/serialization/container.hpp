@@ -12,9 +12,11 @@
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/runtime/serialization/basic_archive.hpp>
 #include <hpx/runtime/serialization/binary_filter.hpp>
+#include <hpx/runtime/serialization/serialization_chunk.hpp>
 #include <hpx/util/assert.hpp>
 
 #include <cstddef>
+#include <vector>
 
 namespace hpx { namespace serialization
 {
@@ -46,6 +48,8 @@ namespace hpx { namespace serialization
         virtual void set_filter(binary_filter* filter) = 0;
         virtual void load_binary(void * address, std::size_t count) = 0;
         virtual void load_binary_chunk(void * address, std::size_t count) = 0;
+        virtual void reset(std::size_t inbound_data_size,
+            std::vector<serialization_chunk> const* chunks) = 0;
     };
 }}
 
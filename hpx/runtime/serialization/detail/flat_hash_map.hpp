@@ -0,0 +1,189 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_SERIALIZATION_DETAIL_FLAT_HASH_MAP_HPP
+#define HPX_SERIALIZATION_DETAIL_FLAT_HASH_MAP_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace serialization { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Open addressing (linear probing) hash table used by the archives for
+    // tracking pointers and split gids. Most archives track no or only very
+    // few entries, thus the table does not allocate any memory before the
+    // first insertion. Clearing the table keeps the allocated memory, which
+    // allows for archives to be reused without reallocating.
+    template <typename Key, typename T, typename Hash = std::hash<Key> >
+    class flat_hash_map
+    {
+    private:
+        static std::size_t const initial_capacity = 16;
+
+        struct slot
+        {
+            slot() : key_(), value_(), used_(false) {}
+
+            Key key_;
+            T value_;
+            bool used_;
+        };
+
+    public:
+        flat_hash_map()
+          : size_(0)
+        {}
+
+        flat_hash_map(flat_hash_map const& rhs) = default;
+        flat_hash_map& operator=(flat_hash_map const& rhs) = default;
+
+        flat_hash_map(flat_hash_map && rhs)
+          : slots_(std::move(rhs.slots_)), size_(rhs.size_)
+        {
+            rhs.size_ = 0;
+        }
+
+        flat_hash_map& operator=(flat_hash_map && rhs)
+        {
+            slots_ = std::move(rhs.slots_);
+            size_ = rhs.size_;
+            rhs.size_ = 0;
+            return *this;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        bool empty() const
+        {
+            return size_ == 0;
+        }
+
+        // Return a pointer to the value stored for the given key, nullptr if
+        // the key is not in the table
+        T* find(Key const& key)
+        {
+            if (size_ == 0)
+                return nullptr;
+
+            std::size_t const mask = slots_.size() - 1;
+            for (std::size_t i = index(key); /**/; i = (i + 1) & mask)
+            {
+                slot& s = slots_[i];
+                if (!s.used_)
+                    return nullptr;
+                if (s.key_ == key)
+                    return &s.value_;
+            }
+        }
+
+        T const* find(Key const& key) const
+        {
+            return const_cast<flat_hash_map&>(*this).find(key);
+        }
+
+        // Insert the given value if the key is not in the table yet. Returns
+        // the stored value and whether the insertion took place.
+        std::pair<T*, bool> insert(Key const& key, T value)
+        {
+            if (2 * (size_ + 1) > slots_.size())
+                grow();
+
+            slot& s = lookup(key);
+            if (s.used_)
+                return std::make_pair(&s.value_, false);
+
+            s.key_ = key;
+            s.value_ = std::move(value);
+            s.used_ = true;
+            ++size_;
+
+            return std::make_pair(&s.value_, true);
+        }
+
+        T& operator[](Key const& key)
+        {
+            return *insert(key, T()).first;
+        }
+
+        // Remove all entries, but keep the allocated memory
+        void clear()
+        {
+            if (size_ == 0)
+                return;
+
+            for (slot& s : slots_)
+            {
+                if (s.used_)
+                {
+                    s.value_ = T();
+                    s.used_ = false;
+                }
+            }
+            size_ = 0;
+        }
+
+        void swap(flat_hash_map& rhs)
+        {
+            std::swap(slots_, rhs.slots_);
+            std::swap(size_, rhs.size_);
+        }
+
+    private:
+        // Fibonacci hashing spreads the (usually aligned) pointer values
+        // and small integers over the table
+        std::size_t index(Key const& key) const
+        {
+            std::uint64_t h = static_cast<std::uint64_t>(Hash()(key));
+            h *= 0x9e3779b97f4a7c15ull;
+            return static_cast<std::size_t>(h >> 32) & (slots_.size() - 1);
+        }
+
+        slot& lookup(Key const& key)
+        {
+            std::size_t const mask = slots_.size() - 1;
+            for (std::size_t i = index(key); /**/; i = (i + 1) & mask)
+            {
+                slot& s = slots_[i];
+                if (!s.used_ || s.key_ == key)
+                    return s;
+            }
+        }
+
+        void grow()
+        {
+            std::vector<slot> slots(
+                slots_.empty() ? initial_capacity : 2 * slots_.size());
+            std::swap(slots, slots_);
+
+            for (slot& s : slots)
+            {
+                if (s.used_)
+                {
+                    slot& dest = lookup(s.key_);
+                    HPX_ASSERT(!dest.used_);
+
+                    dest.key_ = s.key_;
+                    dest.value_ = std::move(s.value_);
+                    dest.used_ = true;
+                }
+            }
+        }
+
+        std::vector<slot> slots_;
+        std::size_t size_;
+    };
+}}}
+
+#endif
@@ -14,6 +14,7 @@
 #include <hpx/runtime/naming_fwd.hpp>
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/runtime/serialization/binary_filter.hpp>
+#include <hpx/runtime/serialization/detail/flat_hash_map.hpp>
 #include <hpx/lcos/future.hpp>
 #include <hpx/lcos/local/promise.hpp>
 #include <hpx/lcos/local/spinlock.hpp>
@@ -21,7 +22,6 @@
 #include <hpx/util/assert.hpp>
 
 #include <cstddef>
-#include <map>
 #include <mutex>
 #include <type_traits>
 #include <utility>
@@ -33,7 +33,8 @@ namespace hpx { namespace serialization { namespace detail
         typedef hpx::lcos::local::spinlock mutex_type;
 
     public:
-        typedef std::map<const naming::gid_type*, naming::gid_type> split_gids_map;
+        typedef flat_hash_map<const naming::gid_type*, naming::gid_type>
+            split_gids_map;
         preprocess()
           : size_(0)
           , done_(false)
@@ -87,7 +88,7 @@ namespace hpx { namespace serialization { namespace detail
         bool has_gid(naming::gid_type const & gid)
         {
             std::lock_guard<mutex_type> l(mtx_);
-            return split_gids_.find(&gid) != split_gids_.end();
+            return split_gids_.find(&gid) != nullptr;
         }
 
         void reset()
@@ -97,6 +98,7 @@ namespace hpx { namespace serialization { namespace detail
             num_futures_ = 0;
             triggered_futures_ = 0;
             promise_ = hpx::lcos::local::promise<void>();
+            split_gids_.clear();
         }
 
         bool has_futures()
@@ -11,6 +11,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/runtime/serialization/basic_archive.hpp>
+#include <hpx/runtime/serialization/detail/flat_hash_map.hpp>
 #include <hpx/runtime/serialization/detail/polymorphic_nonintrusive_factory.hpp>
 #include <hpx/runtime/serialization/detail/raw_ptr.hpp>
 #include <hpx/runtime/serialization/input_container.hpp>
@@ -21,7 +22,6 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <map>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -37,7 +37,7 @@ namespace hpx { namespace serialization
         typedef basic_archive<input_archive> base_type;
 
         typedef
-            std::map<std::uint64_t, detail::ptr_helper_ptr>
+            detail::flat_hash_map<std::uint64_t, detail::ptr_helper_ptr>
             pointer_tracker;
 
         template <typename Container>
@@ -47,30 +47,20 @@ namespace hpx { namespace serialization
           : base_type(0U)
           , buffer_(new input_container<Container>(buffer, chunks, inbound_data_size))
         {
-            // endianness needs to be saves separately as it is needed to
-            // properly interpret the flags
-
-            // FIXME: make bool once integer compression is implemented
-            std::uint64_t endianess = 0ul;
-            load(endianess);
-            if (endianess)
-                this->base_type::flags_ = hpx::serialization::endian_big;
-
-            // load flags sent by the other end to make sure both ends have
-            // the same assumptions about the archive format
-            std::uint32_t flags = 0;
-            load(flags);
-            this->base_type::flags_ = flags;
+            load_header();
+        }
 
-            bool has_filter = false;
-            load(has_filter);
+        // Prepare this archive for reading the next message from the same
+        // container. The memory allocated for tracking pointers is kept.
+        void reset(std::size_t inbound_data_size = 0,
+            const std::vector<serialization_chunk>* chunks = nullptr)
+        {
+            buffer_->reset(inbound_data_size, chunks);
+            pointer_tracker_.clear();
+            this->base_type::flags_ = 0U;
+            this->base_type::reset();
 
-            serialization::binary_filter* filter = nullptr;
-            if (has_filter && enable_compression())
-            {
-                *this >> detail::raw_ptr(filter);
-                buffer_->set_filter(filter);
-            }
+            load_header();
         }
 
         template <typename T>
@@ -263,21 +253,46 @@ namespace hpx { namespace serialization
                 std::uint64_t pos, detail::ptr_helper_ptr helper)
         {
             pointer_tracker& tracker = ar.pointer_tracker_;
-            HPX_ASSERT(tracker.find(pos) == tracker.end());
+            HPX_ASSERT(tracker.find(pos) == nullptr);
 
-            tracker.insert(std::make_pair(pos, std::move(helper)));
+            tracker.insert(pos, std::move(helper));
         }
 
         template <typename Helper>
         friend Helper & tracked_pointer(input_archive& ar, std::uint64_t pos)
         {
-            // gcc has some lookup problems when using
-            // nested type inside friend function
-            std::map<std::uint64_t, detail::ptr_helper_ptr>::iterator
-                it = ar.pointer_tracker_.find(pos);
-            HPX_ASSERT(it != ar.pointer_tracker_.end());
+            detail::ptr_helper_ptr* helper = ar.pointer_tracker_.find(pos);
+            HPX_ASSERT(helper != nullptr);
+
+            return static_cast<Helper &>(**helper);
+        }
 
-            return static_cast<Helper &>(*it->second);
+        void load_header()
+        {
+            // endianness needs to be saves separately as it is needed to
+            // properly interpret the flags
+
+            // FIXME: make bool once integer compression is implemented
+            std::uint64_t endianess = 0ul;
+            load(endianess);
+            if (endianess)
+                this->base_type::flags_ = hpx::serialization::endian_big;
+
+            // load flags sent by the other end to make sure both ends have
+            // the same assumptions about the archive format
+            std::uint32_t flags = 0;
+            load(flags);
+            this->base_type::flags_ = flags;
+
+            bool has_filter = false;
+            load(has_filter);
+
+            serialization::binary_filter* filter = nullptr;
+            if (has_filter && enable_compression())
+            {
+                *this >> detail::raw_ptr(filter);
+                buffer_->set_filter(filter);
+            }
         }
 
         std::unique_ptr<erased_input_container> buffer_;
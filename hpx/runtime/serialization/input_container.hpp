@@ -72,6 +72,23 @@ namespace hpx { namespace serialization
             }
         }
 
+        void reset(std::size_t inbound_data_size,
+            std::vector<serialization_chunk> const* chunks) // override
+        {
+            current_ = 0;
+            filter_.reset();
+            decompressed_size_ = inbound_data_size;
+
+            chunks_ = nullptr;
+            current_chunk_ = std::size_t(-1);
+            current_chunk_size_ = 0;
+            if (chunks && chunks->size() != 0)
+            {
+                chunks_ = chunks;
+                current_chunk_ = 0;
+            }
+        }
+
         void set_filter(binary_filter* filter) // override
         {
             filter_.reset(filter);
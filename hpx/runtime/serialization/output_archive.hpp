@@ -12,6 +12,7 @@
 #include <hpx/config.hpp>
 #include <hpx/runtime/naming_fwd.hpp>
 #include <hpx/runtime/serialization/basic_archive.hpp>
+#include <hpx/runtime/serialization/detail/flat_hash_map.hpp>
 #include <hpx/runtime/serialization/detail/polymorphic_nonintrusive_factory.hpp>
 #include <hpx/runtime/serialization/detail/raw_ptr.hpp>
 #include <hpx/runtime/serialization/output_container.hpp>
@@ -26,7 +27,6 @@
 #include <cstddef>
 #include <cstdint>
 #include <list>
-#include <map>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -114,7 +114,8 @@ namespace hpx { namespace serialization
     public:
         typedef basic_archive<output_archive> base_type;
 
-        typedef std::map<const naming::gid_type*, naming::gid_type> split_gids_type;
+        typedef detail::flat_hash_map<const naming::gid_type*, naming::gid_type>
+            split_gids_type;
 
         template <typename Container>
         output_archive(Container & buffer,
@@ -125,26 +126,9 @@ namespace hpx { namespace serialization
           , buffer_(detail::create_output_container(buffer, chunks, filter,
                 typename traits::serialization_access_data<Container>::
                     preprocessing_only()))
+          , split_gids_(nullptr)
         {
-            // endianness needs to be saves separately as it is needed to
-            // properly interpret the flags
-
-            // FIXME: make bool once integer compression is implemented
-            std::uint64_t endianess = this->base_type::endian_big() ? ~0ul : 0ul;
-            save(endianess);
-
-            // send flags sent by the other end to make sure both ends have
-            // the same assumptions about the archive format
-            save(this->flags_);
-
-            bool has_filter = filter != nullptr;
-            save(has_filter);
-
-            if (has_filter && enable_compression())
-            {
-                *this << detail::raw_ptr(filter);
-                buffer_->set_filter(filter);
-            }
+            save_header(filter);
         }
 
         void set_split_gids(split_gids_type& split_gids)
@@ -187,11 +171,18 @@ namespace hpx { namespace serialization
             return basic_archive<output_archive>::current_pos();
         }
 
+        // Prepare this archive for writing the next message into the same
+        // container (and chunk list). The memory allocated by the container
+        // and for tracking pointers is kept. A filter the archive was
+        // constructed with is not applied to the next message.
         void reset()
         {
             buffer_->reset();
             pointer_tracker_.clear();
+            split_gids_ = nullptr;
             basic_archive<output_archive>::reset();
+
+            save_header(nullptr);
         }
 
         void flush()
@@ -371,20 +362,40 @@ namespace hpx { namespace serialization
             }
         }
 
-        typedef std::map<const void *, std::uint64_t> pointer_tracker;
+        typedef detail::flat_hash_map<const void *, std::uint64_t>
+            pointer_tracker;
 
         // FIXME: make this function capable for ADL lookup and hence if used
         // as a dependent name it doesn't require output_archive to be complete
         // type or itself to be forwarded
         friend std::uint64_t track_pointer(output_archive& ar, const void* pos)
         {
-            pointer_tracker::iterator it = ar.pointer_tracker_.find(pos);
-            if(it == ar.pointer_tracker_.end())
+            std::pair<std::uint64_t*, bool> p =
+                ar.pointer_tracker_.insert(pos, ar.size_);
+            return p.second ? npos : *p.first;
+        }
+
+        void save_header(binary_filter* filter)
+        {
+            // endianness needs to be saves separately as it is needed to
+            // properly interpret the flags
+
+            // FIXME: make bool once integer compression is implemented
+            std::uint64_t endianess = this->base_type::endian_big() ? ~0ul : 0ul;
+            save(endianess);
+
+            // send flags sent by the other end to make sure both ends have
+            // the same assumptions about the archive format
+            save(this->flags_);
+
+            bool has_filter = filter != nullptr;
+            save(has_filter);
+
+            if (has_filter && enable_compression())
             {
-                ar.pointer_tracker_.insert(std::make_pair(pos, ar.size_));
-                return npos;
+                *this << detail::raw_ptr(filter);
+                buffer_->set_filter(filter);
             }
-            return it->second;
         }
 
         std::unique_ptr<erased_output_container> buffer_;
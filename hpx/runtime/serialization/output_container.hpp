@@ -217,6 +217,7 @@ namespace hpx { namespace serialization
 
         void reset()
         {
+            current_ = 0;
             chunker_.reset();
             access_traits::reset(cont_);
         }
@@ -306,6 +307,13 @@ namespace hpx { namespace serialization
 
         void flush()
         {
+            // the filter is not set if the archive was reset
+            if (filter_ == nullptr)
+            {
+                this->base_type::flush();
+                return;
+            }
+
             std::size_t written = 0;
 
             if (access_traits::size(this->cont_) < this->current_)
@@ -332,6 +340,13 @@ namespace hpx { namespace serialization
             access_traits::resize(this->cont_, this->current_);
         }
 
+        void reset()
+        {
+            start_compressing_at_ = 0;
+            filter_ = nullptr;
+            this->base_type::reset();
+        }
+
         void set_filter(binary_filter* filter) // override
         {
             HPX_ASSERT(nullptr == filter_ && filter != nullptr);
@@ -345,14 +360,24 @@ namespace hpx { namespace serialization
         {
             HPX_ASSERT(count != 0);
 
-            // during construction the filter may not have been set yet
-            if (filter_ != nullptr)
-                filter_->save(address, count);
+            // during construction the filter may not have been set yet (the
+            // archive header is written uncompressed), the same is true after
+            // the archive was reset
+            if (filter_ == nullptr)
+            {
+                this->base_type::save_binary(address, count);
+                return;
+            }
+
+            filter_->save(address, count);
             this->current_ += count;
         }
 
         std::size_t save_binary_chunk(void const* address, std::size_t count) // override
         {
+            if (filter_ == nullptr)
+                return this->base_type::save_binary_chunk(address, count);
+
             if (count < HPX_ZERO_COPY_SERIALIZATION_THRESHOLD)
             {
                 // fall back to serialization_chunk-less archive
@@ -311,6 +311,13 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
             return m_state == ctx_exited;
         }
 
+        // Returns true if this context does not own a stack. Stackless
+        // coroutines run to completion on the stack of the invoking thread.
+        bool is_stackless() const
+        {
+            return this->get_stacksize() == HPX_NOSTACK_STACK_SIZE;
+        }
+
         // Resume coroutine.
         // Pre:  The coroutine must be ready.
         // Post: The coroutine relinquished control. It might be ready, waiting
@@ -423,6 +430,15 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
             HPX_ASSERT(is_ready());
             if (m_exit_state < ctx_exit_pending)
                 m_exit_state = ctx_exit_pending;
+
+            // there is no context to switch to for stackless coroutines
+            if (is_stackless())
+            {
+                m_state = ctx_exited;
+                m_exit_status = ctx_exited_exit;
+                return;
+            }
+
             do_invoke();
             HPX_ASSERT(exited()); // at this point the coroutine MUST have exited.
         }
@@ -230,8 +230,13 @@ namespace hpx { namespace threads { namespace coroutines
                     (stack_size == -1) ?
                     alloc_.minimum_stacksize() : std::size_t(stack_size)
                 )
-              , stack_pointer_(alloc_.allocate(stack_size_))
+              , stack_pointer_(stack_size_ == HPX_NOSTACK_STACK_SIZE ?
+                    nullptr : alloc_.allocate(stack_size_))
             {
+                // stackless threads run on the stack of the invoking thread
+                if (stack_pointer_ == nullptr)
+                    return;
+
 #if BOOST_VERSION < 105600
                 boost::context::fcontext_t* ctx =
                     boost::context::make_fcontext(stack_pointer_, stack_size_, funp_);
@@ -191,6 +191,13 @@ namespace hpx { namespace threads { namespace coroutines
                   : stack_size),
                 m_stack(nullptr)
             {
+                // stackless threads run on the stack of the invoking thread
+                if (m_stack_size == HPX_NOSTACK_STACK_SIZE)
+                {
+                    m_sp = nullptr;
+                    return;
+                }
+
                 if (0 != (m_stack_size % EXEC_PAGESIZE))
                 {
                     throw std::runtime_error(
@@ -199,6 +199,8 @@ namespace hpx { namespace threads { namespace coroutines
             template<typename Functor>
             explicit fibers_context_impl(Functor& cb, std::ptrdiff_t stack_size)
               : fibers_context_impl_base(
+                    // stackless threads run on the fiber of the invoking thread
+                    stack_size == HPX_NOSTACK_STACK_SIZE ? 0 :
                     CreateFiberEx(stack_size == -1 ? default_stack_size : stack_size,
                         stack_size == -1 ? default_stack_size : stack_size, 0,
                         static_cast<LPFIBER_START_ROUTINE>(&trampoline<Functor>),
@@ -206,7 +208,7 @@ namespace hpx { namespace threads { namespace coroutines
                     ),
                 stacksize_(stack_size == -1 ? default_stack_size : stack_size)
             {
-                if (0 == m_ctx)
+                if (0 == m_ctx && stacksize_ != HPX_NOSTACK_STACK_SIZE)
                 {
                     throw boost::system::system_error(
                         boost::system::error_code(
@@ -123,6 +123,12 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
         HPX_EXPORT void operator()();
 
+        // Run the bound function of a stackless coroutine directly on the
+        // stack of the calling thread.
+        // Pre:  The coroutine must be stackless and ready.
+        // Post: The coroutine has exited.
+        HPX_EXPORT void invoke_stackless();
+
     public:
         result_type * result()
         {
@@ -33,6 +33,7 @@
 #include <hpx/runtime/threads/coroutines/detail/coroutine_accessor.hpp>
 #include <hpx/runtime/threads/coroutines/detail/coroutine_impl.hpp>
 #include <hpx/runtime/threads/thread_enums.hpp>
+#include <hpx/throw_exception.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/function.hpp>
 
@@ -90,6 +91,22 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         {
             HPX_ASSERT(m_pimpl);
 
+            // A stackless thread can't give up control, it has to run to
+            // completion. Plain yields (as used by spinning locks) are
+            // turned into no-ops, everything else is an error.
+            if (this->m_pimpl->is_stackless())
+            {
+                if (arg.first != threads::pending || arg.second != nullptr)
+                {
+                    HPX_THROW_EXCEPTION(invalid_status,
+                        "coroutine_self::yield_impl",
+                        "stackless threads can't be suspended, use an "
+                        "executor or launch policy creating threads with a "
+                        "stack instead");
+                }
+                return wait_signaled;
+            }
+
             this->m_pimpl->bind_result(&arg);
 
             {
@@ -140,6 +157,12 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
             return m_pimpl->pending() != 0;
         }
 
+        bool is_stackless() const
+        {
+            HPX_ASSERT(m_pimpl);
+            return m_pimpl->is_stackless();
+        }
+
         thread_id_repr_type get_thread_id() const
         {
             HPX_ASSERT(m_pimpl);
@@ -159,6 +182,9 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         std::ptrdiff_t get_available_stack_space()
         {
 #if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
+            // stackless threads run on the (large) stack of the worker thread
+            if (m_pimpl->is_stackless())
+                return (std::numeric_limits<std::ptrdiff_t>::max)();
             return m_pimpl->get_available_stack_space();
 #else
             return (std::numeric_limits<std::ptrdiff_t>::max)();
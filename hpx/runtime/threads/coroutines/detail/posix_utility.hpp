@@ -46,6 +46,7 @@
  */
 #include <cerrno>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <stdexcept>
 
@@ -77,10 +78,17 @@ namespace posix
 {
     HPX_EXPORT extern bool use_guard_pages;
 
+    // The maximal number of idle stacks kept per stack size by the
+    // process-wide stack pool, any stack released beyond this number is
+    // returned to the OS.
+    HPX_EXPORT extern std::size_t stack_pool_high_water_mark;
+
 #if defined(HPX_HAVE_THREAD_STACK_MMAP) && defined(_POSIX_MAPPED_FILES) \
  && _POSIX_MAPPED_FILES > 0
 
-    inline void* alloc_stack(std::size_t size)
+    // Reserve the address space for a new stack. The memory is committed
+    // lazily by the OS whenever a page is touched for the first time.
+    inline void* map_stack(std::size_t size)
     {
         void* real_stack = ::mmap(nullptr,
             size + EXEC_PAGESIZE,
@@ -133,6 +141,19 @@ namespace posix
         *watermark = reinterpret_cast<void*>(0xDEADBEEFDEADBEEFull);
     }
 
+    // Give the pages of the stack beyond its first page back to the OS. We
+    // prefer MADV_FREE as it allows for the kernel to reclaim the pages
+    // lazily (only under memory pressure), which makes reusing them cheap.
+    inline void release_stack_pages(void* stack, std::size_t size)
+    {
+#if defined(MADV_FREE)
+        if (::madvise(stack, size - EXEC_PAGESIZE, MADV_FREE) == 0)
+            return;
+        // older kernels don't support MADV_FREE (EINVAL)
+#endif
+        ::madvise(stack, size - EXEC_PAGESIZE, MADV_DONTNEED);
+    }
+
     inline bool reset_stack(void* stack, std::size_t size)
     {
         void** watermark = static_cast<void**>(stack) + ((size - EXEC_PAGESIZE)
@@ -144,14 +165,14 @@ namespace posix
         {
             // We never free up the first page, as it's initialized only when the
             // stack is created.
-            ::madvise(stack, size - EXEC_PAGESIZE, MADV_DONTNEED);
+            release_stack_pages(stack, size);
             return true;
         }
 
         return false;
     }
 
-    inline void free_stack(void* stack, std::size_t size)
+    inline void unmap_stack(void* stack, std::size_t size)
     {
 #if defined(HPX_HAVE_THREAD_GUARD_PAGE)
         if (use_guard_pages) {
@@ -166,6 +187,16 @@ namespace posix
 #endif
     }
 
+    // Stacks are allocated from (and released to) a process-wide pool
+    // holding one free list per stack size, see stack_pool.cpp.
+    HPX_EXPORT void* alloc_stack(std::size_t size);
+    HPX_EXPORT void free_stack(void* stack, std::size_t size);
+
+    // number of bytes of address space reserved for all stacks (in use and
+    // pooled) and the number of bytes thereof currently backed by memory
+    HPX_EXPORT std::int64_t get_stack_reserved_bytes(bool reset);
+    HPX_EXPORT std::int64_t get_stack_committed_bytes(bool reset);
+
 #else  // non-mmap()
 
     //this should be a fine default.
@@ -204,6 +235,16 @@ namespace posix
         delete[] static_cast<stack_aligner*>(stack);
     }
 
+    inline std::int64_t get_stack_reserved_bytes(bool reset)
+    {
+        return 0;
+    }
+
+    inline std::int64_t get_stack_committed_bytes(bool reset)
+    {
+        return 0;
+    }
+
 #endif  // non-mmap() implementation of alloc_stack()/free_stack()
 
     /**
@@ -13,6 +13,8 @@
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/logging.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <sstream>
 
 namespace hpx { namespace threads { namespace detail
@@ -93,18 +95,136 @@ namespace hpx { namespace threads { namespace detail
             data.priority = thread_priority_normal;
 
         // create the new thread
+        std::size_t num_thread = data.num_os_thread;
         if (thread_priority_high == data.priority ||
             thread_priority_high_recursive == data.priority ||
             thread_priority_boost == data.priority)
         {
             // For critical priority threads, create the thread immediately.
             scheduler->create_thread(data, nullptr, initial_state, true, ec,
-                data.num_os_thread);
+                num_thread);
         }
         else {
             // Create a task description for the new thread.
             scheduler->create_thread(data, nullptr, initial_state, false, ec,
-                data.num_os_thread);
+                num_thread);
+        }
+
+        // potentially wake up waiting thread
+        scheduler->do_some_work(num_thread);
+    }
+
+    // Create count new threads at once. Critical priority threads are created
+    // right away, all other threads are handed to the scheduler in batches.
+    inline void create_work(policies::scheduler_base* scheduler,
+        thread_init_data* data, std::size_t count,
+        thread_state_enum initial_state = threads::pending,
+        error_code& ec = throws)
+    {
+        // verify parameters
+        switch (initial_state) {
+        case pending:
+        case pending_do_not_schedule:
+        case pending_boost:
+        case suspended:
+            break;
+
+        default:
+            {
+                std::ostringstream strm;
+                strm << "invalid initial state: "
+                     << get_thread_state_name(initial_state);
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "thread::detail::create_work",
+                    strm.str());
+                return;
+            }
+        }
+
+        LTM_(info)
+            << "create_work: initial_state("
+            << get_thread_state_name(initial_state) << "), count("
+            << count << ")";
+
+        thread_self* self = get_self_ptr();
+        bool const parent_high_recursive = self != nullptr &&
+            thread_priority_high_recursive ==
+                threads::get_self_id()->get_priority();
+
+#ifdef HPX_HAVE_THREAD_PARENT_REFERENCE
+        threads::thread_id_repr_type parent_id = nullptr;
+        std::size_t parent_phase = 0;
+        if (self)
+        {
+            parent_id = threads::get_self_id().get();
+            parent_phase = self->get_thread_phase();
+        }
+        std::uint32_t const parent_locality_id = get_locality_id();
+#endif
+
+        std::size_t first = 0;      // first thread of the current batch
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            thread_init_data& d = data[i];
+
+#ifdef HPX_HAVE_THREAD_DESCRIPTION
+            if (!d.description)
+            {
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "thread::detail::create_work", "description is nullptr");
+                return;
+            }
+#endif
+
+#ifdef HPX_HAVE_THREAD_PARENT_REFERENCE
+            if (nullptr == d.parent_id)
+            {
+                d.parent_id = parent_id;
+                d.parent_phase = parent_phase;
+            }
+            if (0 == d.parent_locality_id)
+                d.parent_locality_id = parent_locality_id;
+#endif
+
+            if (nullptr == d.scheduler_base)
+                d.scheduler_base = scheduler;
+
+            // Pass critical priority from parent to child.
+            if (d.priority == thread_priority_default)
+            {
+                d.priority = parent_high_recursive ?
+                    thread_priority_high_recursive : thread_priority_normal;
+            }
+
+            if (thread_priority_high == d.priority ||
+                thread_priority_high_recursive == d.priority ||
+                thread_priority_boost == d.priority)
+            {
+                // flush the current batch to preserve the order of creation
+                if (first != i)
+                {
+                    scheduler->create_threads(
+                        data + first, i - first, initial_state, ec);
+                    if (ec) return;
+                }
+                first = i + 1;
+
+                // For critical priority threads, create the thread immediately.
+                std::size_t num_thread = d.num_os_thread;
+                scheduler->create_thread(d, nullptr, initial_state, true, ec,
+                    num_thread);
+                if (ec) return;
+
+                // potentially wake up waiting thread
+                scheduler->do_some_work(num_thread);
+            }
+        }
+
+        // Create task descriptions for the remaining threads.
+        if (first != count)
+        {
+            scheduler->create_threads(
+                data + first, count - first, initial_state, ec);
         }
     }
 }}}
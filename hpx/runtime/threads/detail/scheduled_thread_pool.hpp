@@ -11,6 +11,7 @@
 #include <hpx/compat/mutex.hpp>
 #include <hpx/compat/thread.hpp>
 #include <hpx/error_code.hpp>
+#include <hpx/runtime/threads/detail/scheduling_loop.hpp>
 #include <hpx/runtime/threads/detail/thread_pool_base.hpp>
 #include <hpx/runtime/threads/policies/callback_notifier.hpp>
 #include <hpx/runtime/threads/policies/scheduler_base.hpp>
@@ -74,6 +75,8 @@ namespace hpx { namespace threads { namespace detail
 
         void create_work(thread_init_data& data,
             thread_state_enum initial_state, error_code& ec);
+        void create_work(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state, error_code& ec);
 
         thread_state set_state(thread_id_type const& id,
             thread_state_enum new_state, thread_state_ex_enum new_state_ex,
@@ -144,6 +147,25 @@ namespace hpx { namespace threads { namespace detail
             return threads_.size();
         }
 
+        std::int64_t get_num_task_descriptions_reused(
+            std::size_t num, bool reset)
+        {
+            return sched_->Scheduler::get_num_task_descriptions_reused(
+                num, reset);
+        }
+
+        std::int64_t get_num_task_descriptions_allocated(
+            std::size_t num, bool reset)
+        {
+            return sched_->Scheduler::get_num_task_descriptions_allocated(
+                num, reset);
+        }
+
+        std::int64_t get_num_cross_worker_frees(std::size_t num, bool reset)
+        {
+            return sched_->Scheduler::get_num_cross_worker_frees(num, reset);
+        }
+
 #ifdef HPX_HAVE_THREAD_STEALING_COUNTS
         std::int64_t get_num_pending_misses(std::size_t num, bool reset)
         {
@@ -174,7 +196,40 @@ namespace hpx { namespace threads { namespace detail
         {
             return sched_->Scheduler::get_num_stolen_to_staged(num, reset);
         }
+
+        std::int64_t get_num_stolen_local(std::size_t num, bool reset)
+        {
+            return sched_->Scheduler::get_num_stolen_local(num, reset);
+        }
+
+        std::int64_t get_num_stolen_remote(std::size_t num, bool reset)
+        {
+            return sched_->Scheduler::get_num_stolen_remote(num, reset);
+        }
+
+        std::int64_t get_num_stolen_continuations(std::size_t num, bool reset)
+        {
+            return sched_->Scheduler::get_num_stolen_continuations(num, reset);
+        }
+#endif
+
+#ifdef HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF
+        std::int64_t get_num_idle_parks(std::size_t num, bool reset)
+        {
+            return sched_->Scheduler::get_num_idle_parks(num, reset);
+        }
+
+        std::int64_t get_num_idle_unparks(std::size_t num, bool reset)
+        {
+            return sched_->Scheduler::get_num_idle_unparks(num, reset);
+        }
+
+        std::int64_t get_average_unpark_latency(std::size_t num, bool reset)
+        {
+            return sched_->Scheduler::get_average_unpark_latency(num, reset);
+        }
 #endif
+
         std::int64_t get_queue_length(std::size_t num_thread, bool reset)
         {
             return sched_->Scheduler::get_queue_length(num_thread);
@@ -211,6 +266,13 @@ namespace hpx { namespace threads { namespace detail
 
         std::int64_t get_cumulative_duration(std::size_t, bool);
 
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+        std::vector<std::int64_t> get_queue_wait_histogram(std::size_t, bool);
+        std::vector<std::int64_t> get_execution_time_histogram(
+            std::size_t, bool);
+        std::vector<std::int64_t> get_suspension_histogram(std::size_t, bool);
+#endif
+
 #if defined(HPX_HAVE_THREAD_IDLE_RATES)
         std::int64_t avg_idle_rate_all(bool reset);
         std::int64_t avg_idle_rate(std::size_t, bool);
@@ -315,6 +377,18 @@ namespace hpx { namespace threads { namespace detail
 
         std::vector<std::int64_t> idle_loop_counts_, busy_loop_counts_;
 
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+        typedef task_latency_histograms::histogram_type
+            task_latency_histograms::* latency_histogram_member;
+
+        std::vector<std::int64_t> get_latency_histogram(
+            latency_histogram_member which, std::size_t num, bool reset);
+
+        // per-worker task latency distributions
+        std::unique_ptr<task_latency_histograms[]> latency_histograms_;
+        std::size_t num_latency_histograms_;
+#endif
+
         // support detail::manage_executor interface
         std::atomic<long> thread_count_;
         std::atomic<std::int64_t> tasks_scheduled_;
@@ -99,6 +99,9 @@ namespace hpx { namespace threads { namespace detail
             std::size_t thread_offset)
         : thread_pool_base(notifier, index, pool_name, m, thread_offset)
         , sched_(std::move(sched))
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+        , num_latency_histograms_(0)
+#endif
         , thread_count_(0)
         , tasks_scheduled_(0)
     {
@@ -179,7 +182,7 @@ namespace hpx { namespace threads { namespace detail
             sched_->Scheduler::set_all_states(state_stopping);
 
             // make sure we're not waiting
-            sched_->Scheduler::do_some_work(std::size_t(-1));
+            sched_->Scheduler::do_some_work_all();
 
             if (blocking)
             {
@@ -192,7 +195,7 @@ namespace hpx { namespace threads { namespace detail
                     // make sure no OS thread is waiting
                     LTM_(info) << "stop: " << id_.name() << " notify_all";
 
-                    sched_->Scheduler::do_some_work(std::size_t(-1));
+                    sched_->Scheduler::do_some_work_all();
 
                     LTM_(info) << "stop: " << id_.name() << " join:" << i;
 
@@ -402,10 +405,14 @@ namespace hpx { namespace threads { namespace detail
                     busy_loop_counts_[thread_num],
                     tasks_active_[thread_num]);
 
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+                counters.latency_histograms_ = &latency_histograms_[thread_num];
+#endif
+
                 detail::scheduling_callbacks callbacks(
                     util::bind(    //-V107
                         &policies::scheduler_base::idle_callback,
-                        std::ref(sched_), global_thread_num),
+                        std::ref(sched_), thread_num),
                     detail::scheduling_callbacks::callback_type());
 
                 if (mode_ & policies::do_background_work)
@@ -518,6 +525,28 @@ namespace hpx { namespace threads { namespace detail
         ++tasks_scheduled_;
     }
 
+    template <typename Scheduler>
+    void scheduled_thread_pool<Scheduler>::create_work(
+        thread_init_data* data, std::size_t count,
+        thread_state_enum initial_state, error_code& ec)
+    {
+        // verify state
+        if (thread_count_ == 0 && !sched_->Scheduler::is_state(state_running))
+        {
+            // thread-manager is not currently running
+            HPX_THROWS_IF(ec, invalid_status,
+                "thread_pool<Scheduler>::create_work",
+                "invalid state: thread pool is not running");
+            return;
+        }
+
+        detail::create_work(
+            sched_.get(), data, count, initial_state, ec);    //-V601
+
+        // update statistics
+        tasks_scheduled_ += static_cast<std::int64_t>(count);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename Scheduler>
     thread_state scheduled_thread_pool<Scheduler>::set_state(
@@ -1044,6 +1073,56 @@ namespace hpx { namespace threads { namespace detail
         return std::uint64_t(double(tfunc_total) * timestamp_scale_);
     }
 
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+    template <typename Scheduler>
+    std::vector<std::int64_t>
+    scheduled_thread_pool<Scheduler>::get_latency_histogram(
+        latency_histogram_member which, std::size_t num, bool reset)
+    {
+        typedef task_latency_histograms::histogram_type histogram_type;
+        std::vector<std::int64_t> result(histogram_type::num_buckets, 0);
+
+        if (num != std::size_t(-1))
+        {
+            HPX_ASSERT(num < num_latency_histograms_);
+            (latency_histograms_[num].*which).collect(result, reset);
+        }
+        else
+        {
+            for (std::size_t i = 0; i != num_latency_histograms_; ++i)
+                (latency_histograms_[i].*which).collect(result, reset);
+        }
+        return result;
+    }
+
+    template <typename Scheduler>
+    std::vector<std::int64_t>
+    scheduled_thread_pool<Scheduler>::get_queue_wait_histogram(
+        std::size_t num, bool reset)
+    {
+        return get_latency_histogram(
+            &task_latency_histograms::queue_wait_, num, reset);
+    }
+
+    template <typename Scheduler>
+    std::vector<std::int64_t>
+    scheduled_thread_pool<Scheduler>::get_execution_time_histogram(
+        std::size_t num, bool reset)
+    {
+        return get_latency_histogram(
+            &task_latency_histograms::execution_time_, num, reset);
+    }
+
+    template <typename Scheduler>
+    std::vector<std::int64_t>
+    scheduled_thread_pool<Scheduler>::get_suspension_histogram(
+        std::size_t num, bool reset)
+    {
+        return get_latency_histogram(
+            &task_latency_histograms::suspensions_, num, reset);
+    }
+#endif
+
 #if defined(HPX_HAVE_THREAD_IDLE_RATES)
 #if defined(HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES)
     template <typename Scheduler>
@@ -1257,6 +1336,11 @@ namespace hpx { namespace threads { namespace detail
 
         tasks_active_.resize(pool_threads);
 
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+        latency_histograms_.reset(new task_latency_histograms[pool_threads]);
+        num_latency_histograms_ = pool_threads;
+#endif
+
 #if defined(HPX_HAVE_THREAD_CUMULATIVE_COUNTS)
         // timestamps/values of last reset operation for various
         // performance counters
@@ -1434,6 +1518,9 @@ namespace hpx { namespace threads { namespace detail
             oldstate == state_running || oldstate == state_suspended ||
             oldstate == state_stopping || oldstate == state_stopped);
 
+        // make sure the virtual core is not sleeping
+        sched_->Scheduler::do_some_work(virt_core);
+
         {
             std::unique_lock<pu_mutex_type> l(used_processing_units_mtx_);
             if (threads_.size() <= virt_core || !threads_[virt_core].joinable())
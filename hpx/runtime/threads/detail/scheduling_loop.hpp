@@ -16,7 +16,9 @@
 #include <hpx/util/assert.hpp>
 #include <hpx/util/function.hpp>
 #include <hpx/util/hardware/timestamp.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
 #include <hpx/util/itt_notify.hpp>
+#include <hpx/util/log_linear_histogram.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
 
 #if defined(HPX_HAVE_APEX)
@@ -223,6 +225,68 @@ namespace hpx { namespace threads { namespace detail
         std::uint8_t& is_active_;
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+    // per-worker distributions of the time HPX-threads spent waiting in the
+    // queues, their overall execution time, and how often they have been
+    // suspended
+    struct task_latency_histograms
+    {
+        typedef util::log_linear_histogram<> histogram_type;
+
+        histogram_type queue_wait_;
+        histogram_type execution_time_;
+        histogram_type suspensions_;
+    };
+
+    struct task_latency_wrapper
+    {
+        task_latency_wrapper(task_latency_histograms* histograms,
+                thread_data* thrd)
+          : timestamp_(util::high_resolution_clock::now())
+          , histograms_(histograms)
+          , thrd_(thrd)
+        {
+            std::uint64_t queue_time = thrd->get_queue_time();
+            if (queue_time != 0)
+            {
+                if (histograms_ != nullptr && timestamp_ > queue_time)
+                    histograms_->queue_wait_.add(timestamp_ - queue_time);
+                thrd->set_queue_time(0);
+            }
+        }
+        ~task_latency_wrapper()
+        {
+            thrd_->add_execution_phase(
+                util::high_resolution_clock::now() - timestamp_);
+        }
+
+        std::uint64_t timestamp_;
+        task_latency_histograms* histograms_;
+        thread_data* thrd_;
+    };
+
+    inline void collect_task_latencies(
+        task_latency_histograms* histograms, thread_data* thrd)
+    {
+        if (histograms != nullptr && thrd->get_execution_phases() != 0)
+        {
+            histograms->execution_time_.add(thrd->get_execution_time());
+            histograms->suspensions_.add(thrd->get_execution_phases() - 1);
+        }
+    }
+#else
+    struct task_latency_histograms {};
+
+    struct task_latency_wrapper
+    {
+        task_latency_wrapper(task_latency_histograms*, thread_data*) {}
+    };
+
+    inline void collect_task_latencies(task_latency_histograms*, thread_data*)
+    {}
+#endif
+
     ///////////////////////////////////////////////////////////////////////////
     struct scheduling_counters
     {
@@ -237,7 +301,8 @@ namespace hpx { namespace threads { namespace detail
             exec_time_(exec_time),
             idle_loop_count_(idle_loop_count),
             busy_loop_count_(busy_loop_count),
-            is_active_(is_active)
+            is_active_(is_active),
+            latency_histograms_(nullptr)
         {}
 
         std::int64_t& executed_threads_;
@@ -247,6 +312,9 @@ namespace hpx { namespace threads { namespace detail
         std::int64_t& idle_loop_count_;
         std::int64_t& busy_loop_count_;
         std::uint8_t& is_active_;
+
+        // optional, used only if HPX_HAVE_THREAD_LATENCY_HISTOGRAMS is defined
+        task_latency_histograms* latency_histograms_;
     };
 
     struct scheduling_callbacks
@@ -443,6 +511,9 @@ namespace hpx { namespace threads { namespace detail
 
         // spin for some time after queues have become empty
         bool may_exit = false;
+
+        // the idle callback has been invoked since work was found last
+        bool backed_off = false;
         thread_data* thrd = nullptr;
         thread_data* next_thrd = nullptr;
 
@@ -475,6 +546,12 @@ namespace hpx { namespace threads { namespace detail
 
                 may_exit = false;
 
+                if (HPX_UNLIKELY(backed_off))
+                {
+                    backed_off = false;
+                    scheduler.SchedulingPolicy::reset_idle_backoff(num_thread);
+                }
+
                 // Only pending HPX threads will be executed.
                 // Any non-pending HPX threads are leftovers from a set_state()
                 // call for a previously pending HPX thread (see comments above).
@@ -511,6 +588,8 @@ namespace hpx { namespace threads { namespace detail
                                 // Record time elapsed in thread changing state
                                 // and add to aggregate execution time.
                                 exec_time_wrapper exec_time_collector(idle_rate);
+                                task_latency_wrapper latency_collector(
+                                    counters.latency_histograms_, thrd);
 
 #if defined(HPX_HAVE_APEX)
                                 // get the APEX data pointer, in case we are resuming the
@@ -584,12 +663,20 @@ namespace hpx { namespace threads { namespace detail
                             // schedule other work
                             scheduler.SchedulingPolicy::wait_or_add_new(
                                 num_thread, running, idle_loop_count);
-                        }
 
-                        // schedule this thread again, make sure it ends up at
-                        // the end of the queue
-                        scheduler.SchedulingPolicy::schedule_thread_last(thrd,
-                            num_thread);
+                            // schedule this thread again, make sure it ends
+                            // up at the end of the queue
+                            scheduler.SchedulingPolicy::schedule_thread_last(
+                                thrd, num_thread);
+                        }
+                        else {
+                            // this thread has yielded to a (usually newly
+                            // created) thread, make its continuation
+                            // available for stealing while the other thread
+                            // runs (work-first execution)
+                            scheduler.SchedulingPolicy::schedule_continuation(
+                                thrd, num_thread);
+                        }
                         scheduler.SchedulingPolicy::do_some_work(num_thread);
                     }
                     else if (HPX_UNLIKELY(state_val == pending_boost))
@@ -655,6 +742,8 @@ namespace hpx { namespace threads { namespace detail
 #ifdef HPX_HAVE_THREAD_CUMULATIVE_COUNTS
                     ++counters.executed_threads_;
 #endif
+                    collect_task_latencies(
+                        counters.latency_histograms_, thrd);
                     scheduler.SchedulingPolicy::destroy_thread(thrd, busy_loop_count);
                 }
             }
@@ -744,7 +833,10 @@ namespace hpx { namespace threads { namespace detail
 
                 // call back into invoking context
                 if (!params.outer_.empty())
+                {
                     params.outer_();
+                    backed_off = true;
+                }
 
                 // break if we were idling after 'may_exit'
                 if (may_exit)
@@ -91,6 +91,15 @@ namespace hpx { namespace threads { namespace detail
             thread_state_enum initial_state, bool run_now, error_code& ec) = 0;
         virtual void create_work(thread_init_data& data,
             thread_state_enum initial_state, error_code& ec) = 0;
+        virtual void create_work(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state, error_code& ec)
+        {
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                create_work(data[i], initial_state, ec);
+                if (ec) return;
+            }
+        }
 
         virtual thread_state set_state(thread_id_type const& id,
             thread_state_enum new_state, thread_state_ex_enum new_state_ex,
@@ -147,6 +156,26 @@ namespace hpx { namespace threads { namespace detail
         virtual std::int64_t get_cumulative_duration(
             std::size_t thread_num, bool reset) { return 0; }
 
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+        // the returned data holds the bucket counts of a
+        // util::log_linear_histogram<>, it is empty if not supported
+        virtual std::vector<std::int64_t> get_queue_wait_histogram(
+            std::size_t thread_num, bool reset)
+        {
+            return std::vector<std::int64_t>();
+        }
+        virtual std::vector<std::int64_t> get_execution_time_histogram(
+            std::size_t thread_num, bool reset)
+        {
+            return std::vector<std::int64_t>();
+        }
+        virtual std::vector<std::int64_t> get_suspension_histogram(
+            std::size_t thread_num, bool reset)
+        {
+            return std::vector<std::int64_t>();
+        }
+#endif
+
 #if defined(HPX_HAVE_THREAD_IDLE_RATES)
         virtual std::int64_t avg_idle_rate_all(bool reset) { return 0; }
         virtual std::int64_t avg_idle_rate(std::size_t, bool) { return 0; }
@@ -168,6 +197,13 @@ namespace hpx { namespace threads { namespace detail
             std::size_t thread_num, bool reset) { return 0; }
 #endif
 
+        virtual std::int64_t get_num_task_descriptions_reused(
+            std::size_t thread_num, bool reset) { return 0; }
+        virtual std::int64_t get_num_task_descriptions_allocated(
+            std::size_t thread_num, bool reset) { return 0; }
+        virtual std::int64_t get_num_cross_worker_frees(
+            std::size_t thread_num, bool reset) { return 0; }
+
 #if defined(HPX_HAVE_THREAD_STEALING_COUNTS)
         virtual std::int64_t get_num_pending_misses(
             std::size_t thread_num, bool reset) { return 0; }
@@ -182,6 +218,21 @@ namespace hpx { namespace threads { namespace detail
             std::size_t thread_num, bool reset) { return 0; }
         virtual std::int64_t get_num_stolen_to_staged(
             std::size_t thread_num, bool reset) { return 0; }
+        virtual std::int64_t get_num_stolen_local(
+            std::size_t thread_num, bool reset) { return 0; }
+        virtual std::int64_t get_num_stolen_remote(
+            std::size_t thread_num, bool reset) { return 0; }
+        virtual std::int64_t get_num_stolen_continuations(
+            std::size_t thread_num, bool reset) { return 0; }
+#endif
+
+#ifdef HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF
+        virtual std::int64_t get_num_idle_parks(
+            std::size_t thread_num, bool reset) { return 0; }
+        virtual std::int64_t get_num_idle_unparks(
+            std::size_t thread_num, bool reset) { return 0; }
+        virtual std::int64_t get_average_unpark_latency(
+            std::size_t thread_num, bool reset) { return 0; }
 #endif
 
         virtual std::int64_t get_thread_count(thread_state_enum state,
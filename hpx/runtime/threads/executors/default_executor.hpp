@@ -108,6 +108,26 @@ namespace hpx { namespace threads { namespace executors
                 thread_priority_default, thread_stacksize_default, os_thread))
         {}
     };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The stackless_executor creates threads which don't own a stack. Those
+    // run to completion on the stack of the worker thread executing them,
+    // which avoids the context switches and the stack memory needed for
+    // ordinary threads. Stackless threads must not suspend (i.e. must not
+    // wait for futures which are not ready yet), an exception is thrown
+    // otherwise. This makes this executor a good fit for short continuations.
+    struct stackless_executor : public default_executor
+    {
+        stackless_executor()
+          : default_executor(thread_priority_default,
+                thread_stacksize_nostack, std::size_t(-1))
+        {}
+
+        stackless_executor(thread_priority priority,
+                std::size_t os_thread = std::size_t(-1))
+          : default_executor(priority, thread_stacksize_nostack, os_thread)
+        {}
+    };
 }}}
 
 #include <hpx/config/warnings_suffix.hpp>
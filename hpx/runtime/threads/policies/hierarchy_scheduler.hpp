@@ -393,6 +393,60 @@ namespace hpx { namespace threads { namespace policies
         }
 #endif
 
+        std::int64_t get_num_task_descriptions_reused(std::size_t num_thread, bool reset)
+        {
+            std::int64_t num_reused = 0;
+            if (num_thread == std::size_t(-1))
+            {
+                for (size_type i = 0; i != tree.size(); ++i)
+                {
+                    level_type& t = tree[i];
+                    for (size_type j = 0; j != t.size(); ++j)
+                        num_reused += t[j]->
+                            get_num_task_descriptions_reused(reset);
+                }
+                return num_reused;
+            }
+
+            for (size_type i = 0; i != tree.size(); ++i)
+            {
+                level_type& t = tree[i];
+                if (num_thread < t.size())
+                {
+                    num_reused += t[num_thread]->
+                        get_num_task_descriptions_reused(reset);
+                }
+            }
+            return num_reused;
+        }
+
+        std::int64_t get_num_task_descriptions_allocated(std::size_t num_thread, bool reset)
+        {
+            std::int64_t num_allocated = 0;
+            if (num_thread == std::size_t(-1))
+            {
+                for (size_type i = 0; i != tree.size(); ++i)
+                {
+                    level_type& t = tree[i];
+                    for (size_type j = 0; j != t.size(); ++j)
+                        num_allocated += t[j]->
+                            get_num_task_descriptions_allocated(reset);
+                }
+                return num_allocated;
+            }
+
+            for (size_type i = 0; i != tree.size(); ++i)
+            {
+                level_type& t = tree[i];
+                if (num_thread < t.size())
+                {
+                    num_allocated += t[num_thread]->
+                        get_num_task_descriptions_allocated(reset);
+                }
+            }
+            return num_allocated;
+        }
+
 #ifdef HPX_HAVE_THREAD_STEALING_COUNTS
         std::int64_t get_num_pending_misses(std::size_t num_thread, bool reset)
         {
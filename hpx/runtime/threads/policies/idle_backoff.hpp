@@ -0,0 +1,160 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_POLICIES_IDLE_BACKOFF_HPP)
+#define HPX_RUNTIME_THREADS_POLICIES_IDLE_BACKOFF_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/compat/condition_variable.hpp>
+#include <hpx/compat/mutex.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace threads { namespace policies
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Adaptive back-off for idling worker threads.
+    //
+    // Every time a worker has run out of work for a while on_idle() is
+    // invoked, which escalates from spinning on the 'pause' instruction over
+    // yielding the OS thread to parking the worker (on a futex where
+    // available). New work wakes up exactly one parked worker, preferably the
+    // one owning the queue the work has been added to.
+    class HPX_EXPORT idle_backoff
+    {
+    public:
+        HPX_NON_COPYABLE(idle_backoff);
+
+    public:
+        explicit idle_backoff(std::size_t num_threads);
+        ~idle_backoff();
+
+        // Back off, the supplied predicate is invoked right before parking
+        // to check whether work has been added in the meantime.
+        template <typename F>
+        void on_idle(std::size_t num_thread, F && has_work)
+        {
+            HPX_ASSERT(num_thread < num_threads_);
+            worker_state& s = states_[num_thread];
+
+            std::uint32_t const rounds = s.rounds_;
+            if (rounds < pause_rounds_ + yield_rounds_)
+            {
+                ++s.rounds_;
+                if (rounds < pause_rounds_)
+                    pause(rounds);
+                else
+                    yield();
+                return;
+            }
+
+            // announce that this worker is about to go to sleep before
+            // checking for work a last time, anybody adding work after this
+            // point will wake us up
+            prepare_park(s);
+            if (has_work())
+            {
+                cancel_park(s);
+                return;
+            }
+            park(s);
+        }
+
+        // Start over with the cheapest back-off stage, this is called by the
+        // worker whenever it has found work.
+        void reset(std::size_t num_thread)
+        {
+            HPX_ASSERT(num_thread < num_threads_);
+            states_[num_thread].rounds_ = 0;
+        }
+
+        // Wake up one parked worker, if any. The worker with the given number
+        // is preferred.
+        void notify_one(std::size_t num_thread)
+        {
+            if (num_parked_.load() != 0)
+                unpark_one(num_thread);
+        }
+
+        // Wake up all parked workers.
+        void notify_all();
+
+        // performance counter data
+        std::int64_t get_park_count(std::size_t num_thread, bool reset);
+        std::int64_t get_unpark_count(std::size_t num_thread, bool reset);
+        std::int64_t get_average_unpark_latency(
+            std::size_t num_thread, bool reset);
+
+    private:
+        enum park_state
+        {
+            not_parked = 0,
+            parked = 1,
+            waking_up = 2
+        };
+
+        struct worker_state
+        {
+            worker_state()
+              : parked_(not_parked), rounds_(0), notify_time_(0),
+                parks_(0), unparks_(0), unpark_latency_(0),
+                unpark_latency_samples_(0)
+            {}
+
+            // futex word, holds a park_state
+            std::atomic<std::uint32_t> parked_;
+
+            // number of consecutive back-off rounds, accessed by the owning
+            // worker only
+            std::uint32_t rounds_;
+
+            // time stamp of the wake-up request
+            std::atomic<std::uint64_t> notify_time_;
+
+            std::atomic<std::int64_t> parks_;
+            std::atomic<std::int64_t> unparks_;
+            std::atomic<std::int64_t> unpark_latency_;
+            std::atomic<std::int64_t> unpark_latency_samples_;
+
+            char padding_[64 - 2 * sizeof(std::uint32_t) -
+                5 * sizeof(std::int64_t)];
+        };
+
+        static void pause(std::uint32_t rounds);
+        static void yield();
+
+        void prepare_park(worker_state& s);
+        void cancel_park(worker_state& s);
+        void park(worker_state& s);
+
+        bool unpark(worker_state& s);
+        void unpark_one(std::size_t num_thread);
+
+        std::size_t const num_threads_;
+        std::unique_ptr<worker_state[]> states_;
+
+        std::atomic<std::size_t> num_parked_;
+        std::atomic<std::size_t> next_victim_;
+
+        std::uint32_t const pause_rounds_;
+        std::uint32_t const yield_rounds_;
+        std::int64_t const max_park_time_;      // in microseconds
+
+        // used for parking if no futex is available
+        compat::mutex mtx_;
+        compat::condition_variable cond_;
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
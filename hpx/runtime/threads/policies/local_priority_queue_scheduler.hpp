@@ -9,6 +9,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/compat/mutex.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
 #include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
 #include <hpx/runtime/threads/policies/scheduler_base.hpp>
 #include <hpx/runtime/threads/policies/thread_queue.hpp>
@@ -20,6 +21,7 @@
 #include <hpx/util/logging.hpp>
 #include <hpx/util_fwd.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
@@ -52,6 +54,13 @@ namespace hpx { namespace threads { namespace policies
     /// High priority threads are executed by the first N OS threads before any
     /// other work is executed. Low priority threads are executed by the last
     /// OS thread whenever no other work is available.
+    ///
+    /// If hierarchical stealing is enabled, idle OS threads steal work from
+    /// the threads sharing their core first, then from the threads sharing
+    /// their socket (or NUMA domain) and only then from remote NUMA domains.
+    /// Each level uses its own thresholds for the minimal number of items a
+    /// queue has to hold before it is stolen from, and stealing from remote
+    /// NUMA domains is subject to an exponential back-off.
     template <typename Mutex = compat::mutex,
         typename PendingQueuing = lockfree_fifo,
         typename StagedQueuing = lockfree_fifo,
@@ -78,6 +87,7 @@ namespace hpx { namespace threads { namespace policies
         //    the number of queues
         //    the number of high priority queues
         //    the maxcount per queue
+        //    whether to steal hierarchically (core, socket, remote)
         struct init_parameter
         {
             init_parameter()
@@ -85,21 +95,24 @@ namespace hpx { namespace threads { namespace policies
                 num_high_priority_queues_(1),
                 max_queue_thread_count_(max_thread_count),
                 numa_sensitive_(0),
-                description_("local_priority_queue_scheduler")
+                description_("local_priority_queue_scheduler"),
+                hierarchical_stealing_(false)
             {}
 
             init_parameter(std::size_t num_queues,
                     std::size_t num_high_priority_queues = std::size_t(-1),
                     std::size_t max_queue_thread_count = max_thread_count,
                     std::size_t numa_sensitive = 0,
-                    char const* description = "local_priority_queue_scheduler")
+                    char const* description = "local_priority_queue_scheduler",
+                    bool hierarchical_stealing = false)
               : num_queues_(num_queues),
                 num_high_priority_queues_(
                     num_high_priority_queues == std::size_t(-1) ?
                         num_queues : num_high_priority_queues),
                 max_queue_thread_count_(max_queue_thread_count),
                 numa_sensitive_(numa_sensitive),
-                description_(description)
+                description_(description),
+                hierarchical_stealing_(hierarchical_stealing)
             {}
 
             init_parameter(std::size_t num_queues, char const* description)
@@ -107,7 +120,8 @@ namespace hpx { namespace threads { namespace policies
                 num_high_priority_queues_(num_queues),
                 max_queue_thread_count_(max_thread_count),
                 numa_sensitive_(false),
-                description_(description)
+                description_(description),
+                hierarchical_stealing_(false)
             {}
 
             std::size_t num_queues_;
@@ -115,6 +129,7 @@ namespace hpx { namespace threads { namespace policies
             std::size_t max_queue_thread_count_;
             std::size_t numa_sensitive_;
             char const* description_;
+            bool hierarchical_stealing_;
         };
         typedef init_parameter init_parameter_type;
 
@@ -127,11 +142,35 @@ namespace hpx { namespace threads { namespace policies
             low_priority_queue_(init.max_queue_thread_count_),
             curr_queue_(0),
             numa_sensitive_(init.numa_sensitive_),
+            hierarchical_stealing_(init.hierarchical_stealing_),
+            max_remote_steal_backoff_(std::size_t(
+                (std::max)(detail::get_max_remote_steal_backoff(), 1))),
+            steal_states_(init.num_queues_),
+            thread_return_batch_size_(std::int64_t(
+                (std::max)(detail::get_thread_return_batch_size(), 1))),
+            thread_return_caches_(init.num_queues_),
             rp_(resource::get_partitioner())
         {
             victim_threads_.clear();
             victim_threads_.resize(init.num_queues_);
 
+            for (thread_return_cache& cache : thread_return_caches_)
+                cache.batches_.resize(init.num_queues_);
+
+            min_tasks_to_steal_pending_[steal_core] =
+                detail::get_min_tasks_to_steal_pending();
+            min_tasks_to_steal_pending_[steal_socket] =
+                detail::get_min_tasks_to_steal_pending_socket();
+            min_tasks_to_steal_pending_[steal_remote] =
+                detail::get_min_tasks_to_steal_pending_remote();
+
+            min_tasks_to_steal_staged_[steal_core] =
+                detail::get_min_tasks_to_steal_staged();
+            min_tasks_to_steal_staged_[steal_socket] =
+                detail::get_min_tasks_to_steal_staged_socket();
+            min_tasks_to_steal_staged_[steal_remote] =
+                detail::get_min_tasks_to_steal_staged_remote();
+
             if (!deferred_initialization)
             {
 #if defined(HPX_MSVC)
@@ -163,6 +202,7 @@ namespace hpx { namespace threads { namespace policies
         }
 
         bool numa_sensitive() const { return numa_sensitive_ != 0; }
+        bool hierarchical_stealing() const { return hierarchical_stealing_; }
 
         static std::string get_scheduler_name()
         {
@@ -202,6 +242,91 @@ namespace hpx { namespace threads { namespace policies
         }
 #endif
 
+        std::int64_t get_num_task_descriptions_reused(std::size_t num_thread, bool reset)
+        {
+            std::int64_t num_reused = 0;
+            if (num_thread == std::size_t(-1))
+            {
+                for (std::size_t i = 0; i != high_priority_queues_.size(); ++i)
+                    num_reused += high_priority_queues_[i]->
+                        get_num_task_descriptions_reused(reset);
+
+                for (std::size_t i = 0; i != queues_.size(); ++i)
+                    num_reused += queues_[i]->
+                        get_num_task_descriptions_reused(reset);
+
+                num_reused += low_priority_queue_.
+                    get_num_task_descriptions_reused(reset);
+
+                return num_reused;
+            }
+
+            num_reused += queues_[num_thread]->
+                get_num_task_descriptions_reused(reset);
+
+            if (num_thread < high_priority_queues_.size())
+            {
+                num_reused += high_priority_queues_[num_thread]->
+                    get_num_task_descriptions_reused(reset);
+            }
+            if (num_thread == 0)
+            {
+                num_reused += low_priority_queue_.
+                    get_num_task_descriptions_reused(reset);
+            }
+            return num_reused;
+        }
+
+        std::int64_t get_num_cross_worker_frees(std::size_t num_thread, bool reset)
+        {
+            // only the normal queues are handed back terminated threads by
+            // other worker threads
+            std::int64_t num_frees = 0;
+            if (num_thread == std::size_t(-1))
+            {
+                for (std::size_t i = 0; i != queues_.size(); ++i)
+                    num_frees += queues_[i]->get_num_cross_worker_frees(reset);
+                return num_frees;
+            }
+
+            return queues_[num_thread]->get_num_cross_worker_frees(reset);
+        }
+
+        std::int64_t get_num_task_descriptions_allocated(std::size_t num_thread, bool reset)
+        {
+            std::int64_t num_allocated = 0;
+            if (num_thread == std::size_t(-1))
+            {
+                for (std::size_t i = 0; i != high_priority_queues_.size(); ++i)
+                    num_allocated += high_priority_queues_[i]->
+                        get_num_task_descriptions_allocated(reset);
+
+                for (std::size_t i = 0; i != queues_.size(); ++i)
+                    num_allocated += queues_[i]->
+                        get_num_task_descriptions_allocated(reset);
+
+                num_allocated += low_priority_queue_.
+                    get_num_task_descriptions_allocated(reset);
+
+                return num_allocated;
+            }
+
+            num_allocated += queues_[num_thread]->
+                get_num_task_descriptions_allocated(reset);
+
+            if (num_thread < high_priority_queues_.size())
+            {
+                num_allocated += high_priority_queues_[num_thread]->
+                    get_num_task_descriptions_allocated(reset);
+            }
+            if (num_thread == 0)
+            {
+                num_allocated += low_priority_queue_.
+                    get_num_task_descriptions_allocated(reset);
+            }
+            return num_allocated;
+        }
+
 #ifdef HPX_HAVE_THREAD_STEALING_COUNTS
         std::int64_t get_num_pending_misses(std::size_t num_thread, bool reset)
         {
@@ -412,6 +537,48 @@ namespace hpx { namespace threads { namespace policies
             }
             return num_stolen_threads;
         }
+
+        // steals are accounted for in the (normal priority) queue of the
+        // stealing OS thread
+        std::int64_t get_num_stolen_local(std::size_t num_thread, bool reset)
+        {
+            if (num_thread == std::size_t(-1))
+            {
+                std::int64_t num_stolen_threads = 0;
+                for (std::size_t i = 0; i != queues_.size(); ++i)
+                    num_stolen_threads += queues_[i]->
+                        get_num_stolen_local(reset);
+                return num_stolen_threads;
+            }
+            return queues_[num_thread]->get_num_stolen_local(reset);
+        }
+
+        std::int64_t get_num_stolen_continuations(std::size_t num_thread,
+            bool reset)
+        {
+            if (num_thread == std::size_t(-1))
+            {
+                std::int64_t num_stolen_threads = 0;
+                for (std::size_t i = 0; i != queues_.size(); ++i)
+                    num_stolen_threads += queues_[i]->
+                        get_num_stolen_continuations(reset);
+                return num_stolen_threads;
+            }
+            return queues_[num_thread]->get_num_stolen_continuations(reset);
+        }
+
+        std::int64_t get_num_stolen_remote(std::size_t num_thread, bool reset)
+        {
+            if (num_thread == std::size_t(-1))
+            {
+                std::int64_t num_stolen_threads = 0;
+                for (std::size_t i = 0; i != queues_.size(); ++i)
+                    num_stolen_threads += queues_[i]->
+                        get_num_stolen_remote(reset);
+                return num_stolen_threads;
+            }
+            return queues_[num_thread]->get_num_stolen_remote(reset);
+        }
 #endif
 
         ///////////////////////////////////////////////////////////////////////
@@ -509,6 +676,57 @@ namespace hpx { namespace threads { namespace policies
                 run_now, ec);
         }
 
+        // create a whole batch of new threads, the threads are distributed
+        // block-wise over the queues of all enabled OS threads
+        void create_threads(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state, error_code& ec)
+        {
+            std::size_t const queue_size = queues_.size();
+
+            std::size_t i = 0;
+            while (i != count)
+            {
+                // threads with a non-normal priority or bound to a particular
+                // OS thread are created one by one
+                if (!is_default_queue_thread(data[i]))
+                {
+                    create_thread(data[i], nullptr, initial_state, false, ec,
+                        data[i].num_os_thread);
+                    if (ec) return;
+
+                    ++i;
+                    continue;
+                }
+
+                std::size_t last = i + 1;
+                while (last != count && is_default_queue_thread(data[last]))
+                    ++last;
+
+                // hand each queue one contiguous block of the threads,
+                // starting with the next queue in round-robin order
+                std::size_t const size = last - i;
+                std::size_t const num_blocks = (std::min)(size, queue_size);
+                std::size_t num_thread =
+                    curr_queue_.fetch_add(num_blocks) % queue_size;
+
+                for (std::size_t block = 0; block != num_blocks; ++block)
+                {
+                    std::size_t const block_size = size / num_blocks +
+                        (block < size % num_blocks ? 1 : 0);
+
+                    num_thread = select_enabled_queue(num_thread);
+                    queues_[num_thread]->create_threads(
+                        data + i, block_size, initial_state, ec);
+                    if (ec) return;
+
+                    this->do_some_work(num_thread);
+
+                    i += block_size;
+                    num_thread = (num_thread + 1) % queue_size;
+                }
+            }
+        }
+
         /// Return the next thread to be executed, return false if none is
         /// available
         virtual bool get_next_thread(std::size_t num_thread, bool running,
@@ -549,27 +767,38 @@ namespace hpx { namespace threads { namespace policies
                     return false;
             }
 
-            for (std::size_t idx: victim_threads_[num_thread])
+            bool allow_remote = steal_from_remote_allowed(num_thread);
+            for (victim_thread const& victim: victim_threads_[num_thread])
             {
+                std::size_t idx = victim.num_thread_;
                 HPX_ASSERT(idx != num_thread);
 
+                // the victims are sorted by their distance
+                if (victim.level_ == steal_remote && !allow_remote)
+                    break;
+
                 if (idx < high_priority_queues &&
                     num_thread < high_priority_queues)
                 {
                     thread_queue_type* q = high_priority_queues_[idx];
-                    if (q->get_next_thread(thrd, running))
+                    if (may_steal_pending(q, victim.level_, running) &&
+                        q->get_next_thread(thrd, running))
                     {
                         q->increment_num_stolen_from_pending();
                         this_high_priority_queue->
                             increment_num_stolen_to_pending();
+                        on_stolen(num_thread, victim.level_);
                         return true;
                     }
                 }
 
-                if (queues_[idx]->get_next_thread(thrd, running))
+                thread_queue_type* q = queues_[idx];
+                if (may_steal_pending(q, victim.level_, running) &&
+                    q->get_next_thread(thrd, running))
                 {
-                    queues_[idx]->increment_num_stolen_from_pending();
+                    q->increment_num_stolen_from_pending();
                     this_queue->increment_num_stolen_to_pending();
+                    on_stolen(num_thread, victim.level_);
                     return true;
                 }
             }
@@ -630,9 +859,48 @@ namespace hpx { namespace threads { namespace policies
             }
         }
 
+        void schedule_continuation(threads::thread_data* thrd,
+            std::size_t num_thread)
+        {
+            thread_priority priority = thrd->get_priority();
+            if (num_thread >= queues_.size() ||
+                priority == thread_priority_high_recursive ||
+                priority == thread_priority_high ||
+                priority == thread_priority_boost ||
+                priority == thread_priority_low)
+            {
+                schedule_thread_last(thrd, num_thread, priority);
+                return;
+            }
+            queues_[num_thread]->schedule_continuation(thrd);
+        }
+
         /// Destroy the passed thread as it has been terminated
         bool destroy_thread(threads::thread_data* thrd, std::int64_t& busy_count)
         {
+            std::size_t const queue_size = queues_.size();
+            std::size_t num_thread = hpx::get_worker_thread_num();
+            if (num_thread != std::size_t(-1))
+                num_thread = global_to_local_thread_index(num_thread);
+
+            if (num_thread < queue_size)
+            {
+                // threads created on this worker thread are recycled directly
+                if (queues_[num_thread]->destroy_thread(thrd, busy_count))
+                    return true;
+
+                // threads owned by the normal queue of another worker thread
+                // are collected locally and handed back in batches
+                for (std::size_t i = 0; i != queue_size; ++i)
+                {
+                    if (queues_[i]->owns_thread(thrd))
+                    {
+                        cache_terminated_thread(num_thread, i, thrd);
+                        return true;
+                    }
+                }
+            }
+
             for (std::size_t i = 0; i != high_priority_queues_.size(); ++i)
             {
                 if (high_priority_queues_[i]->destroy_thread(thrd, busy_count))
@@ -918,6 +1186,9 @@ namespace hpx { namespace threads { namespace policies
             std::size_t added = 0;
             bool result = true;
 
+            // hand back terminated threads owned by other worker threads
+            flush_terminated_threads(num_thread);
+
             std::size_t high_priority_queues = high_priority_queues_.size();
             thread_queue_type* this_high_priority_queue = nullptr;
             thread_queue_type* this_queue = queues_[num_thread];
@@ -946,38 +1217,56 @@ namespace hpx { namespace threads { namespace policies
                 }
             }
 
-            for (std::size_t idx: victim_threads_[num_thread])
+            bool allow_remote = steal_from_remote_allowed(num_thread);
+            for (victim_thread const& victim: victim_threads_[num_thread])
             {
+                std::size_t idx = victim.num_thread_;
                 HPX_ASSERT(idx != num_thread);
 
+                // the victims are sorted by their distance
+                if (victim.level_ == steal_remote && !allow_remote)
+                    break;
+
                 if (idx < high_priority_queues &&
                     num_thread < high_priority_queues)
                 {
                     thread_queue_type* q =  high_priority_queues_[idx];
-                    result = this_high_priority_queue->
-                        wait_or_add_new(running, idle_loop_count,
-                            added, q)
-                      && result;
+                    if (may_steal_staged(q, victim.level_, running))
+                    {
+                        result = this_high_priority_queue->
+                            wait_or_add_new(running, idle_loop_count,
+                                added, q)
+                          && result;
+
+                        if (0 != added)
+                        {
+                            q->increment_num_stolen_from_staged(added);
+                            this_high_priority_queue->
+                                increment_num_stolen_to_staged(added);
+                            on_stolen(num_thread, victim.level_, added);
+                            return result;
+                        }
+                    }
+                }
 
+                thread_queue_type* q = queues_[idx];
+                if (may_steal_staged(q, victim.level_, running))
+                {
+                    result = this_queue->wait_or_add_new(running,
+                        idle_loop_count, added, q) && result;
                     if (0 != added)
                     {
                         q->increment_num_stolen_from_staged(added);
-                        this_high_priority_queue->
-                            increment_num_stolen_to_staged(added);
+                        this_queue->increment_num_stolen_to_staged(added);
+                        on_stolen(num_thread, victim.level_, added);
                         return result;
                     }
                 }
-
-                result = this_queue->wait_or_add_new(running,
-                    idle_loop_count, added, queues_[idx]) && result;
-                if (0 != added)
-                {
-                    queues_[idx]->increment_num_stolen_from_staged(added);
-                    this_queue->increment_num_stolen_to_staged(added);
-                    return result;
-                }
             }
 
+            // nothing was found, back off from stealing remotely
+            on_steal_failed(num_thread, allow_remote);
+
 #ifdef HPX_HAVE_THREAD_MINIMAL_DEADLOCK_DETECTION
             // no new work is available, are we deadlocked?
             if (HPX_UNLIKELY(minimal_deadlock_detection && LHPX_ENABLED(error)))
@@ -1052,6 +1341,14 @@ namespace hpx { namespace threads { namespace policies
                 std::size_t num_pu = rp_.get_affinity_data().get_pu_num(i);
                 numa_masks[i] = topo.get_numa_node_affinity_mask(num_pu);
                 core_masks[i] = topo.get_core_affinity_mask(num_pu);
+
+                // for hierarchical stealing the second level comprises all
+                // threads sharing the socket (i.e. usually the L3 cache) or
+                // the NUMA domain
+                if (hierarchical_stealing_)
+                {
+                    numa_masks[i] |= topo.get_socket_affinity_mask(num_pu);
+                }
             }
 
             // iterate over the number of threads again to determine where to
@@ -1075,7 +1372,8 @@ namespace hpx { namespace threads { namespace policies
             else
                 first_mask = pu_mask;
 
-            auto iterate = [&](hpx::util::function_nonser<bool(std::size_t)> f)
+            auto iterate = [&](hpx::util::function_nonser<bool(std::size_t)> f,
+                steal_level level)
             {
                 // check our neighbors in a radial fashion (left and right
                 // alternating, increasing distance each iteration)
@@ -1090,14 +1388,15 @@ namespace hpx { namespace threads { namespace policies
 
                     if (f(std::size_t(left)))
                     {
-                        victim_threads_[num_thread].push_back(
-                            static_cast<std::size_t>(left));
+                        victim_threads_[num_thread].push_back(victim_thread(
+                            static_cast<std::size_t>(left), level));
                     }
 
                     std::size_t right = (num_thread + i) % num_threads;
                     if (f(right))
                     {
-                        victim_threads_[num_thread].push_back(right);
+                        victim_threads_[num_thread].push_back(
+                            victim_thread(right, level));
                     }
                 }
                 if ((num_threads % 2) == 0)
@@ -1105,7 +1404,8 @@ namespace hpx { namespace threads { namespace policies
                     std::size_t right = (num_thread + i) % num_threads;
                     if (f(right))
                     {
-                        victim_threads_[num_thread].push_back(right);
+                        victim_threads_[num_thread].push_back(
+                            victim_thread(right, level));
                     }
                 }
             };
@@ -1115,7 +1415,8 @@ namespace hpx { namespace threads { namespace policies
                 [&](std::size_t other_num_thread)
                 {
                     return any(core_mask & core_masks[other_num_thread]);
-                }
+                },
+                steal_core
             );
 
             // check for threads which share the same numa domain...
@@ -1125,23 +1426,30 @@ namespace hpx { namespace threads { namespace policies
                     return
                         !any(core_mask & core_masks[other_num_thread])
                         && any(numa_mask & numa_masks[other_num_thread]);
-                }
+                },
+                steal_socket
             );
 
-            // check for the rest and if we are numa aware
-            if (numa_sensitive_ != 2 && any(first_mask & pu_mask))
+            // check for the rest and if we are numa aware, hierarchical
+            // stealing allows for all threads to steal remotely (subject to
+            // back-off)
+            if (numa_sensitive_ != 2 &&
+                (hierarchical_stealing_ || any(first_mask & pu_mask)))
             {
                 iterate(
                     [&](std::size_t other_num_thread)
                     {
                         return !any(numa_mask & numa_masks[other_num_thread]);
-                    }
+                    },
+                    steal_remote
                 );
             }
         }
 
         void on_stop_thread(std::size_t num_thread)
         {
+            flush_terminated_threads(num_thread);
+
             if (num_thread < high_priority_queues_.size())
                 high_priority_queues_[num_thread]->on_stop_thread(num_thread);
             if (num_thread == queues_.size()-1)
@@ -1166,6 +1474,195 @@ namespace hpx { namespace threads { namespace policies
         }
 
     protected:
+        ///////////////////////////////////////////////////////////////////////
+        // the levels of the stealing hierarchy, ordered by distance
+        enum steal_level
+        {
+            steal_core = 0,     // threads sharing our core
+            steal_socket = 1,   // threads sharing our socket or NUMA domain
+            steal_remote = 2,   // threads located in other NUMA domains
+            num_steal_levels = 3
+        };
+
+        struct victim_thread
+        {
+            victim_thread(std::size_t num_thread, steal_level level)
+              : num_thread_(num_thread), level_(level)
+            {}
+
+            std::size_t num_thread_;
+            steal_level level_;
+        };
+
+        // remote stealing back-off state, this is touched by the owning OS
+        // thread only (padded to avoid false sharing)
+        struct steal_state
+        {
+            steal_state()
+              : idle_rounds_(0), remote_backoff_(1)
+            {}
+
+            std::size_t idle_rounds_;
+            std::size_t remote_backoff_;
+            char padding_[64 - 2 * sizeof(std::size_t)];
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Terminated threads owned by the queue of another worker thread are
+        // collected per owner and returned in batches, which avoids touching
+        // the owning queue for each and every terminated thread.
+        struct thread_return_batch
+        {
+            thread_return_batch()
+              : first_(nullptr), last_(nullptr), count_(0)
+            {}
+
+            threads::thread_data* first_;
+            threads::thread_data* last_;
+            std::int64_t count_;
+        };
+
+        struct thread_return_cache
+        {
+            std::vector<thread_return_batch> batches_;
+            char padding_[64 - sizeof(std::vector<thread_return_batch>)];
+        };
+
+        void cache_terminated_thread(std::size_t num_thread,
+            std::size_t owner, threads::thread_data* thrd)
+        {
+            thread_return_batch& batch =
+                thread_return_caches_[num_thread].batches_[owner];
+
+            thrd->set_next_returned(batch.first_);
+            if (batch.last_ == nullptr)
+                batch.last_ = thrd;
+            batch.first_ = thrd;
+
+            if (++batch.count_ >= thread_return_batch_size_)
+                flush_terminated_threads(owner, batch);
+        }
+
+        void flush_terminated_threads(std::size_t owner,
+            thread_return_batch& batch)
+        {
+            if (batch.count_ == 0)
+                return;
+
+            queues_[owner]->return_terminated_threads(
+                batch.first_, batch.last_, batch.count_);
+            batch = thread_return_batch();
+        }
+
+        void flush_terminated_threads(std::size_t num_thread)
+        {
+            if (num_thread >= thread_return_caches_.size())
+                return;
+
+            std::vector<thread_return_batch>& batches =
+                thread_return_caches_[num_thread].batches_;
+            for (std::size_t i = 0; i != batches.size(); ++i)
+                flush_terminated_threads(i, batches[i]);
+        }
+
+        bool may_steal_pending(thread_queue_type* q, steal_level level,
+            bool running) const
+        {
+            if (!hierarchical_stealing_ || !running)
+                return true;
+            return q->get_pending_queue_length() >=
+                min_tasks_to_steal_pending_[level];
+        }
+
+        bool may_steal_staged(thread_queue_type* q, steal_level level,
+            bool running) const
+        {
+            if (!hierarchical_stealing_ || !running)
+                return true;
+            return q->get_staged_queue_length(std::memory_order_relaxed) >=
+                min_tasks_to_steal_staged_[level];
+        }
+
+        bool steal_from_remote_allowed(std::size_t num_thread) const
+        {
+            if (!hierarchical_stealing_)
+                return true;
+
+            steal_state const& state = steal_states_[num_thread];
+            return state.idle_rounds_ >= state.remote_backoff_;
+        }
+
+        void on_stolen(std::size_t num_thread, steal_level level,
+            std::size_t num = 1)
+        {
+            if (level == steal_remote)
+            {
+                queues_[num_thread]->increment_num_stolen_remote(num);
+
+                // a successful remote steal resets the back-off
+                steal_state& state = steal_states_[num_thread];
+                state.idle_rounds_ = 0;
+                state.remote_backoff_ = 1;
+            }
+            else
+            {
+                queues_[num_thread]->increment_num_stolen_local(num);
+            }
+        }
+
+        void on_steal_failed(std::size_t num_thread, bool tried_remote)
+        {
+            if (!hierarchical_stealing_)
+                return;
+
+            steal_state& state = steal_states_[num_thread];
+            if (tried_remote)
+            {
+                // double the number of idle rounds to wait before trying to
+                // steal from a remote NUMA domain again
+                state.idle_rounds_ = 0;
+                state.remote_backoff_ = (std::min)(
+                    2 * state.remote_backoff_, max_remote_steal_backoff_);
+            }
+            else
+            {
+                ++state.idle_rounds_;
+            }
+        }
+
+        // threads which end up in one of the queues_ and for which the queue
+        // can be chosen freely
+        static bool is_default_queue_thread(thread_init_data const& data)
+        {
+            return data.num_os_thread == std::size_t(-1) &&
+                data.priority != thread_priority_high_recursive &&
+                data.priority != thread_priority_high &&
+                data.priority != thread_priority_boost &&
+                data.priority != thread_priority_low;
+        }
+
+        // select the first queue starting at the given one which belongs to
+        // an OS thread that hasn't been disabled
+        std::size_t select_enabled_queue(std::size_t num_thread) const
+        {
+            std::size_t const queue_size = queues_.size();
+            std::size_t const thread_offset = parent_pool_->get_thread_offset();
+            mask_cref_type used_pus =
+                parent_pool_->get_used_processing_units();
+
+            for (std::size_t i = 0; i != queue_size; ++i)
+            {
+                std::size_t const num = (num_thread + i) % queue_size;
+
+                auto mask = rp_.get_pu_mask(num + thread_offset);
+                if (!threads::any(mask))
+                    threads::set(mask, num + thread_offset);
+                if (bit_and(mask, used_pus))
+                    return num;
+            }
+            return num_thread;
+        }
+
         std::size_t max_queue_thread_count_;
         std::vector<thread_queue_type*> queues_;
         std::vector<thread_queue_type*> high_priority_queues_;
@@ -1173,7 +1670,16 @@ namespace hpx { namespace threads { namespace policies
         std::atomic<std::size_t> curr_queue_;
         std::size_t numa_sensitive_;
 
-        std::vector<std::vector<std::size_t> > victim_threads_;
+        bool hierarchical_stealing_;
+        std::size_t max_remote_steal_backoff_;
+        std::int64_t min_tasks_to_steal_pending_[num_steal_levels];
+        std::int64_t min_tasks_to_steal_staged_[num_steal_levels];
+        std::vector<steal_state> steal_states_;
+
+        std::int64_t thread_return_batch_size_;
+        std::vector<thread_return_cache> thread_return_caches_;
+
+        std::vector<std::vector<victim_thread> > victim_threads_;
 
         resource::detail::partitioner& rp_;
     };
@@ -177,6 +177,40 @@ namespace hpx { namespace threads { namespace policies
         }
 #endif
 
+        std::int64_t get_num_task_descriptions_reused(std::size_t num_thread, bool reset)
+        {
+            std::int64_t num_reused = 0;
+            if (num_thread == std::size_t(-1))
+            {
+                for (std::size_t i = 0; i != queues_.size(); ++i)
+                    num_reused += queues_[i]->
+                        get_num_task_descriptions_reused(reset);
+
+                return num_reused;
+            }
+
+            num_reused += queues_[num_thread]->
+                get_num_task_descriptions_reused(reset);
+            return num_reused;
+        }
+
+        std::int64_t get_num_task_descriptions_allocated(std::size_t num_thread, bool reset)
+        {
+            std::int64_t num_allocated = 0;
+            if (num_thread == std::size_t(-1))
+            {
+                for (std::size_t i = 0; i != queues_.size(); ++i)
+                    num_allocated += queues_[i]->
+                        get_num_task_descriptions_allocated(reset);
+
+                return num_allocated;
+            }
+
+            num_allocated += queues_[num_thread]->
+                get_num_task_descriptions_allocated(reset);
+            return num_allocated;
+        }
+
 #ifdef HPX_HAVE_THREAD_STEALING_COUNTS
         std::int64_t get_num_pending_misses(std::size_t num_thread, bool reset)
         {
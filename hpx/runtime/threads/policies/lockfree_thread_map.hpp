@@ -0,0 +1,231 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_RUNTIME_THREADS_POLICIES_LOCKFREE_THREAD_MAP_HPP)
+#define HPX_RUNTIME_THREADS_POLICIES_LOCKFREE_THREAD_MAP_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace threads { namespace policies
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // This is an intrusive, lock-free registry of all thread objects which
+    // have been created by one thread_queue.
+    //
+    // Thread objects stay registered while they are sitting in the recycle
+    // heaps of their queue. Registering a new object is a single CAS on the
+    // list head, marking an object as recycled or as live again is a single
+    // store, thus neither creating nor terminating a thread needs to acquire
+    // a lock.
+    //
+    // Only physically removing discarded objects (sweep) and iterating over
+    // the live objects must not run concurrently with each other. The owning
+    // thread_queue uses its mutex to serialize those (rare) operations.
+    class lockfree_thread_map
+    {
+    public:
+        enum entry_state
+        {
+            entry_live = 0,         // the thread object is in use
+            entry_recycled = 1,     // the thread object is in a recycle heap
+            entry_discarded = 2     // the thread object will be released
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // iterates over all live entries
+        class const_iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef thread_id_type value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef thread_id_type const* pointer;
+            typedef thread_id_type reference;
+
+            explicit const_iterator(thread_data* curr = nullptr)
+              : curr_(curr)
+            {
+                skip_inactive();
+            }
+
+            thread_id_type operator*() const
+            {
+                return thread_id_type(curr_);
+            }
+
+            const_iterator& operator++()
+            {
+                curr_ = curr_->map_next_;
+                skip_inactive();
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator tmp(*this);
+                ++*this;
+                return tmp;
+            }
+
+            friend bool operator==(const_iterator const& lhs,
+                const_iterator const& rhs)
+            {
+                return lhs.curr_ == rhs.curr_;
+            }
+            friend bool operator!=(const_iterator const& lhs,
+                const_iterator const& rhs)
+            {
+                return lhs.curr_ != rhs.curr_;
+            }
+
+        private:
+            void skip_inactive()
+            {
+                while (curr_ != nullptr &&
+                    curr_->map_state_.load(std::memory_order_acquire) !=
+                        entry_live)
+                {
+                    curr_ = curr_->map_next_;
+                }
+            }
+
+            thread_data* curr_;
+        };
+
+        typedef const_iterator iterator;
+
+        ///////////////////////////////////////////////////////////////////////
+        lockfree_thread_map()
+          : head_(nullptr)
+        {}
+
+        ~lockfree_thread_map()
+        {
+            clear();
+        }
+
+        HPX_NON_COPYABLE(lockfree_thread_map);
+
+        // Register a newly created thread object, the map holds a reference
+        // to it until it gets discarded and swept.
+        void insert(thread_data* thrd)
+        {
+            intrusive_ptr_add_ref(thrd);
+            thrd->map_state_.store(entry_live, std::memory_order_relaxed);
+
+            thread_data* head = head_.load(std::memory_order_relaxed);
+            do {
+                thrd->map_next_ = head;
+            } while (!head_.compare_exchange_weak(head, thrd,
+                std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        // Mark a registered thread object as being (re-)used
+        static void mark_live(thread_data* thrd)
+        {
+            HPX_ASSERT(thrd->map_state_.load(std::memory_order_relaxed) ==
+                entry_recycled);
+            thrd->map_state_.store(entry_live, std::memory_order_release);
+        }
+
+        // Mark a registered thread object as being recycled, this has to
+        // happen before it is made available for reuse.
+        static void mark_recycled(thread_data* thrd)
+        {
+            HPX_ASSERT(thrd->map_state_.load(std::memory_order_relaxed) ==
+                entry_live);
+            thrd->map_state_.store(entry_recycled, std::memory_order_release);
+        }
+
+        // Mark a registered thread object to be released by the next sweep
+        static void mark_discarded(thread_data* thrd)
+        {
+            HPX_ASSERT(thrd->map_state_.load(std::memory_order_relaxed) ==
+                entry_live);
+            thrd->map_state_.store(entry_discarded, std::memory_order_release);
+        }
+
+        // Unlink all discarded entries and release the references held for
+        // them. This may run concurrently with insert(), but not with another
+        // sweep or with an iteration over the map.
+        std::size_t sweep()
+        {
+            std::size_t swept = 0;
+
+            // the list head is the only location modified by insert()
+            thread_data* head = head_.load(std::memory_order_acquire);
+            while (head != nullptr &&
+                head->map_state_.load(std::memory_order_acquire) ==
+                    entry_discarded)
+            {
+                thread_data* next = head->map_next_;
+                if (head_.compare_exchange_strong(head, next,
+                        std::memory_order_acq_rel))
+                {
+                    intrusive_ptr_release(head);
+                    ++swept;
+                    head = next;
+                }
+                // otherwise 'head' now refers to the newly inserted entry
+            }
+
+            if (head == nullptr)
+                return swept;
+
+            thread_data* prev = head;
+            thread_data* curr = prev->map_next_;
+            while (curr != nullptr)
+            {
+                if (curr->map_state_.load(std::memory_order_acquire) ==
+                    entry_discarded)
+                {
+                    prev->map_next_ = curr->map_next_;
+                    intrusive_ptr_release(curr);
+                    ++swept;
+                }
+                else
+                {
+                    prev = curr;
+                }
+                curr = prev->map_next_;
+            }
+            return swept;
+        }
+
+        // Release all registered thread objects, this must not run
+        // concurrently with any other operation on the map.
+        void clear()
+        {
+            thread_data* curr = head_.exchange(nullptr);
+            while (curr != nullptr)
+            {
+                thread_data* next = curr->map_next_;
+                intrusive_ptr_release(curr);
+                curr = next;
+            }
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator(head_.load(std::memory_order_acquire));
+        }
+        const_iterator end() const
+        {
+            return const_iterator();
+        }
+
+    private:
+        std::atomic<thread_data*> head_;
+    };
+}}}
+
+#endif
@@ -13,6 +13,9 @@
 #include <hpx/runtime/parcelset_fwd.hpp>
 #include <hpx/runtime/resource/detail/partitioner.hpp>
 #include <hpx/runtime/threads/detail/thread_pool_base.hpp>
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+#include <hpx/runtime/threads/policies/idle_backoff.hpp>
+#endif
 #include <hpx/runtime/threads/policies/scheduler_mode.hpp>
 #include <hpx/runtime/threads/thread_init_data.hpp>
 #include <hpx/state.hpp>
@@ -74,7 +77,7 @@ namespace hpx { namespace threads { namespace policies
                 scheduler_mode mode = nothing_special)
           : mode_(mode)
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-          , wait_count_(0)
+          , idle_backoff_(num_threads)
 #endif
           , states_(num_threads)
           , description_(description)
@@ -112,15 +115,27 @@ namespace hpx { namespace threads { namespace policies
 
         char const* get_description() const { return description_; }
 
-        void idle_callback(std::size_t /*num_thread*/)
+        void idle_callback(std::size_t num_thread)
         {
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-            // Put this thread to sleep for some time, additionally it gets
-            // woken up on new work.
-            std::chrono::milliseconds period(++wait_count_);
+            // Back off increasingly aggressively, eventually putting this
+            // thread to sleep until it gets woken up on new work. Don't go
+            // to sleep while the parcel layer relies on being polled.
+            idle_backoff_.on_idle(num_thread,
+                [this]() -> bool
+                {
+                    return this->get_queue_length() != 0 ||
+                        hpx::parcelset::has_pending_background_work();
+                });
+#endif
+        }
 
-            std::unique_lock<compat::mutex> l(mtx_);
-            cond_.wait_for(l, period);
+        // This function gets called by a worker thread which has found work
+        // after having backed off.
+        void reset_idle_backoff(std::size_t num_thread)
+        {
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            idle_backoff_.reset(num_thread);
 #endif
         }
 
@@ -131,7 +146,7 @@ namespace hpx { namespace threads { namespace policies
                 result = true;
 
             if (0 == num_thread)
-                hpx::agas::garbage_collect_non_blocking();
+                hpx::agas::garbage_collect_expired_non_blocking();
             return result;
         }
 
@@ -141,15 +156,39 @@ namespace hpx { namespace threads { namespace policies
         void do_some_work(std::size_t num_thread)
         {
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-            wait_count_.store(0, std::memory_order_release);
+            // wake up exactly one parked thread, preferably the one owning
+            // the queue the new work has been added to
+            idle_backoff_.notify_one(num_thread);
+#endif
+        }
 
-            if (num_thread == std::size_t(-1))
-                cond_.notify_all();
-            else
-                cond_.notify_one();
+        // wake up all OS threads, e.g. for shutting down
+        void do_some_work_all()
+        {
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            idle_backoff_.notify_all();
+            cond_.notify_all();
 #endif
         }
 
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+        std::int64_t get_num_idle_parks(std::size_t num_thread, bool reset)
+        {
+            return idle_backoff_.get_park_count(num_thread, reset);
+        }
+
+        std::int64_t get_num_idle_unparks(std::size_t num_thread, bool reset)
+        {
+            return idle_backoff_.get_unpark_count(num_thread, reset);
+        }
+
+        std::int64_t get_average_unpark_latency(
+            std::size_t num_thread, bool reset)
+        {
+            return idle_backoff_.get_average_unpark_latency(num_thread, reset);
+        }
+#endif
+
         // allow to access/manipulate states
         std::atomic<hpx::state>& get_state(std::size_t num_thread)
         {
@@ -279,6 +318,27 @@ namespace hpx { namespace threads { namespace policies
         virtual std::uint64_t get_cleanup_time(bool reset) = 0;
 #endif
 
+        // number of staged task descriptions which were reused from (or
+        // had to be newly allocated for) the freelists of the queues
+        virtual std::int64_t get_num_task_descriptions_reused(
+            std::size_t num_thread, bool reset)
+        {
+            return 0;
+        }
+        virtual std::int64_t get_num_task_descriptions_allocated(
+            std::size_t num_thread, bool reset)
+        {
+            return 0;
+        }
+
+        // number of thread objects which were terminated on a worker thread
+        // other than the one owning them and were handed back in batches
+        virtual std::int64_t get_num_cross_worker_frees(
+            std::size_t num_thread, bool reset)
+        {
+            return 0;
+        }
+
 #ifdef HPX_HAVE_THREAD_STEALING_COUNTS
         virtual std::int64_t get_num_pending_misses(std::size_t num_thread,
             bool reset) = 0;
@@ -293,6 +353,26 @@ namespace hpx { namespace threads { namespace policies
             bool reset) = 0;
         virtual std::int64_t get_num_stolen_to_staged(std::size_t num_thread,
             bool reset) = 0;
+
+        // number of items stolen from within the same NUMA domain (or from
+        // other NUMA domains) by the given thread
+        virtual std::int64_t get_num_stolen_local(std::size_t num_thread,
+            bool reset)
+        {
+            return 0;
+        }
+        virtual std::int64_t get_num_stolen_remote(std::size_t num_thread,
+            bool reset)
+        {
+            return 0;
+        }
+
+        // number of continuations stolen from the given thread
+        virtual std::int64_t get_num_stolen_continuations(
+            std::size_t num_thread, bool reset)
+        {
+            return 0;
+        }
 #endif
 
         virtual std::int64_t get_queue_length(
@@ -317,6 +397,21 @@ namespace hpx { namespace threads { namespace policies
             thread_state_enum initial_state, bool run_now, error_code& ec,
             std::size_t num_thread) = 0;
 
+        // Create count new threads at once without running any of them
+        // right away. Schedulers able to distribute a whole batch of threads
+        // over their queues in one go should override this, the default
+        // creates the threads one by one.
+        virtual void create_threads(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state, error_code& ec)
+        {
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                create_thread(data[i], nullptr, initial_state, false, ec,
+                    data[i].num_os_thread);
+                if (ec) return;
+            }
+        }
+
         virtual bool get_next_thread(std::size_t num_thread, bool running,
             std::int64_t& idle_loop_count, threads::thread_data*& thrd) = 0;
 
@@ -327,6 +422,16 @@ namespace hpx { namespace threads { namespace policies
             std::size_t num_thread,
             thread_priority priority = thread_priority_normal) = 0;
 
+        // Schedule the continuation of a thread which has yielded to a child
+        // thread it has just created (see launch::fork). Schedulers which
+        // support work-first execution make the continuation available for
+        // stealing while the child is running.
+        virtual void schedule_continuation(threads::thread_data* thrd,
+            std::size_t num_thread)
+        {
+            schedule_thread_last(thrd, num_thread);
+        }
+
         virtual bool destroy_thread(threads::thread_data* thrd,
             std::int64_t& busy_count) = 0;
 
@@ -356,9 +461,11 @@ namespace hpx { namespace threads { namespace policies
 
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
         // support for suspension on idle queues
+        idle_backoff idle_backoff_;
+
+        // used by derived schedulers to suspend disabled OS threads
         compat::mutex mtx_;
         compat::condition_variable cond_;
-        std::atomic<std::uint32_t> wait_count_;
 #endif
 
         std::vector<std::atomic<hpx::state> > states_;
@@ -12,6 +12,7 @@
 #include <hpx/error_code.hpp>
 #include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
+#include <hpx/runtime/threads/policies/lockfree_thread_map.hpp>
 #include <hpx/runtime/threads/policies/queue_helpers.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/throw_exception.hpp>
@@ -20,7 +21,7 @@
 #include <hpx/util/function.hpp>
 #include <hpx/util/get_and_reset_value.hpp>
 #include <hpx/util/high_resolution_clock.hpp>
-#include <hpx/util/unlock_guard.hpp>
+#include <hpx/util/lockfree/freelist.hpp>
 
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
 #   include <hpx/util/tick_counter.hpp>
@@ -33,12 +34,11 @@
 #include <cstdint>
 #include <exception>
 #include <functional>
-#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <string>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -95,6 +95,51 @@ namespace hpx { namespace threads { namespace policies
             return min_tasks_to_steal_staged;
         }
 
+        // thresholds used for stealing from worker threads which share a
+        // socket (but not a core) and from worker threads which are located
+        // in a different NUMA domain (hierarchical stealing only)
+        inline int get_min_tasks_to_steal_pending_socket()
+        {
+            static int min_tasks_to_steal_pending_socket =
+                boost::lexical_cast<int>(hpx::get_config_entry(
+                    "hpx.thread_queue.min_tasks_to_steal_pending_socket", "0"));
+            return min_tasks_to_steal_pending_socket;
+        }
+
+        inline int get_min_tasks_to_steal_staged_socket()
+        {
+            static int min_tasks_to_steal_staged_socket =
+                boost::lexical_cast<int>(hpx::get_config_entry(
+                    "hpx.thread_queue.min_tasks_to_steal_staged_socket", "10"));
+            return min_tasks_to_steal_staged_socket;
+        }
+
+        inline int get_min_tasks_to_steal_pending_remote()
+        {
+            static int min_tasks_to_steal_pending_remote =
+                boost::lexical_cast<int>(hpx::get_config_entry(
+                    "hpx.thread_queue.min_tasks_to_steal_pending_remote", "4"));
+            return min_tasks_to_steal_pending_remote;
+        }
+
+        inline int get_min_tasks_to_steal_staged_remote()
+        {
+            static int min_tasks_to_steal_staged_remote =
+                boost::lexical_cast<int>(hpx::get_config_entry(
+                    "hpx.thread_queue.min_tasks_to_steal_staged_remote", "20"));
+            return min_tasks_to_steal_staged_remote;
+        }
+
+        // maximal number of idle rounds a worker thread waits before trying
+        // to steal from a remote NUMA domain (hierarchical stealing only)
+        inline int get_max_remote_steal_backoff()
+        {
+            static int max_remote_steal_backoff =
+                boost::lexical_cast<int>(hpx::get_config_entry(
+                    "hpx.thread_queue.max_remote_steal_backoff", "64"));
+            return max_remote_steal_backoff;
+        }
+
         inline int get_min_add_new_count()
         {
             static int min_add_new_count =
@@ -127,6 +172,17 @@ namespace hpx { namespace threads { namespace policies
                     std::to_string(HPX_SCHEDULER_MAX_TERMINATED_THREADS)));
             return max_terminated_threads;
         }
+
+        // number of thread objects terminated on a worker thread other than
+        // the owning one which are collected before being handed back to the
+        // owning queue in one go
+        inline int get_thread_return_batch_size()
+        {
+            static int thread_return_batch_size =
+                boost::lexical_cast<int>(hpx::get_config_entry(
+                    "hpx.thread_queue.thread_return_batch_size", "16"));
+            return thread_return_batch_size;
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -188,7 +244,10 @@ namespace hpx { namespace threads { namespace policies
         int const max_terminated_threads;
 
         // this is the type of a map holding all threads (except depleted ones)
-        typedef std::unordered_set<thread_id_type> thread_map_type;
+        typedef lockfree_thread_map thread_map_type;
+
+        // this is the type of the heaps holding thread objects to be reused
+        typedef lockfree_lifo::apply<thread_data*>::type thread_heap_type;
 
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
         typedef
@@ -198,6 +257,11 @@ namespace hpx { namespace threads { namespace policies
         typedef util::tuple<thread_init_data, thread_state_enum> task_description;
 #endif
 
+        // staged tasks are described by objects allocated from a per-queue
+        // freelist, thus staging a task usually does not allocate any memory
+        typedef boost::lockfree::caching_freelist<task_description>
+            task_description_pool_type;
+
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
         typedef util::tuple<thread_data*, std::uint64_t> thread_description;
 #else
@@ -213,56 +277,104 @@ namespace hpx { namespace threads { namespace policies
         typedef typename TerminatedQueuing::template
             apply<thread_data*>::type terminated_items_type;
 
+        // continuations of threads which have yielded to a child they have
+        // just created (work-first execution, see launch::fork), the owning
+        // worker always resumes the most recent one, other workers steal from
+        // the opposite end where the queuing supports it
+#if defined(HPX_HAVE_ABP_SCHEDULER)
+        typedef lockfree_abp_lifo::apply<thread_data*>::type
+            continuation_items_type;
+#else
+        typedef lockfree_lifo::apply<thread_data*>::type
+            continuation_items_type;
+#endif
+
     protected:
-        template <typename Lock>
-        void create_thread_object(threads::thread_id_type& thrd,
-            threads::thread_init_data& data, thread_state_enum state, Lock& lk)
+        template <typename... Ts>
+        task_description* create_task_description(Ts&&... vs)
         {
-            HPX_ASSERT(lk.owns_lock());
-            HPX_ASSERT(data.stacksize != 0);
-
-            std::ptrdiff_t stacksize = data.stacksize;
-
-            std::list<thread_id_type>* heap = nullptr;
-
-            if (stacksize == get_stack_size(thread_stacksize_small))
+            task_description* task = task_description_pool_.try_allocate();
+            if (task != nullptr)
             {
-                heap = &thread_heap_small_;
+                ++task_descriptions_reused_;
             }
-            else if (stacksize == get_stack_size(thread_stacksize_medium))
+            else
             {
-                heap = &thread_heap_medium_;
+                task = task_description_pool_.allocate();
+                if (task == nullptr)
+                {
+                    HPX_THROW_EXCEPTION(out_of_memory,
+                        "thread_queue::create_task_description",
+                        "could not allocate memory for task description");
+                }
+                ++task_descriptions_allocated_;
             }
-            else if (stacksize == get_stack_size(thread_stacksize_large))
-            {
-                heap = &thread_heap_large_;
+
+            try {
+                return new (task) task_description(std::forward<Ts>(vs)...);
             }
-            else if (stacksize == get_stack_size(thread_stacksize_huge))
-            {
-                heap = &thread_heap_huge_;
+            catch (...) {
+                task_description_pool_.deallocate(task);
+                throw;
             }
-            else {
-                switch(stacksize) {
-                case thread_stacksize_small:
-                    heap = &thread_heap_small_;
-                    break;
+        }
 
-                case thread_stacksize_medium:
-                    heap = &thread_heap_medium_;
-                    break;
+        // Task descriptions might have been staged on a different queue,
+        // they are returned to the freelist of the queue which consumes them.
+        // All freelists use the same allocator, so this is safe.
+        void destroy_task_description(task_description* task)
+        {
+            task->~task_description();
+            task_description_pool_.deallocate(task);
+        }
 
-                case thread_stacksize_large:
-                    heap = &thread_heap_large_;
-                    break;
+        thread_heap_type* get_thread_heap(std::ptrdiff_t stacksize)
+        {
+            if (stacksize == get_stack_size(thread_stacksize_small))
+                return &thread_heap_small_;
 
-                case thread_stacksize_huge:
-                    heap = &thread_heap_huge_;
-                    break;
+            if (stacksize == get_stack_size(thread_stacksize_medium))
+                return &thread_heap_medium_;
 
-                default:
-                    break;
-                }
+            if (stacksize == get_stack_size(thread_stacksize_large))
+                return &thread_heap_large_;
+
+            if (stacksize == get_stack_size(thread_stacksize_huge))
+                return &thread_heap_huge_;
+
+            if (stacksize == HPX_NOSTACK_STACK_SIZE)
+                return &thread_heap_nostack_;
+
+            switch(stacksize) {
+            case thread_stacksize_small:
+                return &thread_heap_small_;
+
+            case thread_stacksize_medium:
+                return &thread_heap_medium_;
+
+            case thread_stacksize_large:
+                return &thread_heap_large_;
+
+            case thread_stacksize_huge:
+                return &thread_heap_huge_;
+
+            case thread_stacksize_nostack:
+                return &thread_heap_nostack_;
+
+            default:
+                break;
             }
+            return nullptr;
+        }
+
+        // This does not need to acquire the queue's mutex, both the heaps of
+        // unused thread objects and the map of threads are lock-free.
+        void create_thread_object(threads::thread_id_type& thrd,
+            threads::thread_init_data& data, thread_state_enum state)
+        {
+            HPX_ASSERT(data.stacksize != 0);
+
+            thread_heap_type* heap = get_thread_heap(data.stacksize);
             HPX_ASSERT(heap);
 
             if (state == pending_do_not_schedule || state == pending_boost)
@@ -271,21 +383,25 @@ namespace hpx { namespace threads { namespace policies
             }
 
             // Check for an unused thread object.
-            if (!heap->empty())
+            thread_data* p = nullptr;
+            if (heap->pop(p))
             {
-                // Take ownership of the thread object and rebind it.
-                thrd = heap->front();
-                heap->pop_front();
+                // Take ownership of the thread object and rebind it. The
+                // object is marked live only once it has been fully
+                // re-initialized, as concurrent map walkers may inspect it
+                // as soon as it is live.
+                thrd = p;
                 thrd->rebind(data, state);
+                thread_map_type::mark_live(p);
             }
-
             else
             {
-                hpx::util::unlock_guard<Lock> ull(lk);
-
-                // Allocate a new thread object.
+                // Allocate a new thread object and register it with the map
+                // of threads.
                 thrd = threads::thread_data::create(data, memory_pool_, state);
+                thread_map_.insert(thrd.get());
             }
+            ++thread_map_count_;
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -319,22 +435,9 @@ namespace hpx { namespace threads { namespace policies
                 thread_state_enum state = util::get<1>(*task);
                 threads::thread_id_type thrd;
 
-                create_thread_object(thrd, data, state, lk);
-
-                delete task;
+                create_thread_object(thrd, data, state);
 
-                // add the new entry to the map of all threads
-                std::pair<thread_map_type::iterator, bool> p =
-                    thread_map_.insert(thrd);
-
-                if (HPX_UNLIKELY(!p.second)) {
-                    lk.unlock();
-                    HPX_THROW_EXCEPTION(hpx::out_of_memory,
-                        "threadmanager::add_new",
-                        "Couldn't add new thread to the thread map");
-                    return 0;
-                }
-                ++thread_map_count_;
+                destroy_task_description(task);
 
                 // only insert the thread into the work-items queue if it is in
                 // pending state
@@ -345,8 +448,6 @@ namespace hpx { namespace threads { namespace policies
                     schedule_thread(thrd.get());
                 }
 
-                // this thread has to be in the map now
-                HPX_ASSERT(thread_map_.find(thrd.get()) != thread_map_.end());
                 HPX_ASSERT(thrd->get_pool() == &memory_pool_);
             }
 
@@ -372,7 +473,8 @@ namespace hpx { namespace threads { namespace policies
             // if we are desperate (no work in the queues), add some even if the
             // map holds more than max_count
             if (HPX_LIKELY(max_count_)) {
-                std::size_t count = thread_map_.size();
+                std::size_t count =
+                    static_cast<std::size_t>(thread_map_count_.load());
                 if (max_count_ >= count + min_add_new_count) { //-V104
                     HPX_ASSERT(max_count_ - count <
                         static_cast<std::size_t>(
@@ -398,118 +500,134 @@ namespace hpx { namespace threads { namespace policies
             return addednew != 0;
         }
 
-        void recycle_thread(thread_id_type thrd)
+        void recycle_thread(thread_data* thrd)
         {
-            std::ptrdiff_t stacksize = thrd->get_stack_size();
+            thread_heap_type* heap = get_thread_heap(thrd->get_stack_size());
+            HPX_ASSERT(heap);
 
-            if (stacksize == get_stack_size(thread_stacksize_small))
-            {
-                thread_heap_small_.push_front(thrd);
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_medium))
-            {
-                thread_heap_medium_.push_front(thrd);
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_large))
-            {
-                thread_heap_large_.push_front(thrd);
-            }
-            else if (stacksize == get_stack_size(thread_stacksize_huge))
+            // the thread object has to be marked as recycled before it can
+            // be picked up by create_thread_object()
+            thread_map_type::mark_recycled(thrd);
+            heap->push(thrd);
+        }
+
+        // Take ownership of all thread objects handed back by other worker
+        // threads (see return_terminated_threads()).
+        thread_data* take_returned_threads()
+        {
+            if (returned_items_.load(std::memory_order_relaxed) == nullptr)
+                return nullptr;
+            return returned_items_.exchange(nullptr, std::memory_order_acquire);
+        }
+
+    public:
+        /// This function makes sure all threads which are marked for deletion
+        /// (state is terminated) are made available for reuse. It does not
+        /// need to acquire the queue's mutex.
+        ///
+        /// This returns 'true' if there are no more terminated threads waiting
+        /// to be deleted.
+        bool cleanup_terminated_helper()
+        {
+#ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
+            util::tick_counter tc(cleanup_terminated_time_);
+#endif
+
+            if (terminated_items_count_ == 0)
+                return true;
+
+            // recycle all batches returned by other worker threads
+            thread_data* todelete = take_returned_threads();
+            while (todelete != nullptr)
             {
-                thread_heap_huge_.push_front(thrd);
+                thread_data* next = todelete->get_next_returned();
+                todelete->set_next_returned(nullptr);
+
+                --terminated_items_count_;
+
+                recycle_thread(todelete);
+
+                --thread_map_count_;
+                HPX_ASSERT(thread_map_count_ >= 0);
+
+                todelete = next;
             }
-            else
-            {
-                switch(stacksize) {
-                case thread_stacksize_small:
-                    thread_heap_small_.push_front(thrd);
-                    break;
 
-                case thread_stacksize_medium:
-                    thread_heap_medium_.push_front(thrd);
-                    break;
+            // recycle only this many threads
+            std::int64_t delete_count =
+                (std::max)(
+                    static_cast<std::int64_t>(terminated_items_count_ / 10),
+                    static_cast<std::int64_t>(max_delete_count));
 
-                case thread_stacksize_large:
-                    thread_heap_large_.push_front(thrd);
-                    break;
+            while (delete_count && terminated_items_.pop(todelete))
+            {
+                --terminated_items_count_;
 
-                case thread_stacksize_huge:
-                    thread_heap_huge_.push_front(thrd);
-                    break;
+                recycle_thread(todelete);
 
-                default:
-                    HPX_ASSERT(false);
-                    break;
-                }
+                --thread_map_count_;
+                HPX_ASSERT(thread_map_count_ >= 0);
+
+                --delete_count;
             }
+            return terminated_items_count_ == 0;
         }
 
-    public:
         /// This function makes sure all threads which are marked for deletion
-        /// (state is terminated) are properly destroyed.
+        /// (state is terminated) are properly destroyed. The queue's mutex
+        /// has to be held by the caller as the map of threads is swept.
         ///
         /// This returns 'true' if there are no more terminated threads waiting
         /// to be deleted.
         bool cleanup_terminated_locked_helper(bool delete_all = false)
         {
+            if (!delete_all)
+                return cleanup_terminated_helper();
+
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
             util::tick_counter tc(cleanup_terminated_time_);
 #endif
 
-            if (terminated_items_count_ == 0 && thread_map_.empty())
+            if (terminated_items_count_ == 0)
                 return true;
 
-            if (delete_all) {
-                // delete all threads
-                thread_data* todelete;
-                while (terminated_items_.pop(todelete))
-                {
-                    --terminated_items_count_;
+            // delete all threads
+            thread_data* todelete = take_returned_threads();
+            while (todelete != nullptr)
+            {
+                thread_data* next = todelete->get_next_returned();
+                todelete->set_next_returned(nullptr);
 
-                    // this thread has to be in this map
-                    HPX_ASSERT(thread_map_.find(todelete) != thread_map_.end());
+                --terminated_items_count_;
 
-                    bool deleted = thread_map_.erase(todelete) != 0;
-                    HPX_ASSERT(deleted);
-                    if (deleted) {
-                        --thread_map_count_;
-                        HPX_ASSERT(thread_map_count_ >= 0);
-                    }
-                }
-            }
-            else {
-                // delete only this many threads
-                std::int64_t delete_count =
-                    (std::max)(
-                        static_cast<std::int64_t>(terminated_items_count_ / 10),
-                        static_cast<std::int64_t>(max_delete_count));
-
-                thread_data* todelete;
-                while (delete_count && terminated_items_.pop(todelete))
-                {
-                    --terminated_items_count_;
+                thread_map_type::mark_discarded(todelete);
 
-                    thread_map_type::iterator it = thread_map_.find(todelete);
+                --thread_map_count_;
+                HPX_ASSERT(thread_map_count_ >= 0);
 
-                    // this thread has to be in this map
-                    HPX_ASSERT(it != thread_map_.end());
+                todelete = next;
+            }
 
-                    recycle_thread(*it);
+            while (terminated_items_.pop(todelete))
+            {
+                --terminated_items_count_;
 
-                    thread_map_.erase(it);
-                    --thread_map_count_;
-                    HPX_ASSERT(thread_map_count_ >= 0);
+                thread_map_type::mark_discarded(todelete);
 
-                    --delete_count;
-                }
+                --thread_map_count_;
+                HPX_ASSERT(thread_map_count_ >= 0);
             }
+
+            // release the discarded thread objects
+            thread_map_.sweep();
+
             return terminated_items_count_ == 0;
         }
 
         bool cleanup_terminated_locked(bool delete_all = false)
         {
             return cleanup_terminated_locked_helper(delete_all) &&
-                thread_map_.empty();
+                thread_map_count_ == 0;
         }
 
     public:
@@ -519,23 +637,14 @@ namespace hpx { namespace threads { namespace policies
                 return thread_map_count_ == 0;
 
             if (delete_all) {
-                // do not lock mutex while deleting all threads, do it piece-wise
-                bool thread_map_is_empty = false;
-                while (true)
-                {
-                    std::lock_guard<mutex_type> lk(mtx_);
-                    if (cleanup_terminated_locked_helper(false))
-                    {
-                        thread_map_is_empty =
-                            (thread_map_count_ == 0) && (new_tasks_count_ == 0);
-                        break;
-                    }
-                }
-                return thread_map_is_empty;
+                // recycle all terminated threads, do it piece-wise
+                while (!cleanup_terminated_helper())
+                    /**/;
+
+                return (thread_map_count_ == 0) && (new_tasks_count_ == 0);
             }
 
-            std::lock_guard<mutex_type> lk(mtx_);
-            return cleanup_terminated_locked_helper(false) &&
+            return cleanup_terminated_helper() &&
                 (thread_map_count_ == 0) && (new_tasks_count_ == 0);
         }
 
@@ -557,26 +666,34 @@ namespace hpx { namespace threads { namespace policies
             thread_map_count_(0),
             work_items_(128, queue_num),
             work_items_count_(0),
+            continuation_items_(16, queue_num),
+            continuation_items_count_(0),
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
             work_items_wait_(0),
             work_items_wait_count_(0),
 #endif
             terminated_items_(128),
             terminated_items_count_(0),
+            returned_items_(nullptr),
+            cross_worker_frees_(0),
             max_count_((0 == max_count)
                       ? static_cast<std::size_t>(max_thread_count)
                       : max_count),
             new_tasks_(128),
             new_tasks_count_(0),
+            task_description_pool_(128),
+            task_descriptions_reused_(0),
+            task_descriptions_allocated_(0),
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
             new_tasks_wait_(0),
             new_tasks_wait_count_(0),
 #endif
             memory_pool_(64),
-            thread_heap_small_(),
-            thread_heap_medium_(),
-            thread_heap_large_(),
-            thread_heap_huge_(),
+            thread_heap_small_(128),
+            thread_heap_medium_(128),
+            thread_heap_large_(128),
+            thread_heap_huge_(128),
+            thread_heap_nostack_(128),
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
             add_new_time_(0),
             cleanup_terminated_time_(0),
@@ -588,10 +705,20 @@ namespace hpx { namespace threads { namespace policies
             stolen_from_staged_(0),
             stolen_to_pending_(0),
             stolen_to_staged_(0),
+            stolen_local_(0),
+            stolen_remote_(0),
+            stolen_continuations_(0),
 #endif
             add_new_logger_("thread_queue::add_new")
         {}
 
+        ~thread_queue()
+        {
+            // release all thread objects (including the recycled ones) while
+            // the memory pool is still alive
+            thread_map_.clear();
+        }
+
         void set_max_count(std::size_t max_count = max_thread_count)
         {
             max_count_ = (0 == max_count) ? max_thread_count : max_count; //-V105
@@ -629,6 +756,22 @@ namespace hpx { namespace threads { namespace policies
             return new_tasks_count_.load(order);
         }
 
+        std::int64_t get_num_task_descriptions_reused(bool reset)
+        {
+            return util::get_and_reset_value(task_descriptions_reused_, reset);
+        }
+
+        std::int64_t get_num_task_descriptions_allocated(bool reset)
+        {
+            return util::get_and_reset_value(
+                task_descriptions_allocated_, reset);
+        }
+
+        std::int64_t get_num_cross_worker_frees(bool reset)
+        {
+            return util::get_and_reset_value(cross_worker_frees_, reset);
+        }
+
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
         std::uint64_t get_average_task_wait_time() const
         {
@@ -707,6 +850,36 @@ namespace hpx { namespace threads { namespace policies
         {
             stolen_to_staged_ += num;
         }
+
+        std::int64_t get_num_stolen_local(bool reset)
+        {
+            return util::get_and_reset_value(stolen_local_, reset);
+        }
+
+        void increment_num_stolen_local(std::size_t num = 1)
+        {
+            stolen_local_ += num;
+        }
+
+        std::int64_t get_num_stolen_remote(bool reset)
+        {
+            return util::get_and_reset_value(stolen_remote_, reset);
+        }
+
+        void increment_num_stolen_remote(std::size_t num = 1)
+        {
+            stolen_remote_ += num;
+        }
+
+        std::int64_t get_num_stolen_continuations(bool reset)
+        {
+            return util::get_and_reset_value(stolen_continuations_, reset);
+        }
+
+        void increment_num_stolen_continuations(std::size_t num = 1)
+        {
+            stolen_continuations_ += num;
+        }
 #else
         void increment_num_pending_misses(std::size_t num = 1) {}
         void increment_num_pending_accesses(std::size_t num = 1) {}
@@ -714,6 +887,9 @@ namespace hpx { namespace threads { namespace policies
         void increment_num_stolen_from_staged(std::size_t num = 1) {}
         void increment_num_stolen_to_pending(std::size_t num = 1) {}
         void increment_num_stolen_to_staged(std::size_t num = 1) {}
+        void increment_num_stolen_local(std::size_t num = 1) {}
+        void increment_num_stolen_remote(std::size_t num = 1) {}
+        void increment_num_stolen_continuations(std::size_t num = 1) {}
 #endif
 
         ///////////////////////////////////////////////////////////////////////
@@ -729,60 +905,85 @@ namespace hpx { namespace threads { namespace policies
             {
                 threads::thread_id_type thrd;
 
-                // The mutex can not be locked while a new thread is getting
-                // created, as it might have that the current HPX thread gets
-                // suspended.
-                {
-                    std::unique_lock<mutex_type> lk(mtx_);
-
-                    create_thread_object(thrd, data, initial_state, lk);
+                // Creating the thread object does not acquire the mutex, the
+                // thread map and the heaps of unused threads are lock-free.
+                create_thread_object(thrd, data, initial_state);
 
-                    // add a new entry in the map for this thread
-                    std::pair<thread_map_type::iterator, bool> p =
-                        thread_map_.insert(thrd);
-
-                    if (HPX_UNLIKELY(!p.second)) {
-                        HPX_THROWS_IF(ec, hpx::out_of_memory,
-                            "threadmanager::register_thread",
-                            "Couldn't add new thread to the map of threads");
-                        return;
-                    }
-                    ++thread_map_count_;
-
-                    // this thread has to be in the map now
-                    HPX_ASSERT(thread_map_.find(thrd.get()) != thread_map_.end());
-                    HPX_ASSERT(thrd->get_pool() == &memory_pool_);
+                HPX_ASSERT(thrd->get_pool() == &memory_pool_);
 
-                    // push the new thread in the pending queue thread
-                    if (initial_state == pending)
-                        schedule_thread(thrd.get());
+                // push the new thread in the pending queue thread
+                if (initial_state == pending)
+                    schedule_thread(thrd.get());
 
-                    // return the thread_id of the newly created thread
-                    if (id) *id = std::move(thrd);
+                // return the thread_id of the newly created thread
+                if (id) *id = std::move(thrd);
 
-                    if (&ec != &throws)
-                        ec = make_success_code();
-                    return;
-                }
+                if (&ec != &throws)
+                    ec = make_success_code();
+                return;
             }
 
             // do not execute the work, but register a task description for
             // later thread creation
             ++new_tasks_count_;
 
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+            // the time spent as a staged task counts as queue wait time
+            data.queue_time = util::high_resolution_clock::now();
+#endif
+
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
-            new_tasks_.push(new task_description(
+            new_tasks_.push(create_task_description(
                 std::move(data), initial_state,
                 util::high_resolution_clock::now()
             ));
 #else
-            new_tasks_.push(new task_description( //-V106
+            new_tasks_.push(create_task_description(
                 std::move(data), initial_state));
 #endif
             if (&ec != &throws)
                 ec = make_success_code();
         }
 
+        // register task descriptions for count new threads at once, the
+        // threads will be created later on by the owning worker (or by a
+        // worker stealing the staged tasks)
+        void create_threads(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state, error_code& ec)
+        {
+            if (count == 0)
+            {
+                if (&ec != &throws)
+                    ec = make_success_code();
+                return;
+            }
+
+            // publish the new tasks up front, this keeps other workers from
+            // concluding that this queue is empty while we're still pushing
+            new_tasks_count_ += static_cast<std::int64_t>(count);
+
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS) || \
+    defined(HPX_HAVE_THREAD_QUEUE_WAITTIME)
+            std::uint64_t const now = util::high_resolution_clock::now();
+#endif
+            for (std::size_t i = 0; i != count; ++i)
+            {
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+                data[i].queue_time = now;
+#endif
+#ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
+                new_tasks_.push(create_task_description(
+                    std::move(data[i]), initial_state, now));
+#else
+                new_tasks_.push(create_task_description(
+                    std::move(data[i]), initial_state));
+#endif
+            }
+
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+
         void move_work_items_from(thread_queue *src, std::int64_t count)
         {
             thread_description* trd;
@@ -844,6 +1045,20 @@ namespace hpx { namespace threads { namespace policies
             std::int64_t work_items_count =
                 work_items_count_.load(std::memory_order_relaxed);
 
+            // continuations are handed out first, the owning worker resumes
+            // the most recently forked parent, while any other worker may
+            // steal a continuation regardless of the stealing thresholds
+            if (0 != continuation_items_count_.load(std::memory_order_relaxed) &&
+                continuation_items_.pop(thrd, allow_stealing))
+            {
+                --continuation_items_count_;
+                --work_items_count_;
+
+                if (allow_stealing)
+                    increment_num_stolen_continuations();
+                return true;
+            }
+
             if (allow_stealing && min_tasks_to_steal_pending > work_items_count)
             {
                 return false;
@@ -879,6 +1094,10 @@ namespace hpx { namespace threads { namespace policies
         /// Schedule the passed thread
         void schedule_thread(threads::thread_data* thrd, bool other_end = false)
         {
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+            if (thrd->get_queue_time() == 0)
+                thrd->set_queue_time(util::high_resolution_clock::now());
+#endif
             ++work_items_count_;
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
             work_items_.push(new thread_description(
@@ -888,6 +1107,22 @@ namespace hpx { namespace threads { namespace policies
 #endif
         }
 
+        /// Schedule the continuation of the passed thread, which has yielded
+        /// to a child thread it has just created
+        void schedule_continuation(threads::thread_data* thrd)
+        {
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+            if (thrd->get_queue_time() == 0)
+                thrd->set_queue_time(util::high_resolution_clock::now());
+#endif
+            // continuations are accounted for as pending work items, this
+            // keeps all queue length based decisions (stealing, shutdown)
+            // aware of them
+            ++work_items_count_;
+            ++continuation_items_count_;
+            continuation_items_.push(thrd);
+        }
+
         /// Destroy the passed thread as it has been terminated
         bool destroy_thread(threads::thread_data* thrd, std::int64_t& busy_count)
         {
@@ -905,6 +1140,33 @@ namespace hpx { namespace threads { namespace policies
             return false;
         }
 
+        /// Return whether the given thread object was allocated from this
+        /// queue's memory pool
+        bool owns_thread(threads::thread_data* thrd) const
+        {
+            return thrd->get_pool() == &memory_pool_;
+        }
+
+        /// Hand back a batch of terminated threads owned by this queue which
+        /// were collected by another worker thread. The batch is linked
+        /// through the thread objects from \a first to \a last.
+        void return_terminated_threads(threads::thread_data* first,
+            threads::thread_data* last, std::int64_t count)
+        {
+            HPX_ASSERT(first != nullptr && last != nullptr && count > 0);
+
+            // account for the returned threads before they become visible
+            // to cleanup_terminated_helper()
+            terminated_items_count_ += count;
+            cross_worker_frees_ += count;
+
+            thread_data* head = returned_items_.load(std::memory_order_relaxed);
+            do {
+                last->set_next_returned(head);
+            } while (!returned_items_.compare_exchange_weak(head, first,
+                std::memory_order_release, std::memory_order_relaxed));
+        }
+
         ///////////////////////////////////////////////////////////////////////
         /// Return the number of existing threads with the given state.
         std::int64_t get_thread_count(thread_state_enum state = unknown) const
@@ -1091,14 +1353,19 @@ namespace hpx { namespace threads { namespace policies
         mutable mutex_type mtx_;                    ///< mutex protecting the members
 
         thread_map_type thread_map_;
-        ///< mapping of thread id's to HPX-threads
+        ///< lock-free map of all HPX-threads created by this queue
         std::atomic<std::int64_t> thread_map_count_;
         ///< overall count of work items
 
         work_items_type work_items_;
         ///< list of active work items
         std::atomic<std::int64_t> work_items_count_;
-        ///< count of active work items
+        ///< count of active work items (including continuations)
+
+        continuation_items_type continuation_items_;
+        ///< list of continuations of forking threads
+        std::atomic<std::int64_t> continuation_items_count_;
+        ///< count of continuations of forking threads
 
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
         std::atomic<std::int64_t> work_items_wait_;
@@ -1108,7 +1375,11 @@ namespace hpx { namespace threads { namespace policies
 #endif
         terminated_items_type terminated_items_;     ///< list of terminated threads
         std::atomic<std::int64_t> terminated_items_count_;
-        ///< count of terminated items
+        ///< count of terminated items (including returned ones)
+        std::atomic<thread_data*> returned_items_;
+        ///< terminated threads handed back in batches by other worker threads
+        std::atomic<std::int64_t> cross_worker_frees_;
+        ///< count of threads of this queue terminated by other worker threads
 
         std::size_t max_count_;
         ///< maximum number of existing HPX-threads
@@ -1117,6 +1388,13 @@ namespace hpx { namespace threads { namespace policies
 
         std::atomic<std::int64_t> new_tasks_count_;
         ///< count of new tasks to run
+
+        task_description_pool_type task_description_pool_;
+        ///< freelist of task descriptions
+        std::atomic<std::int64_t> task_descriptions_reused_;
+        ///< count of task descriptions taken from the freelist
+        std::atomic<std::int64_t> task_descriptions_allocated_;
+        ///< count of task descriptions which had to be allocated
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
         std::atomic<std::int64_t> new_tasks_wait_;
         ///< overall wait time of new tasks
@@ -1127,10 +1405,11 @@ namespace hpx { namespace threads { namespace policies
         threads::thread_pool memory_pool_;          ///< OS thread local memory pools for
                                                     ///< HPX-threads
 
-        std::list<thread_id_type> thread_heap_small_;
-        std::list<thread_id_type> thread_heap_medium_;
-        std::list<thread_id_type> thread_heap_large_;
-        std::list<thread_id_type> thread_heap_huge_;
+        thread_heap_type thread_heap_small_;
+        thread_heap_type thread_heap_medium_;
+        thread_heap_type thread_heap_large_;
+        thread_heap_type thread_heap_huge_;
+        thread_heap_type thread_heap_nostack_;
 
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
         std::uint64_t add_new_time_;
@@ -1152,6 +1431,12 @@ namespace hpx { namespace threads { namespace policies
         ///< count of work_items stolen to this queue from other queues
         std::atomic<std::int64_t> stolen_to_staged_;
         ///< count of new_tasks stolen to this queue from other queues
+        std::atomic<std::int64_t> stolen_local_;
+        ///< count of items stolen to this queue from the same NUMA domain
+        std::atomic<std::int64_t> stolen_remote_;
+        ///< count of items stolen to this queue from other NUMA domains
+        std::atomic<std::int64_t> stolen_continuations_;
+        ///< count of continuations stolen from this queue
 #endif
 
         util::block_profiler<add_new_tag> add_new_logger_;
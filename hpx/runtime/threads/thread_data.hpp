@@ -42,6 +42,11 @@ namespace hpx { namespace threads
 {
     class thread_data;
 
+    namespace policies
+    {
+        class lockfree_thread_map;
+    }
+
     namespace detail
     {
         ///////////////////////////////////////////////////////////////////////
@@ -508,6 +513,18 @@ namespace hpx { namespace threads
             return pool_;
         }
 
+        // Thread objects which have terminated on a worker thread other than
+        // the one owning them are handed back in batches linked through the
+        // thread objects themselves.
+        thread_data* get_next_returned() const
+        {
+            return returned_next_;
+        }
+        void set_next_returned(thread_data* next)
+        {
+            returned_next_ = next;
+        }
+
         /// \brief Execute the thread function
         ///
         /// \returns        This function returns the thread state the thread
@@ -554,6 +571,34 @@ namespace hpx { namespace threads
         }
 #endif
 
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+        // time stamp of the thread becoming runnable, zero while the thread
+        // is not waiting in a queue
+        std::uint64_t get_queue_time() const
+        {
+            return queue_time_;
+        }
+        void set_queue_time(std::uint64_t queue_time)
+        {
+            queue_time_ = queue_time;
+        }
+
+        // accumulated execution time and number of executed phases
+        void add_execution_phase(std::uint64_t exec_time)
+        {
+            exec_time_ += exec_time;
+            ++exec_phases_;
+        }
+        std::uint64_t get_execution_time() const
+        {
+            return exec_time_;
+        }
+        std::size_t get_execution_phases() const
+        {
+            return exec_phases_;
+        }
+#endif
+
         void rebind(thread_init_data& init_data,
             thread_state_enum newstate)
         {
@@ -575,6 +620,8 @@ namespace hpx { namespace threads
         friend HPX_EXPORT void intrusive_ptr_add_ref(thread_data* p);
         friend HPX_EXPORT void intrusive_ptr_release(thread_data* p);
 
+        friend class policies::lockfree_thread_map;
+
         /// Construct a new \a thread
         thread_data(thread_init_data& init_data,
             pool_type* pool, thread_state_enum newstate)
@@ -596,6 +643,11 @@ namespace hpx { namespace threads
 #endif
 #ifdef HPX_HAVE_THREAD_BACKTRACE_ON_SUSPENSION
             backtrace_(nullptr),
+#endif
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+            queue_time_(init_data.queue_time),
+            exec_time_(0),
+            exec_phases_(0),
 #endif
             priority_(init_data.priority),
             requested_interrupt_(false),
@@ -606,7 +658,10 @@ namespace hpx { namespace threads
             stacksize_(init_data.stacksize),
             coroutine_(std::move(init_data.func),
                 this_(), init_data.stacksize),
-            pool_(pool)
+            pool_(pool),
+            map_next_(nullptr),
+            map_state_(0),
+            returned_next_(nullptr)
         {
             LTM_(debug) << "thread::thread(" << this << "), description("
                         << get_description() << ")";
@@ -653,6 +708,11 @@ namespace hpx { namespace threads
 #endif
 #ifdef HPX_HAVE_THREAD_BACKTRACE_ON_SUSPENSION
             backtrace_ = nullptr;
+#endif
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+            queue_time_ = init_data.queue_time;
+            exec_time_ = 0;
+            exec_phases_ = 0;
 #endif
             priority_ = init_data.priority;
             requested_interrupt_ = false;
@@ -713,6 +773,12 @@ namespace hpx { namespace threads
 # endif
 #endif
 
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+        std::uint64_t queue_time_;
+        std::uint64_t exec_time_;
+        std::size_t exec_phases_;
+#endif
+
         ///////////////////////////////////////////////////////////////////////
         thread_priority priority_;
 
@@ -734,6 +800,14 @@ namespace hpx { namespace threads
 
         coroutine_type coroutine_;
         pool_type* pool_;
+
+        // intrusive hooks for the map of threads of the owning thread_queue
+        thread_data* map_next_;
+        std::atomic<int> map_state_;
+
+        // intrusive hook used for returning terminated thread objects to the
+        // owning thread_queue in batches
+        thread_data* returned_next_;
     };
 
     typedef thread_data::pool_type thread_pool;
@@ -929,6 +929,25 @@ namespace hpx { namespace applier
         threads::thread_init_data& data,
         threads::thread_state_enum initial_state = threads::pending,
         error_code& ec = throws);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Create \a count new work items at once.
+    ///
+    /// \param data       [in] Points to the first of \a count
+    ///                   threads#thread_init_data objects describing the work
+    ///                   items to create. All of the objects are moved from.
+    /// \param count      [in] The number of work items to create.
+    ///
+    /// \note This function is equivalent to calling the overload of
+    ///       threads#register_work_plain above for each of the given
+    ///       objects, except that the scheduler gets the chance to distribute
+    ///       all of the new work items over its queues in one go, which
+    ///       reduces the overhead of spawning many tasks.
+    ///
+    HPX_API_EXPORT void register_work_plain(
+        threads::thread_init_data* data, std::size_t count,
+        threads::thread_state_enum initial_state = threads::pending,
+        error_code& ec = throws);
 }}
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -37,6 +37,9 @@ namespace hpx { namespace threads
 #endif
 #if defined(HPX_HAVE_THREAD_PARENT_REFERENCE)
             parent_locality_id(0), parent_id(nullptr), parent_phase(0),
+#endif
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+            queue_time(0),
 #endif
             priority(thread_priority_normal),
             num_os_thread(std::size_t(-1)),
@@ -55,6 +58,9 @@ namespace hpx { namespace threads
 #if defined(HPX_HAVE_THREAD_PARENT_REFERENCE)
             parent_locality_id(rhs.parent_locality_id), parent_id(rhs.parent_id),
             parent_phase(rhs.parent_phase),
+#endif
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+            queue_time(rhs.queue_time),
 #endif
             priority(rhs.priority),
             num_os_thread(rhs.num_os_thread),
@@ -81,6 +87,9 @@ namespace hpx { namespace threads
 #endif
 #if defined(HPX_HAVE_THREAD_PARENT_REFERENCE)
             parent_locality_id(0), parent_id(nullptr), parent_phase(0),
+#endif
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+            queue_time(0),
 #endif
             priority(priority_), num_os_thread(os_thread),
             stacksize(stacksize_ == std::ptrdiff_t(-1) ?
@@ -104,6 +113,9 @@ namespace hpx { namespace threads
         threads::thread_id_repr_type parent_id;
         std::size_t parent_phase;
 #endif
+#if defined(HPX_HAVE_THREAD_LATENCY_HISTOGRAMS)
+        std::uint64_t queue_time;
+#endif
 
         thread_priority priority;
         std::size_t num_os_thread;
@@ -107,6 +107,19 @@ namespace hpx { namespace threads
             thread_state_enum initial_state = pending,
             error_code& ec = throws);
 
+        /// The function \a register_work adds \a count new work items to the
+        /// thread manager at once. This is equivalent to calling the function
+        /// above for each of the items, except that the items are distributed
+        /// over the queues of the scheduler in one go.
+        ///
+        /// \param data   [in] Points to the first of \a count thread
+        ///               descriptions. All of the descriptions are moved
+        ///               from.
+        /// \param count  [in] The number of work items to add.
+        void register_work(thread_init_data* data, std::size_t count,
+            thread_state_enum initial_state = pending,
+            error_code& ec = throws);
+
         /// The function \a register_thread adds a new work item to the thread
         /// manager. It creates a new \a thread, adds it to the internal
         /// management data structures, and schedules the new thread, if
@@ -332,6 +345,21 @@ namespace hpx { namespace threads
             threadpool_counter_func pool_func,
             performance_counters::counter_info const& info, error_code& ec);
 
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+        typedef std::vector<std::int64_t> (
+            threadmanager::*threadmanager_histogram_func)(bool reset);
+        typedef std::vector<std::int64_t> (
+            detail::thread_pool_base::*threadpool_histogram_func)(
+                std::size_t num_thread, bool reset);
+
+        naming::gid_type latency_histogram_counter_creator(
+            threadmanager_histogram_func total_func,
+            threadpool_histogram_func pool_func,
+            std::int64_t min_boundary, std::int64_t max_boundary,
+            std::int64_t num_buckets,
+            performance_counters::counter_info const& info, error_code& ec);
+#endif
+
         // performance counters
         std::int64_t get_queue_length(bool reset);
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
@@ -340,6 +368,12 @@ namespace hpx { namespace threads
 #endif
         std::int64_t get_cumulative_duration(bool reset);
 
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+        std::vector<std::int64_t> get_queue_wait_histogram(bool reset);
+        std::vector<std::int64_t> get_execution_time_histogram(bool reset);
+        std::vector<std::int64_t> get_suspension_histogram(bool reset);
+#endif
+
         std::int64_t get_thread_count_unknown(bool reset)
         {
             return get_thread_count(
@@ -392,6 +426,10 @@ namespace hpx { namespace threads
 #endif
 #endif
 
+        std::int64_t get_num_task_descriptions_reused(bool reset);
+        std::int64_t get_num_task_descriptions_allocated(bool reset);
+        std::int64_t get_num_cross_worker_frees(bool reset);
+
 #ifdef HPX_HAVE_THREAD_STEALING_COUNTS
         std::int64_t get_num_pending_misses(bool reset);
         std::int64_t get_num_pending_accesses(bool reset);
@@ -399,6 +437,15 @@ namespace hpx { namespace threads
         std::int64_t get_num_stolen_from_staged(bool reset);
         std::int64_t get_num_stolen_to_pending(bool reset);
         std::int64_t get_num_stolen_to_staged(bool reset);
+        std::int64_t get_num_stolen_local(bool reset);
+        std::int64_t get_num_stolen_remote(bool reset);
+        std::int64_t get_num_stolen_continuations(bool reset);
+#endif
+
+#ifdef HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF
+        std::int64_t get_num_idle_parks(bool reset);
+        std::int64_t get_num_idle_unparks(bool reset);
+        std::int64_t get_average_unpark_latency(bool reset);
 #endif
 
 private:
@@ -53,6 +53,48 @@ namespace hpx { namespace traits
             return detail::call_supports_migration<Component>();
         }
     };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Customization point for components which can be copied while they are
+    // serving requests (see hpx::components::live_migrate)
+    namespace detail
+    {
+        struct supports_live_migration_helper
+        {
+            // by default we return 'false' (component does not support
+            // live migration)
+            template <typename Component>
+            static HPX_CONSTEXPR bool call(wrap_int)
+            {
+                return false;
+            }
+
+            // forward the call if the component implements the function
+            template <typename Component>
+            static HPX_CONSTEXPR auto call(int)
+            ->  decltype(Component::supports_live_migration())
+            {
+                return Component::supports_live_migration();
+            }
+        };
+
+        template <typename Component>
+        HPX_CONSTEXPR bool call_supports_live_migration()
+        {
+            return supports_live_migration_helper::template call<Component>(0);
+        }
+    }
+
+    template <typename Component, typename Enable = void>
+    struct component_supports_live_migration
+    {
+        // returns whether target supports live migration
+        static HPX_CONSTEXPR bool call()
+        {
+            return component_supports_migration<Component>::call() &&
+                detail::call_supports_live_migration<Component>();
+        }
+    };
 }}
 
 #endif
@@ -32,6 +32,12 @@ namespace boost { namespace lockfree
             return this->base_type::template allocate<true, false>();
         }
 
+        // return a cached node or nullptr if the freelist is empty
+        T* try_allocate()
+        {
+            return this->base_type::template allocate<true, true>();
+        }
+
         void deallocate(T* n)
         {
             this->base_type::template deallocate<true>(n);
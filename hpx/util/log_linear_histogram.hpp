@@ -0,0 +1,166 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_LOG_LINEAR_HISTOGRAM_HPP)
+#define HPX_UTIL_LOG_LINEAR_HISTOGRAM_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hpx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A lock-free histogram covering the full range of std::uint64_t using
+    // log-linear buckets: every power of two is split into 2^SubBucketBits
+    // linear sub-buckets, which bounds the relative error of any value
+    // reconstructed from the histogram by 2^-SubBucketBits. Adding a sample
+    // is a single relaxed atomic increment, which makes the histogram cheap
+    // enough to be updated from the scheduling loop.
+    template <std::size_t SubBucketBits = 3>
+    class log_linear_histogram
+    {
+    public:
+        HPX_NON_COPYABLE(log_linear_histogram);
+
+    public:
+        static std::size_t const sub_buckets = std::size_t(1) << SubBucketBits;
+        static std::size_t const num_buckets =
+            (64 - SubBucketBits + 1) * sub_buckets;
+
+        log_linear_histogram()
+        {
+            for (std::size_t i = 0; i != num_buckets; ++i)
+                buckets_[i].store(0, std::memory_order_relaxed);
+        }
+
+        void add(std::uint64_t value)
+        {
+            buckets_[bucket_index(value)].fetch_add(
+                1, std::memory_order_relaxed);
+        }
+
+        // Add the counts of all buckets to the given data, which has to hold
+        // num_buckets elements.
+        void collect(std::vector<std::int64_t>& data, bool reset)
+        {
+            HPX_ASSERT(data.size() == num_buckets);
+            for (std::size_t i = 0; i != num_buckets; ++i)
+            {
+                data[i] += reset ?
+                    buckets_[i].exchange(0, std::memory_order_relaxed) :
+                    buckets_[i].load(std::memory_order_relaxed);
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        static std::size_t bucket_index(std::uint64_t value)
+        {
+            if (value < sub_buckets)
+                return static_cast<std::size_t>(value);
+
+            std::size_t const msb = most_significant_bit(value);
+            std::size_t const shift = msb - SubBucketBits;
+            return (shift + 1) * sub_buckets +
+                static_cast<std::size_t>((value >> shift) & (sub_buckets - 1));
+        }
+
+        // smallest value falling into the given bucket
+        static std::uint64_t bucket_lower_bound(std::size_t index)
+        {
+            if (index < sub_buckets)
+                return index;
+
+            std::size_t const shift = index / sub_buckets - 1;
+            return (std::uint64_t(sub_buckets) | (index & (sub_buckets - 1)))
+                << shift;
+        }
+
+        // smallest value falling into the next bucket
+        static std::uint64_t bucket_upper_bound(std::size_t index)
+        {
+            if (index < sub_buckets)
+                return index + 1;
+
+            std::size_t const shift = index / sub_buckets - 1;
+            return bucket_lower_bound(index) + (std::uint64_t(1) << shift);
+        }
+
+        // Convert the counts collected from this type of histogram into the
+        // format used by all histogram performance counters: the lower and
+        // upper boundaries and the number of buckets, followed by the counts
+        // for the underflow bucket, the num_buckets requested buckets, and
+        // the overflow bucket. Every log-linear bucket is attributed to the
+        // linear bucket holding its midpoint.
+        static std::vector<std::int64_t> to_linear(
+            std::vector<std::int64_t> const& data, std::int64_t min_boundary,
+            std::int64_t max_boundary, std::int64_t num_linear_buckets)
+        {
+            HPX_ASSERT(data.size() == num_buckets);
+            HPX_ASSERT(min_boundary < max_boundary && num_linear_buckets > 0);
+
+            std::vector<std::int64_t> result;
+            result.reserve(std::size_t(num_linear_buckets) + 5);
+            result.push_back(min_boundary);
+            result.push_back(max_boundary);
+            result.push_back(num_linear_buckets);
+            result.resize(std::size_t(num_linear_buckets) + 5, 0);
+
+            double const width = double(max_boundary - min_boundary) /
+                double(num_linear_buckets);
+
+            for (std::size_t i = 0; i != num_buckets; ++i)
+            {
+                if (data[i] == 0)
+                    continue;
+
+                double const midpoint =
+                    (double(bucket_lower_bound(i)) +
+                        double(bucket_upper_bound(i) - 1)) / 2;
+
+                std::size_t bucket = 0;     // underflow
+                if (midpoint >= double(max_boundary))
+                {
+                    bucket = std::size_t(num_linear_buckets) + 1;
+                }
+                else if (midpoint >= double(min_boundary))
+                {
+                    bucket = std::size_t(
+                        (midpoint - double(min_boundary)) / width) + 1;
+                }
+                result[bucket + 3] += data[i];
+            }
+            return result;
+        }
+
+    private:
+        static std::size_t most_significant_bit(std::uint64_t value)
+        {
+            HPX_ASSERT(value != 0);
+#if defined(__GNUC__)
+            return 63 - static_cast<std::size_t>(__builtin_clzll(value));
+#else
+            std::size_t result = 0;
+            while (value >>= 1)
+                ++result;
+            return result;
+#endif
+        }
+
+        std::atomic<std::int64_t> buckets_[num_buckets];
+    };
+
+    template <std::size_t SubBucketBits>
+    std::size_t const log_linear_histogram<SubBucketBits>::sub_buckets;
+
+    template <std::size_t SubBucketBits>
+    std::size_t const log_linear_histogram<SubBucketBits>::num_buckets;
+}}
+
+#endif
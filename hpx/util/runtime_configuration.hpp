@@ -79,6 +79,10 @@ namespace hpx { namespace util
 
         std::size_t get_agas_max_pending_refcnt_requests() const;
 
+        // Get the time (in microseconds) pending decrements of global
+        // reference counts are buffered
+        std::uint64_t get_agas_refcnt_flush_interval() const;
+
         // Load application specific configuration and merge it with the
         // default configuration loaded from hpx.ini
         bool load_application_configuration(char const* filename,
@@ -139,6 +143,7 @@ namespace hpx { namespace util
 
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
         bool init_use_stack_guard_pages() const;
+        std::size_t init_stack_pool_high_water_mark() const;
 #endif
 
         void pre_initialize_ini();
@@ -0,0 +1,65 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/actions/action_support.hpp>
+
+#include <hpx/plugins/plugin_registry.hpp>
+#include <hpx/plugins/binary_filter_factory.hpp>
+#include <hpx/plugins/binary_filter/lz4_serialization_filter.hpp>
+
+#include <cstddef>
+
+#include <lz4.h>
+
+///////////////////////////////////////////////////////////////////////////////
+HPX_REGISTER_PLUGIN_MODULE();
+HPX_REGISTER_BINARY_FILTER_FACTORY(
+    hpx::plugins::compression::lz4_serialization_filter,
+    lz4_serialization_filter);
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace plugins { namespace compression
+{
+    std::size_t lz4_serialization_filter::compress_bound(std::size_t size)
+    {
+        return static_cast<std::size_t>(
+            LZ4_compressBound(static_cast<int>(size)));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t lz4_serialization_filter::compress_block(char const* src,
+        std::size_t src_count, char* dst, std::size_t dst_count)
+    {
+        int compressed_length = LZ4_compress_default(src, dst,
+            static_cast<int>(src_count), static_cast<int>(dst_count));
+
+        if (compressed_length <= 0 && src_count != 0)
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "lz4_serialization_filter::compress_block",
+                "compression failure");
+            return 0;
+        }
+        return static_cast<std::size_t>(compressed_length);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void lz4_serialization_filter::decompress_block(char const* src,
+        std::size_t src_count, char* dst, std::size_t dst_count)
+    {
+        int decompressed_length = LZ4_decompress_safe(src, dst,
+            static_cast<int>(src_count), static_cast<int>(dst_count));
+
+        if (decompressed_length < 0 ||
+            static_cast<std::size_t>(decompressed_length) != dst_count)
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "lz4_serialization_filter::decompress_block",
+                "decompression failure");
+        }
+    }
+}}}
+
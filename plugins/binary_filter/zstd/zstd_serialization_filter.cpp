@@ -0,0 +1,80 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/actions/action_support.hpp>
+
+#include <hpx/plugins/plugin_registry.hpp>
+#include <hpx/plugins/binary_filter_factory.hpp>
+#include <hpx/plugins/binary_filter/zstd_serialization_filter.hpp>
+#include <hpx/util/format.hpp>
+
+#include <cstddef>
+
+#include <zstd.h>
+
+///////////////////////////////////////////////////////////////////////////////
+HPX_REGISTER_PLUGIN_MODULE();
+HPX_REGISTER_BINARY_FILTER_FACTORY(
+    hpx::plugins::compression::zstd_serialization_filter,
+    zstd_serialization_filter);
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace plugins { namespace compression
+{
+    // the blocks are compressed independently, a moderate level keeps the
+    // compression of large messages reasonably fast
+    static int const zstd_compression_level = 3;
+
+    std::size_t zstd_serialization_filter::compress_bound(std::size_t size)
+    {
+        return ZSTD_compressBound(size);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t zstd_serialization_filter::compress_block(char const* src,
+        std::size_t src_count, char* dst, std::size_t dst_count)
+    {
+        std::size_t compressed_length = ZSTD_compress(dst, dst_count,
+            src, src_count, zstd_compression_level);
+
+        if (ZSTD_isError(compressed_length))
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "zstd_serialization_filter::compress_block",
+                hpx::util::format("compression failure: %s",
+                    ZSTD_getErrorName(compressed_length)));
+            return 0;
+        }
+        return compressed_length;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void zstd_serialization_filter::decompress_block(char const* src,
+        std::size_t src_count, char* dst, std::size_t dst_count)
+    {
+        std::size_t decompressed_length = ZSTD_decompress(dst, dst_count,
+            src, src_count);
+
+        if (ZSTD_isError(decompressed_length))
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "zstd_serialization_filter::decompress_block",
+                hpx::util::format("decompression failure: %s",
+                    ZSTD_getErrorName(decompressed_length)));
+            return;
+        }
+
+        if (decompressed_length != dst_count)
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "zstd_serialization_filter::decompress_block",
+                hpx::util::format("decompression failure, number of "
+                    "bytes expected: %d, number of bytes decoded: %d",
+                    dst_count, decompressed_length));
+        }
+    }
+}}}
+
@@ -34,6 +34,7 @@ namespace hpx { namespace plugins { namespace parcel
         get_counter_type num_parcels, get_counter_type num_messages,
         get_counter_type num_parcels_per_message,
         get_counter_type average_time_between_parcels,
+        get_counter_type batch_size, get_counter_type interval,
         get_counter_values_creator_type time_between_parcels_histogram_creator)
     {
         if (name.empty())
@@ -52,6 +53,7 @@ namespace hpx { namespace plugins { namespace parcel
             {
                 num_parcels, num_messages,
                 num_parcels_per_message, average_time_between_parcels,
+                batch_size, interval,
                 time_between_parcels_histogram_creator,
                 0, 0, 1
             };
@@ -66,6 +68,8 @@ namespace hpx { namespace plugins { namespace parcel
             (*it).second.num_parcels_per_message = num_parcels_per_message;
             (*it).second.average_time_between_parcels =
                 average_time_between_parcels;
+            (*it).second.batch_size = batch_size;
+            (*it).second.interval = interval;
             (*it).second.time_between_parcels_histogram_creator =
                 time_between_parcels_histogram_creator;
 
@@ -172,6 +176,42 @@ namespace hpx { namespace plugins { namespace parcel
         return (*it).second.average_time_between_parcels;
     }
 
+    coalescing_counter_registry::get_counter_type
+        coalescing_counter_registry::get_batch_size_counter(
+            std::string const& name) const
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+
+        map_type::const_iterator it = map_.find(name);
+        if (it == map_.end())
+        {
+            l.unlock();
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "coalescing_counter_registry::get_batch_size_counter",
+                "unknown action type");
+            return get_counter_type();
+        }
+        return (*it).second.batch_size;
+    }
+
+    coalescing_counter_registry::get_counter_type
+        coalescing_counter_registry::get_interval_counter(
+            std::string const& name) const
+    {
+        std::unique_lock<mutex_type> l(mtx_);
+
+        map_type::const_iterator it = map_.find(name);
+        if (it == map_.end())
+        {
+            l.unlock();
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "coalescing_counter_registry::get_interval_counter",
+                "unknown action type");
+            return get_counter_type();
+        }
+        return (*it).second.interval;
+    }
+
     coalescing_counter_registry::get_counter_values_type
         coalescing_counter_registry::get_time_between_parcels_histogram_counter(
             std::string const& name, std::int64_t min_boundary,
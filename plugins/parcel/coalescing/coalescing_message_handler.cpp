@@ -22,6 +22,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/accumulators/accumulators.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -40,6 +41,8 @@ namespace hpx { namespace traits
     //      ...
     //      num_messages = 50
     //      interval = 100
+    //      adaptive = 0
+    //      latency_budget = 100
     //
     template <>
     struct plugin_config_data<hpx::plugins::parcel::coalescing_message_handler>
@@ -48,7 +51,9 @@ namespace hpx { namespace traits
         {
             return "num_messages = 50\n"
                    "interval = 100\n"
-                   "allow_background_flush = 1";
+                   "allow_background_flush = 1\n"
+                   "adaptive = 0\n"
+                   "latency_budget = 100";
         }
     };
 }}
@@ -84,19 +89,73 @@ namespace hpx { namespace plugins { namespace parcel
                 "1");
             return !value.empty() && value[0] != '0';
         }
+
+        bool get_adaptive()
+        {
+            std::string value = hpx::get_config_entry(
+                "hpx.plugins.coalescing_message_handler.adaptive", "0");
+            return !value.empty() && value[0] != '0';
+        }
+
+        std::size_t get_latency_budget(std::size_t latency_budget)
+        {
+            return boost::lexical_cast<std::size_t>(hpx::get_config_entry(
+                "hpx.plugins.coalescing_message_handler.latency_budget",
+                latency_budget));
+        }
     }
 
     void coalescing_message_handler::update_num_messages()
     {
         std::lock_guard<mutex_type> l(mtx_);
-        num_coalesced_parcels_ =
-            detail::get_num_messages(num_coalesced_parcels_);
+        max_coalesced_parcels_ =
+            detail::get_num_messages(max_coalesced_parcels_);
+
+        // in adaptive mode the configured value is the upper limit only
+        if (adaptive_)
+            adapt_parameters();
+        else
+            num_coalesced_parcels_ = max_coalesced_parcels_;
     }
 
     void coalescing_message_handler::update_interval()
     {
         std::lock_guard<mutex_type> l(mtx_);
-        interval_ = detail::get_interval(interval_);
+
+        // in adaptive mode the interval is derived from the latency budget
+        if (!adaptive_)
+            interval_ = detail::get_interval(interval_);
+    }
+
+    void coalescing_message_handler::update_latency_budget()
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        latency_budget_ = detail::get_latency_budget(latency_budget_);
+        adapt_parameters();
+    }
+
+    // Derive the number of parcels to coalesce and the flush interval from
+    // the average time between parcels: coalesce as many parcels as arrive
+    // on average within the latency budget, but do not wait any longer than
+    // needed to fill the buffer. At low load this disables coalescing, at
+    // high load the buffer fills up well before the budget is used up.
+    void coalescing_message_handler::adapt_parameters()
+    {
+        if (!adaptive_)
+            return;
+
+        double const budget = double(latency_budget_) * 1000.;    // [ns]
+        double const arrival = (std::max)(average_arrival_, 1.);
+
+        double num = (std::min)(budget / arrival,
+            double(max_coalesced_parcels_));
+        num_coalesced_parcels_ =
+            (std::max)(std::size_t(1), static_cast<std::size_t>(num));
+
+        double interval =
+            (std::min)(double(num_coalesced_parcels_) * arrival, budget);
+        interval_ = (std::max)(std::size_t(1),
+            static_cast<std::size_t>(interval / 1000.));
     }
 
     coalescing_message_handler::coalescing_message_handler(
@@ -105,6 +164,10 @@ namespace hpx { namespace plugins { namespace parcel
       : pp_(pp),
         num_coalesced_parcels_(detail::get_num_messages(num)),
         interval_(detail::get_interval(interval)),
+        adaptive_(detail::get_adaptive()),
+        max_coalesced_parcels_(num_coalesced_parcels_),
+        latency_budget_(detail::get_latency_budget(interval_)),
+        average_arrival_(double(latency_budget_) * 1000.),
         buffer_(num_coalesced_parcels_),
         timer_(
             util::bind(&coalescing_message_handler::timer_flush, this_()),
@@ -124,6 +187,13 @@ namespace hpx { namespace plugins { namespace parcel
         histogram_max_boundary_(-1),
         histogram_num_buckets_(-1)
     {
+        // start off assuming low load
+        if (adaptive_)
+        {
+            adapt_parameters();
+            buffer_ = detail::message_buffer(num_coalesced_parcels_);
+        }
+
         // register performance counter functions
         using util::placeholders::_1;
         using util::placeholders::_2;
@@ -136,6 +206,8 @@ namespace hpx { namespace plugins { namespace parcel
                 get_parcels_per_message_count, this, _1),
             util::bind(&coalescing_message_handler::
                 get_average_time_between_parcels, this, _1),
+            util::bind(&coalescing_message_handler::get_batch_size, this, _1),
+            util::bind(&coalescing_message_handler::get_interval, this, _1),
             util::bind(&coalescing_message_handler::
                 get_time_between_parcels_histogram_creator, this, _1, _2, _3, _4));
 
@@ -146,6 +218,10 @@ namespace hpx { namespace plugins { namespace parcel
         set_config_entry_callback(
             "hpx.plugins.coalescing_message_handler.interval",
             util::bind(&coalescing_message_handler::update_interval, this));
+        set_config_entry_callback(
+            "hpx.plugins.coalescing_message_handler.latency_budget",
+            util::bind(&coalescing_message_handler::update_latency_budget,
+                this));
     }
 
     void coalescing_message_handler::put_parcel(
@@ -164,6 +240,15 @@ namespace hpx { namespace plugins { namespace parcel
         if (time_between_parcels_)
             (*time_between_parcels_)(time_since_last_parcel);
 
+        // track the arrival rate, any gap longer than the latency budget
+        // means that parcels should not be coalesced at all
+        if (adaptive_)
+        {
+            double sample = (std::min)(double(time_since_last_parcel),
+                double(latency_budget_) * 1000.);
+            average_arrival_ += (sample - average_arrival_) / 16.;
+        }
+
         std::chrono::microseconds interval(interval_);
 
         // just send parcel if the coalescing was stopped or the buffer is
@@ -273,6 +358,9 @@ namespace hpx { namespace plugins { namespace parcel
         if (buffer_.empty())
             return false;
 
+        // the next buffer is sized according to the current load
+        adapt_parameters();
+
         detail::message_buffer buff (num_coalesced_parcels_);
         std::swap(buff, buffer_);
 
@@ -316,6 +404,18 @@ namespace hpx { namespace plugins { namespace parcel
         return value;
     }
 
+    std::int64_t coalescing_message_handler::get_batch_size(bool)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return static_cast<std::int64_t>(num_coalesced_parcels_);
+    }
+
+    std::int64_t coalescing_message_handler::get_interval(bool)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return static_cast<std::int64_t>(interval_) * 1000;     // [ns]
+    }
+
     std::int64_t coalescing_message_handler::get_parcels_count(bool reset)
     {
         std::unique_lock<mutex_type> l(mtx_);
@@ -372,6 +372,109 @@ namespace hpx { namespace plugins { namespace parcel
         }
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // The counters exposing the current coalescing parameters are created
+    // the same way, they differ only by the registry function used to look
+    // up the actual counter function.
+    typedef coalescing_counter_registry::get_counter_type (
+            coalescing_counter_registry::*get_parameter_counter_type
+        )(std::string const&) const;
+
+    struct parameter_counter_surrogate
+    {
+        parameter_counter_surrogate(get_parameter_counter_type get_counter,
+                std::string const& parameters)
+          : get_counter_(get_counter), parameters_(parameters)
+        {}
+
+        std::int64_t operator()(bool reset)
+        {
+            if (counter_.empty())
+            {
+                counter_ = (coalescing_counter_registry::instance().*
+                    get_counter_)(parameters_);
+                if (counter_.empty())
+                    return 0;           // no counter available yet
+            }
+
+            // dispatch to actual counter
+            return counter_(reset);
+        }
+
+        get_parameter_counter_type get_counter_;
+        hpx::util::function_nonser<std::int64_t(bool)> counter_;
+        std::string parameters_;
+    };
+
+    hpx::naming::gid_type parameter_counter_creator(
+        hpx::performance_counters::counter_info const& info,
+        get_parameter_counter_type get_counter, char const* name,
+        hpx::error_code& ec)
+    {
+        switch (info.type_) {
+        case performance_counters::counter_raw:
+            {
+                performance_counters::counter_path_elements paths;
+                performance_counters::get_counter_path_elements(
+                    info.fullname_, paths, ec);
+                if (ec) return naming::invalid_gid;
+
+                if (paths.parentinstance_is_basename_) {
+                    HPX_THROWS_IF(ec, bad_parameter, name,
+                        "invalid counter name for coalescing parameter "
+                        "(instance name must not be a valid base counter "
+                        "name)");
+                    return naming::invalid_gid;
+                }
+
+                if (paths.parameters_.empty()) {
+                    HPX_THROWS_IF(ec, bad_parameter, name,
+                        "invalid counter parameter for coalescing parameter: "
+                        "must specify an action type");
+                    return naming::invalid_gid;
+                }
+
+                // ask registry
+                hpx::util::function_nonser<std::int64_t(bool)> f =
+                    (coalescing_counter_registry::instance().*get_counter)(
+                        paths.parameters_);
+
+                if (!f.empty())
+                {
+                    return performance_counters::detail::create_raw_counter(
+                        info, std::move(f), ec);
+                }
+
+                // the counter is not available yet, create surrogate function
+                return performance_counters::detail::create_raw_counter(info,
+                    parameter_counter_surrogate(get_counter, paths.parameters_),
+                    ec);
+            }
+            break;
+
+        default:
+            HPX_THROWS_IF(ec, bad_parameter, name,
+                "invalid counter type requested");
+            return naming::invalid_gid;
+        }
+    }
+
+    hpx::naming::gid_type batch_size_counter_creator(
+        hpx::performance_counters::counter_info const& info, hpx::error_code& ec)
+    {
+        return parameter_counter_creator(info,
+            &coalescing_counter_registry::get_batch_size_counter,
+            "batch_size_counter_creator", ec);
+    }
+
+    hpx::naming::gid_type interval_counter_creator(
+        hpx::performance_counters::counter_info const& info, hpx::error_code& ec)
+    {
+        return parameter_counter_creator(info,
+            &coalescing_counter_registry::get_interval_counter,
+            "interval_counter_creator", ec);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     struct time_between_parcels_histogram_counter_surrogate
     {
@@ -559,6 +662,26 @@ namespace hpx { namespace plugins { namespace parcel
               &time_between_parcels_histogram_counter_creator,
               &counter_discoverer,
               "ns/0.1%"
+            },
+            // /coalescing(...)/count/current-batch-size@action-name
+            { "/coalescing/count/current-batch-size", counter_raw,
+              "returns the number of parcels after which the message handler "
+              "associated with the action which is given by the counter "
+              "parameter currently sends a message",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &batch_size_counter_creator,
+              &counter_discoverer,
+              ""
+            },
+            // /coalescing(...)/time/current-interval@action-name
+            { "/coalescing/time/current-interval", counter_raw,
+              "returns the time after which the message handler associated "
+              "with the action which is given by the counter parameter "
+              "currently sends a message even if it holds fewer parcels",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &interval_counter_creator,
+              &counter_discoverer,
+              "ns"
             }
         };
 
@@ -0,0 +1,261 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING)
+#include <hpx/traits/plugin_config_data.hpp>
+
+#include <hpx/plugins/parcelport_factory.hpp>
+
+// parcelport
+#include <hpx/runtime.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/parcelset/parcelport_impl.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/runtime/threads/threadmanager.hpp>
+
+#include <hpx/plugins/parcelport/ipc/locality.hpp>
+#include <hpx/plugins/parcelport/ipc/receiver.hpp>
+#include <hpx/plugins/parcelport/ipc/sender.hpp>
+
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/runtime_configuration.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <boost/asio/ip/host_name.hpp>
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace parcelset
+{
+    namespace policies { namespace ipc
+    {
+        class HPX_EXPORT parcelport;
+    }}
+
+    template <>
+    struct connection_handler_traits<policies::ipc::parcelport>
+    {
+        typedef policies::ipc::sender_connection connection_type;
+        typedef std::false_type send_early_parcel;
+        typedef std::true_type  do_background_work;
+        typedef std::false_type send_immediate_parcels;
+
+        static const char * type()
+        {
+            return "ipc";
+        }
+
+        static const char * pool_name()
+        {
+            return "parcel-pool-ipc";
+        }
+
+        static const char * pool_name_postfix()
+        {
+            return "-ipc";
+        }
+    };
+
+    namespace policies { namespace ipc
+    {
+        void add_connection(sender * s, std::shared_ptr<sender_connection> const &ptr)
+        {
+            s->add(ptr);
+        }
+
+        // The shared memory parcelport is used for all localities running on
+        // the same host as this locality. It can't be used for bootstrapping,
+        // once the alternative parcelports have been enabled it is preferred
+        // over the network based parcelports because of its higher priority.
+        class HPX_EXPORT parcelport
+          : public parcelport_impl<parcelport>
+        {
+            typedef parcelport_impl<parcelport> base_type;
+
+            // The token distinguishes this run from processes with the same
+            // pid in other pid namespaces on this host.
+            static std::uint64_t run_token()
+            {
+                std::random_device rd;
+                std::uint64_t token =
+                    (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+                return token ^ util::high_resolution_clock::now();
+            }
+
+            static parcelset::locality here()
+            {
+                return parcelset::locality(
+                    locality(boost::asio::ip::host_name(),
+                        static_cast<std::int32_t>(::getpid()), run_token()));
+            }
+
+        public:
+            parcelport(util::runtime_configuration const& ini,
+                util::function_nonser<void(std::size_t, char const*)> const& on_start,
+                util::function_nonser<void()> const& on_stop)
+              : base_type(ini, here(), on_start, on_stop)
+              , stopped_(false)
+              , num_slots_(hpx::util::get_entry_as<std::size_t>(
+                    ini, "hpx.parcel.ipc.num_slots", 64))
+              , ring_size_(hpx::util::get_entry_as<std::size_t>(
+                    ini, "hpx.parcel.ipc.ring_size", 1048576))
+              , receiver_(*this)
+            {}
+
+            /// Start the handling of connections.
+            bool do_run()
+            {
+                // The receiver invokes this from its own OS thread whenever
+                // new data has arrived while this locality might be idling.
+                // It wakes up a parked worker thread which receives the data
+                // while doing background work.
+                runtime* rt = get_runtime_ptr();
+                auto notify =
+                    [rt]()
+                    {
+                        if (rt != nullptr)
+                        {
+                            rt->get_thread_manager().default_pool().
+                                do_some_work(0);
+                        }
+                    };
+
+                locality const& l = here_.get<locality>();
+                return receiver_.run(l.segment_name(), num_slots_, ring_size_,
+                    std::move(notify));
+            }
+
+            /// Stop the handling of connectons.
+            void do_stop()
+            {
+                while(do_background_work(0))
+                {
+                    if(threads::get_self_ptr())
+                        hpx::this_thread::suspend(hpx::threads::pending,
+                            "ipc::parcelport::do_stop");
+                }
+                stopped_ = true;
+                receiver_.stop();
+            }
+
+            /// Only localities running on the same host can be reached
+            bool can_connect(parcelset::locality const& dest,
+                bool use_alternative_parcelport)
+            {
+                return use_alternative_parcelport &&
+                    dest.get<locality>().host() == here_.get<locality>().host();
+            }
+
+            /// Return the name of this locality
+            std::string get_locality_name() const
+            {
+                return here_.get<locality>().host();
+            }
+
+            std::shared_ptr<sender_connection> create_connection(
+                parcelset::locality const& l, error_code& ec)
+            {
+                return sender_.create_connection(l, this, ec);
+            }
+
+            parcelset::locality agas_locality(
+                util::runtime_configuration const & ini) const
+            {
+                // the shared memory parcelport is never used for
+                // bootstrapping
+                return parcelset::locality(locality());
+            }
+
+            parcelset::locality create_locality() const
+            {
+                return parcelset::locality(locality());
+            }
+
+            bool background_work(std::size_t num_thread)
+            {
+                if (stopped_)
+                    return false;
+
+                bool has_work = false;
+                has_work = sender_.background_work();
+                has_work = receiver_.background_work(num_thread) || has_work;
+                return has_work;
+            }
+
+            /// Keep the worker threads from going to sleep while messages
+            /// are being sent or are waiting to be received
+            bool has_pending_background_work()
+            {
+                if (stopped_)
+                    return false;
+
+                return base_type::has_pending_background_work() ||
+                    sender_.has_pending_connections() ||
+                    receiver_.has_pending_data();
+            }
+
+        private:
+            std::atomic<bool> stopped_;
+
+            std::size_t num_slots_;
+            std::size_t ring_size_;
+
+            sender sender_;
+            receiver<parcelport> receiver_;
+        };
+    }}
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+namespace hpx { namespace traits
+{
+    // Inject additional configuration data into the factory registry for this
+    // type. This information ends up in the system wide configuration database
+    // under the plugin specific section:
+    //
+    //      [hpx.parcel.ipc]
+    //      ...
+    //      priority = 1000
+    //
+    template <>
+    struct plugin_config_data<hpx::parcelset::policies::ipc::parcelport>
+    {
+        static char const* priority()
+        {
+            return "1000";
+        }
+        static void init(int *argc, char ***argv, util::command_line_handling &cfg)
+        {
+        }
+
+        static char const* call()
+        {
+            return
+                "num_slots = ${HPX_PARCEL_IPC_NUM_SLOTS:64}\n"
+                "ring_size = ${HPX_PARCEL_IPC_RING_SIZE:1048576}\n"
+                ;
+        }
+    };
+}}
+
+HPX_REGISTER_PARCELPORT(
+    hpx::parcelset::policies::ipc::parcelport,
+    ipc);
+
+#endif
@@ -21,6 +21,8 @@ namespace hpx { namespace traits
     //      [hpx.parcel.tcp]
     //      ...
     //      priority = 1
+    //      window_size = 16
+    //      receive_buffer_pool_size = 67108864
     //
     template <>
     struct plugin_config_data<hpx::parcelset::policies::tcp::connection_handler>
@@ -35,7 +37,11 @@ namespace hpx { namespace traits
         }
         static char const* call()
         {
-            return "";
+            return
+                "window_size = ${HPX_PARCEL_TCP_WINDOW_SIZE:16}\n"
+                "receive_buffer_pool_size = "
+                    "${HPX_PARCEL_TCP_RECEIVE_BUFFER_POOL_SIZE:67108864}\n"
+                ;
         }
     };
 }}
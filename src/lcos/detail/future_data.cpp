@@ -14,6 +14,7 @@
 #include <hpx/util/unique_function.hpp>
 #include <hpx/lcos/local/futures_factory.hpp>
 #include <hpx/runtime/threads/thread.hpp>
+#include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/runtime/launch_policy.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 
@@ -34,7 +35,10 @@ namespace hpx { namespace lcos { namespace detail
     {
         lcos::local::futures_factory<bool()> p(std::move(f));
 
-        bool is_hpx_thread = nullptr != hpx::threads::get_self_ptr();
+        // stackless threads can't wait for the new thread to run, treat
+        // those like non-HPX threads
+        hpx::threads::thread_self* self = hpx::threads::get_self_ptr();
+        bool is_hpx_thread = nullptr != self && !self->is_stackless();
         hpx::launch policy = launch::fork;
         if (!is_hpx_thread)
             policy = launch::async;
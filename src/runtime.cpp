@@ -1168,6 +1168,14 @@ namespace hpx { namespace parcelset
     {
         return get_runtime().get_parcel_handler().do_background_work(num_thread);
     }
+
+    bool has_pending_background_work()
+    {
+        runtime* rt = get_runtime_ptr();
+        if (nullptr == rt)
+            return false;
+        return rt->get_parcel_handler().has_pending_background_work();
+    }
 }}
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1189,7 +1197,14 @@ namespace hpx { namespace threads
     std::ptrdiff_t get_stack_size(threads::thread_stacksize stacksize)
     {
         if (stacksize == threads::thread_stacksize_current)
-            return threads::get_self_stacksize();
+        {
+            // threads created from a stackless thread get a stack of their
+            // own as those might need to suspend
+            std::ptrdiff_t size = threads::get_self_stacksize();
+            if (size != HPX_NOSTACK_STACK_SIZE)
+                return size;
+            stacksize = threads::thread_stacksize_default;
+        }
 
         return get_runtime().get_config().get_stack_size(stacksize);
     }
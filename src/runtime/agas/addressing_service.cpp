@@ -32,6 +32,8 @@
 #include <hpx/runtime/naming/split_gid.hpp>
 #include <hpx/util/bind.hpp>
 #include <hpx/util/format.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
 #include <hpx/util/logging.hpp>
 #include <hpx/util/runtime_configuration.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
@@ -58,72 +60,6 @@
 
 namespace hpx { namespace agas
 {
-    struct addressing_service::gva_cache_key
-    {    // {{{ gva_cache_key implementation
-    private:
-        typedef std::pair<naming::gid_type, naming::gid_type> key_type;
-
-        key_type key_;
-
-    public:
-        gva_cache_key()
-          : key_()
-        {
-        }
-
-        explicit gva_cache_key(
-                naming::gid_type const& id, std::uint64_t count = 1)
-          : key_(naming::detail::get_stripped_gid(id),
-                naming::detail::get_stripped_gid(id) + (count - 1))
-        {
-            HPX_ASSERT(count);
-        }
-
-        naming::gid_type get_gid() const
-        {
-            return key_.first;
-        }
-
-        std::uint64_t get_count() const
-        {
-            naming::gid_type const size = key_.second - key_.first;
-            HPX_ASSERT(size.get_msb() == 0);
-            return size.get_lsb();
-        }
-
-        friend bool operator<(
-            gva_cache_key const& lhs, gva_cache_key const& rhs)
-        {
-            return lhs.key_.second < rhs.key_.first;
-        }
-
-        friend bool operator==(
-            gva_cache_key const& lhs, gva_cache_key const& rhs)
-        {
-            // Direct hit
-            if (lhs.key_ == rhs.key_)
-            {
-                return true;
-            }
-
-            // Is lhs in rhs?
-            if (1 == lhs.get_count() && 1 != rhs.get_count())
-            {
-                return rhs.key_.first <= lhs.key_.first &&
-                    lhs.key_.second <= rhs.key_.second;
-            }
-
-            // Is rhs in lhs?
-            else if (1 != lhs.get_count() && 1 == rhs.get_count())
-            {
-                return lhs.key_.first <= rhs.key_.first &&
-                    rhs.key_.second <= lhs.key_.second;
-            }
-
-            return false;
-        }
-    }; // }}}
-
 addressing_service::addressing_service(
     parcelset::parcelhandler& ph
   , util::runtime_configuration const& ini_
@@ -132,9 +68,19 @@ addressing_service::addressing_service(
   : gva_cache_(new gva_cache_type)
   , console_cache_(naming::invalid_locality_id)
   , max_refcnt_requests_(ini_.get_agas_max_pending_refcnt_requests())
-  , refcnt_requests_count_(0)
+  , refcnt_requests_flush_interval_(
+        ini_.get_agas_refcnt_flush_interval() * 1000)
+  , refcnt_requests_started_(0)
   , enable_refcnt_caching_(true)
   , refcnt_requests_(new refcnt_requests_type)
+  , refcnt_merged_count_(0)
+  , refcnt_sent_count_(0)
+  , refcnt_messages_count_(0)
+  , migration_count_(0)
+  , migration_downtime_(0)
+  , migration_precopy_count_(0)
+  , migration_recopy_count_(0)
+  , migration_precopy_time_(0)
   , service_type(ini_.get_agas_service_mode())
   , runtime_type(runtime_type_)
   , caching_(ini_.get_agas_caching_mode())
@@ -1476,6 +1422,8 @@ lcos::future<std::int64_t> addressing_service::incref_async(
         iterator matches = refcnt_requests_->find(raw);
         if (matches != refcnt_requests_->end())
         {
+            ++refcnt_merged_count_;
+
             pending_decrefs = matches->second;
             matches->second += credit;
 
@@ -1520,16 +1468,153 @@ lcos::future<std::int64_t> addressing_service::incref_async(
 
     naming::gid_type const e_lower = pending_incref.first;
 
-    lcos::future<std::int64_t> f =
-        primary_ns_.increment_credit(pending_incref.second, e_lower, e_lower);
+    std::uint32_t const locality_id =
+        naming::get_locality_id_from_gid(e_lower);
+    if (locality_id == naming::get_locality_id_from_gid(get_local_locality()))
+    {
+        // the credits of local objects are incremented right away
+        lcos::future<std::int64_t> f = primary_ns_.increment_credit(
+            pending_incref.second, e_lower, e_lower);
+
+        // pass the amount of compensated decrefs to the callback
+        using util::placeholders::_1;
+        return f.then(util::bind(
+                util::one_shot(&addressing_service::synchronize_with_async_incref),
+                this, _1, keep_alive, pending_decrefs
+            ));
+    }
+
+    // Increments for remote objects are merged with the increments for
+    // the same locality which are waiting for an outstanding request to be
+    // acknowledged.
+    hpx::shared_future<void> f;
+
+    {
+        std::unique_lock<mutex_type> l(refcnt_requests_mtx_);
+
+        incref_requests& pending = incref_requests_[locality_id];
+
+        std::pair<refcnt_requests_type::iterator, bool> p =
+            pending.requests_.insert(pending_incref);
+        if (!p.second)
+        {
+            ++refcnt_merged_count_;
+            p.first->second += pending_incref.second;
+        }
+
+        if (!pending.promise_)
+        {
+            pending.promise_ = std::make_shared<lcos::local::promise<void> >();
+            pending.future_ = pending.promise_->get_future();
+        }
+        f = pending.future_;
+
+        if (!pending.in_flight_)
+        {
+            pending.in_flight_ = true;
+            send_incref_requests(l, locality_id);
+        }
+    }
+
+    // pass the amount of compensated decrefs to the callback, keep the
+    // object alive until the increment has been acknowledged
+    return f.then(
+        [keep_alive, pending_decrefs](hpx::shared_future<void> f)
+        -> std::int64_t
+        {
+            f.get();            // re-throw possible errors
+            return pending_decrefs;
+        });
+} // }}}
+
+void addressing_service::send_incref_requests(
+    std::unique_lock<mutex_type>& l
+  , std::uint32_t locality_id
+    )
+{
+    HPX_ASSERT(l.owns_lock());
+
+    incref_requests& pending = incref_requests_[locality_id];
+    HPX_ASSERT(pending.in_flight_);
+
+    if (pending.requests_.empty())
+    {
+        pending.in_flight_ = false;
+        l.unlock();
+        return;
+    }
+
+    std::vector<
+        hpx::util::tuple<std::int64_t, naming::gid_type, naming::gid_type>
+    > requests;
+    requests.reserve(pending.requests_.size());
+
+    for (refcnt_requests_type::const_reference e : pending.requests_)
+    {
+        HPX_ASSERT(e.second > 0);
+        requests.push_back(hpx::util::make_tuple(e.second, e.first, e.first));
+    }
+    pending.requests_.clear();
+
+    std::shared_ptr<lcos::local::promise<void> > p;
+    p.swap(pending.promise_);
+    pending.future_ = hpx::shared_future<void>();
+
+    // Piggyback all buffered decrements for objects managed by the same
+    // locality. They are applied after the increments, which makes sure
+    // that no credits are released before the corresponding increment
+    // has been accounted for. The gids of one locality form a contiguous
+    // range of the (sorted) table of pending requests.
+    refcnt_requests_type::iterator it = refcnt_requests_->lower_bound(
+        naming::get_gid_from_locality_id(locality_id));
+    while (it != refcnt_requests_->end() &&
+        naming::get_locality_id_from_gid(it->first) == locality_id)
+    {
+        HPX_ASSERT(it->second < 0);
+        requests.push_back(
+            hpx::util::make_tuple(it->second, it->first, it->first));
+        it = refcnt_requests_->erase(it);
+    }
+
+    l.unlock();
+
+    refcnt_sent_count_ += requests.size();
+    ++refcnt_messages_count_;
+
+    naming::id_type target(
+        primary_namespace::get_service_instance(locality_id)
+      , naming::id_type::unmanaged);
+
+    server::primary_namespace::decrement_credit_action action;
+    hpx::future<std::vector<std::int64_t> > f =
+        hpx::async(action, std::move(target), std::move(requests));
 
-    // pass the amount of compensated decrefs to the callback
     using util::placeholders::_1;
-    return f.then(util::bind(
-            util::one_shot(&addressing_service::synchronize_with_async_incref),
-            this, _1, keep_alive, pending_decrefs
+    f.then(util::bind(
+            util::one_shot(
+                &addressing_service::synchronize_with_incref_requests),
+            this, _1, locality_id, std::move(p)
         ));
-} // }}}
+}
+
+void addressing_service::synchronize_with_incref_requests(
+    hpx::future<std::vector<std::int64_t> > f
+  , std::uint32_t locality_id
+  , std::shared_ptr<lcos::local::promise<void> > const& p
+    )
+{
+    try {
+        f.get();
+        p->set_value();
+    }
+    catch (...) {
+        p->set_exception(std::current_exception());
+    }
+
+    // send the increments which have arrived in the meantime
+    std::unique_lock<mutex_type> l(refcnt_requests_mtx_);
+    send_incref_requests(l, locality_id);
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 void addressing_service::decref(
@@ -1576,10 +1661,17 @@ void addressing_service::decref(
         iterator matches = refcnt_requests_->find(raw);
         if (matches != refcnt_requests_->end())
         {
+            ++refcnt_merged_count_;
             matches->second -= credit;
         }
         else
         {
+            if (refcnt_requests_->empty())
+            {
+                refcnt_requests_started_ =
+                    util::high_resolution_clock::now();
+            }
+
             std::pair<iterator, bool> p =
                 refcnt_requests_->insert(mapping(raw, -credit));
 
@@ -1777,17 +1869,6 @@ bool addressing_service::iterate_ids(
     }
 } // }}}
 
-// This function has to return false if the key is already in the cache (true
-// means go ahead with the cache update).
-bool check_for_collisions(
-    addressing_service::gva_cache_key const& new_key
-  , addressing_service::gva_cache_key const& old_key
-    )
-{
-    return (new_key.get_gid() != old_key.get_gid())
-        || (new_key.get_count() != old_key.get_count());
-}
-
 void addressing_service::update_cache_entry(
     naming::gid_type const& id
   , gva const& g
@@ -1849,35 +1930,15 @@ void addressing_service::update_cache_entry(
             "addressing_service::update_cache_entry, gid(%1%), count(%2%)",
             gid, count);
 
-        const gva_cache_key key(gid, count);
-
+        naming::gid_type old_gid;
+        std::uint64_t old_count = 0;
+        if (!gva_cache_->update_entry(gid, count, g, old_gid, old_count))
         {
-            std::unique_lock<mutex_type> lock(gva_cache_mtx_);
-            if (!gva_cache_->update_if(key, g, check_for_collisions))
-            {
-                if (LAGAS_ENABLED(warning))
-                {
-                    // Figure out who we collided with.
-                    addressing_service::gva_cache_key idbase;
-                    addressing_service::gva_cache_type::entry_type e;
-
-                    if (!gva_cache_->get_entry(key, idbase, e))
-                    {
-                        // This is impossible under sane conditions.
-                        lock.unlock();
-                        HPX_THROWS_IF(ec, invalid_data
-                          , "addressing_service::update_cache_entry"
-                          , "data corruption or lock error occurred in cache");
-                        return;
-                    }
-
-                    LAGAS_(warning) << hpx::util::format(
-                        "addressing_service::update_cache_entry, "
-                        "aborting update due to key collision in cache, "
-                        "new_gid(%1%), new_count(%2%), old_gid(%3%), old_count(%4%)",
-                        gid, count, idbase.get_gid(), idbase.get_count());
-                }
-            }
+            LAGAS_(warning) << hpx::util::format(
+                "addressing_service::update_cache_entry, "
+                "aborting update due to key collision in cache, "
+                "new_gid(%1%), new_count(%2%), old_gid(%3%), old_count(%4%)",
+                gid, count, old_gid, old_count);
         }
 
         if (&ec != &throws)
@@ -1900,24 +1961,20 @@ bool addressing_service::get_cache_entry(
     {
         return false;
     }
-    gva_cache_key k(gid);
-    gva_cache_key idbase_key;
-
-    std::unique_lock<mutex_type> lock(gva_cache_mtx_);
-    if(gva_cache_->get_entry(k, idbase_key, gva))
+    naming::gid_type base;
+    if (gva_cache_->get_entry(gid, base, gva))
     {
         const std::uint64_t id_msb =
             naming::detail::strip_internal_bits_from_gid(gid.get_msb());
 
-        if (HPX_UNLIKELY(id_msb != idbase_key.get_gid().get_msb()))
+        if (HPX_UNLIKELY(id_msb != base.get_msb()))
         {
-            lock.unlock();
             HPX_THROWS_IF(ec, internal_server_error
               , "addressing_service::get_cache_entry"
               , "bad entry in cache, MSBs of GID base and GID do not match");
             return false;
         }
-        idbase = idbase_key.get_gid();
+        idbase = base;
         return true;
     }
 
@@ -1940,8 +1997,6 @@ void addressing_service::clear_cache(
     try {
         LAGAS_(warning) << "addressing_service::clear_cache, clearing cache";
 
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-
         gva_cache_->clear();
 
         if (&ec != &throws)
@@ -1987,13 +2042,7 @@ void addressing_service::remove_cache_entry(
     try {
         LAGAS_(warning) << "addressing_service::remove_cache_entry";
 
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-
-        gva_cache_->erase(
-            [&gid](std::pair<gva_cache_key, gva> const& p)
-            {
-                return gid == p.first.get_gid();
-            });
+        gva_cache_->erase(gid);
 
         if (&ec != &throws)
             ec = make_success_code();
@@ -2138,81 +2187,160 @@ namespace detail
 // Helper functions to access the current cache statistics
 std::uint64_t addressing_service::get_cache_entries(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->size();
 }
 
 std::uint64_t addressing_service::get_cache_hits(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().hits(reset);
+    return gva_cache_->get_statistics(
+        [reset](gva_cache_type::statistics_type& s)
+        {
+            return s.hits(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_misses(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().misses(reset);
+    return gva_cache_->get_statistics(
+        [reset](gva_cache_type::statistics_type& s)
+        {
+            return s.misses(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_evictions(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().evictions(reset);
+    return gva_cache_->get_statistics(
+        [reset](gva_cache_type::statistics_type& s)
+        {
+            return s.evictions(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_insertions(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().insertions(reset);
+    return gva_cache_->get_statistics(
+        [reset](gva_cache_type::statistics_type& s)
+        {
+            return s.insertions(reset);
+        });
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 std::uint64_t addressing_service::get_cache_get_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_get_entry_count(reset);
+    return gva_cache_->get_statistics(
+        [reset](gva_cache_type::statistics_type& s)
+        {
+            return s.get_get_entry_count(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_insertion_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_insert_entry_count(reset);
+    return gva_cache_->get_statistics(
+        [reset](gva_cache_type::statistics_type& s)
+        {
+            return s.get_insert_entry_count(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_update_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_update_entry_count(reset);
+    return gva_cache_->get_statistics(
+        [reset](gva_cache_type::statistics_type& s)
+        {
+            return s.get_update_entry_count(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_erase_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_erase_entry_count(reset);
+    return gva_cache_->get_statistics(
+        [reset](gva_cache_type::statistics_type& s)
+        {
+            return s.get_erase_entry_count(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_get_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_get_entry_time(reset);
+    return gva_cache_->get_statistics(
+        [reset](gva_cache_type::statistics_type& s)
+        {
+            return s.get_get_entry_time(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_insertion_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_insert_entry_time(reset);
+    return gva_cache_->get_statistics(
+        [reset](gva_cache_type::statistics_type& s)
+        {
+            return s.get_insert_entry_time(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_update_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_update_entry_time(reset);
+    return gva_cache_->get_statistics(
+        [reset](gva_cache_type::statistics_type& s)
+        {
+            return s.get_update_entry_time(reset);
+        });
 }
 
 std::uint64_t addressing_service::get_cache_erase_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_erase_entry_time(reset);
+    return gva_cache_->get_statistics(
+        [reset](gva_cache_type::statistics_type& s)
+        {
+            return s.get_erase_entry_time(reset);
+        });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Helper functions to access the reference counting statistics
+std::uint64_t addressing_service::get_refcnt_merged_count(bool reset)
+{
+    return util::get_and_reset_value(refcnt_merged_count_, reset);
+}
+
+std::uint64_t addressing_service::get_refcnt_sent_count(bool reset)
+{
+    return util::get_and_reset_value(refcnt_sent_count_, reset);
+}
+
+std::uint64_t addressing_service::get_refcnt_messages_count(bool reset)
+{
+    return util::get_and_reset_value(refcnt_messages_count_, reset);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Helper functions to access the migration statistics
+std::uint64_t addressing_service::get_migration_count(bool reset)
+{
+    return util::get_and_reset_value(migration_count_, reset);
+}
+
+std::uint64_t addressing_service::get_migration_downtime(bool reset)
+{
+    return util::get_and_reset_value(migration_downtime_, reset);
+}
+
+std::uint64_t addressing_service::get_migration_precopy_count(bool reset)
+{
+    return util::get_and_reset_value(migration_precopy_count_, reset);
+}
+
+std::uint64_t addressing_service::get_migration_recopy_count(bool reset)
+{
+    return util::get_and_reset_value(migration_recopy_count_, reset);
+}
+
+std::uint64_t addressing_service::get_migration_precopy_time(bool reset)
+{
+    return util::get_and_reset_value(migration_precopy_time_, reset);
 }
 
 /// Install performance counter types exposing properties from the local cache.
@@ -2259,6 +2387,27 @@ void addressing_service::register_counter_types()
         util::bind(
             &addressing_service::get_cache_erase_entry_time, this, _1));
 
+    util::function_nonser<std::int64_t(bool)> refcnt_merged_count(
+        util::bind(&addressing_service::get_refcnt_merged_count, this, _1));
+    util::function_nonser<std::int64_t(bool)> refcnt_sent_count(
+        util::bind(&addressing_service::get_refcnt_sent_count, this, _1));
+    util::function_nonser<std::int64_t(bool)> refcnt_messages_count(
+        util::bind(&addressing_service::get_refcnt_messages_count, this, _1));
+
+    util::function_nonser<std::int64_t(bool)> migration_count(
+        util::bind(&addressing_service::get_migration_count, this, _1));
+    util::function_nonser<std::int64_t(bool)> migration_downtime(
+        util::bind(&addressing_service::get_migration_downtime, this, _1));
+    util::function_nonser<std::int64_t(bool)> migration_precopy_count(
+        util::bind(
+            &addressing_service::get_migration_precopy_count, this, _1));
+    util::function_nonser<std::int64_t(bool)> migration_recopy_count(
+        util::bind(
+            &addressing_service::get_migration_recopy_count, this, _1));
+    util::function_nonser<std::int64_t(bool)> migration_precopy_time(
+        util::bind(
+            &addressing_service::get_migration_precopy_time, this, _1));
+
     performance_counters::generic_counter_type_data const counter_types[] =
     {
         { "/agas/count/cache/entries", performance_counters::counter_raw,
@@ -2373,6 +2522,77 @@ void addressing_service::register_counter_types()
           &performance_counters::locality_counter_discoverer,
           ""
         },
+        { "/agas/count/refcnt/merged", performance_counters::counter_raw,
+          "returns the number of reference count updates which were merged "
+                "with a pending update for the same object",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, refcnt_merged_count, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
+        { "/agas/count/refcnt/sent", performance_counters::counter_raw,
+          "returns the number of reference count updates sent to AGAS",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, refcnt_sent_count, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
+        { "/agas/count/refcnt/messages", performance_counters::counter_raw,
+          "returns the number of messages used to send reference count "
+                "updates to AGAS",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, refcnt_messages_count, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
+        { "/agas/count/migration/completed", performance_counters::counter_raw,
+          "returns the number of objects which were migrated away from this "
+                "locality",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, migration_count, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
+        { "/agas/time/migration/downtime", performance_counters::counter_raw,
+          "returns the overall time during which objects being migrated away "
+                "from this locality were not able to serve requests",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, migration_downtime, _2),
+          &performance_counters::locality_counter_discoverer,
+          "ns"
+        },
+        { "/agas/count/migration/precopied", performance_counters::counter_raw,
+          "returns the number of objects which were copied to their new "
+                "location while still serving requests (live migration)",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, migration_precopy_count, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
+        { "/agas/count/migration/recopied", performance_counters::counter_raw,
+          "returns the number of live migrations which had to copy the "
+                "object again as it was modified after being pre-copied",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, migration_recopy_count, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
+        { "/agas/time/migration/precopy", performance_counters::counter_raw,
+          "returns the overall time spent copying objects to their new "
+                "location while they were still serving requests",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, migration_precopy_time, _2),
+          &performance_counters::locality_counter_discoverer,
+          "ns"
+        },
     };
     performance_counters::install_counter_types(
         counter_types, sizeof(counter_types)/sizeof(counter_types[0]));
@@ -2412,6 +2632,25 @@ void addressing_service::garbage_collect(
     send_refcnt_requests_sync(l, ec);
 }
 
+void addressing_service::garbage_collect_expired_non_blocking(
+    error_code& ec
+    )
+{
+    std::unique_lock<mutex_type> l(refcnt_requests_mtx_, std::try_to_lock);
+    if (!l.owns_lock()) return;     // no need to compete for garbage collection
+
+    if (refcnt_requests_->empty() ||
+        util::high_resolution_clock::now() - refcnt_requests_started_ <
+            refcnt_requests_flush_interval_)
+    {
+        if (&ec != &throws)
+            ec = make_success_code();
+        return;
+    }
+
+    send_refcnt_requests_non_blocking(l, ec);
+}
+
 void addressing_service::send_refcnt_requests(
     std::unique_lock<addressing_service::mutex_type>& l
   , error_code& ec
@@ -2425,8 +2664,16 @@ void addressing_service::send_refcnt_requests(
         return;
     }
 
-    if (!enable_refcnt_caching_ || max_refcnt_requests_ == ++refcnt_requests_count_)
+    // Send the buffered requests if there are too many of them or if the
+    // oldest has been waiting for too long. Repeated updates for the same gid
+    // are merged, only the number of distinct gids is taken into account.
+    if (!enable_refcnt_caching_ ||
+        refcnt_requests_->size() >= max_refcnt_requests_ ||
+        util::high_resolution_clock::now() - refcnt_requests_started_ >=
+            refcnt_requests_flush_interval_)
+    {
         send_refcnt_requests_non_blocking(l, ec);
+    }
 
     else if (&ec != &throws)
         ec = make_success_code();
@@ -2480,7 +2727,6 @@ void addressing_service::send_refcnt_requests_non_blocking(
         std::shared_ptr<refcnt_requests_type> p(new refcnt_requests_type);
 
         p.swap(refcnt_requests_);
-        refcnt_requests_count_ = 0;
 
         l.unlock();
 
@@ -2519,6 +2765,9 @@ void addressing_service::send_refcnt_requests_non_blocking(
             requests[target].push_back(hpx::util::make_tuple(e.second, raw, raw));
         }
 
+        refcnt_sent_count_ += p->size();
+        refcnt_messages_count_ += requests.size();
+
         // send requests to all locality
         requests_type::iterator end = requests.end();
         for (requests_type::iterator it = requests.begin(); it != end; ++it)
@@ -2553,7 +2802,6 @@ addressing_service::send_refcnt_requests_async(
     std::shared_ptr<refcnt_requests_type> p(new refcnt_requests_type);
 
     p.swap(refcnt_requests_);
-    refcnt_requests_count_ = 0;
 
     l.unlock();
 
@@ -2593,6 +2841,9 @@ addressing_service::send_refcnt_requests_async(
         requests[target].push_back(hpx::util::make_tuple(e.second, raw, raw));
     }
 
+    refcnt_sent_count_ += p->size();
+    refcnt_messages_count_ += requests.size();
+
     // send requests to all locality
     requests_type::const_iterator end = requests.end();
     for (requests_type::const_iterator it = requests.begin(); it != end; ++it)
@@ -2711,6 +2962,21 @@ void addressing_service::unmark_as_migrated(
     }
 }
 
+void addressing_service::report_migration_downtime(std::uint64_t downtime)
+{
+    ++migration_count_;
+    migration_downtime_ += downtime;
+}
+
+void addressing_service::report_migration_precopy(
+    std::uint64_t precopy_time, bool recopied)
+{
+    ++migration_precopy_count_;
+    if (recopied)
+        ++migration_recopy_count_;
+    migration_precopy_time_ += precopy_time;
+}
+
 hpx::future<std::pair<naming::id_type, naming::address> >
 addressing_service::begin_migration_async(naming::id_type const& id)
 {
@@ -328,6 +328,13 @@ void garbage_collect(
     naming::get_agas_client().garbage_collect(ec);
 }
 
+void garbage_collect_expired_non_blocking(
+    error_code& ec
+    )
+{
+    naming::get_agas_client().garbage_collect_expired_non_blocking(ec);
+}
+
 /// \brief Invoke an asynchronous garbage collection step on the given target
 ///        locality.
 void garbage_collect_non_blocking(
@@ -517,5 +524,17 @@ void unmark_as_migrated(naming::gid_type const& gid)
     return resolver.unmark_as_migrated(gid);
 }
 
+void report_migration_downtime(std::uint64_t downtime)
+{
+    naming::resolver_client& resolver = naming::get_agas_client();
+    resolver.report_migration_downtime(downtime);
+}
+
+void report_migration_precopy(std::uint64_t precopy_time, bool recopied)
+{
+    naming::resolver_client& resolver = naming::get_agas_client();
+    resolver.report_migration_precopy(precopy_time, recopied);
+}
+
 }}
 
@@ -221,6 +221,72 @@ serialization::binary_filter* primary_namespace::get_serialization_filter(
     return routed_p.get_serialization_filter();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+std::size_t primary_namespace::get_shard_index(naming::gid_type const& id)
+{
+    // Fibonacci hashing spreads neighboring blocks over the shards
+    std::uint64_t key =
+        naming::detail::strip_internal_bits_from_gid(id.get_msb()) ^
+        (id.get_lsb() >> gid_block_bits);
+    key *= 0x9e3779b97f4a7c15ull;
+    return static_cast<std::size_t>(key >> 32) & (num_shards - 1);
+}
+
+naming::gid_type primary_namespace::get_block_base(
+    naming::gid_type const& id, std::uint64_t block)
+{
+    return naming::gid_type(id.get_msb(),
+        ((id.get_lsb() >> gid_block_bits) + block) << gid_block_bits);
+}
+
+std::uint64_t primary_namespace::get_num_blocks(
+    naming::gid_type const& id, std::uint64_t count)
+{
+    // the caller makes sure that the range doesn't cross the MSB
+    naming::gid_type const upper(id + (count - 1));
+    return (upper.get_lsb() >> gid_block_bits) -
+        (id.get_lsb() >> gid_block_bits) + 1;
+}
+
+// Store (or update) the fragments of the given range which belong to the
+// blocks following the first one. The shards are locked one at a time.
+void primary_namespace::store_range_fragments(
+    naming::gid_type const& id
+  , std::uint64_t num_blocks
+  , gva_table_data_type const& data
+    )
+{
+    for (std::uint64_t i = 1; i < num_blocks; ++i)
+    {
+        naming::gid_type const key = get_block_base(id, i);
+        shard& s = get_shard(key);
+
+        std::lock_guard<mutex_type> l(s.mutex_);
+
+        gva_fragment& f = s.gvas_[key];
+        f.base_ = id;
+        f.data_ = data;
+    }
+}
+
+void primary_namespace::erase_range_fragments(
+    naming::gid_type const& id
+  , std::uint64_t num_blocks
+    )
+{
+    for (std::uint64_t i = 1; i < num_blocks; ++i)
+    {
+        naming::gid_type const key = get_block_base(id, i);
+        shard& s = get_shard(key);
+
+        std::lock_guard<mutex_type> l(s.mutex_);
+
+        gva_fragment_table_type::iterator it = s.gvas_.find(key);
+        if (it != s.gvas_.end() && it->second.base_ == id)
+            s.gvas_.erase(it);
+    }
+}
+
 // start migration of the given object
 std::pair<naming::id_type, naming::address>
 primary_namespace::begin_migration(naming::gid_type id)
@@ -231,7 +297,8 @@ primary_namespace::begin_migration(naming::gid_type id)
     counter_data_.increment_begin_migration_count();
     using hpx::util::get;
 
-    std::unique_lock<mutex_type> l(mutex_);
+    shard& s = get_shard(id);
+    std::unique_lock<mutex_type> l(s.mutex_);
 
     resolved_type r = resolve_gid_locked(l, id, hpx::throws);
     if (get<0>(r) == naming::invalid_gid)
@@ -245,11 +312,11 @@ primary_namespace::begin_migration(naming::gid_type id)
         return std::make_pair(naming::invalid_id, naming::address());
     }
 
-    migration_table_type::iterator it = migrating_objects_.find(id);
-    if (it == migrating_objects_.end())
+    migration_table_type::iterator it = s.migrating_objects_.find(id);
+    if (it == s.migrating_objects_.end())
     {
         std::pair<migration_table_type::iterator, bool> p =
-            migrating_objects_.emplace(std::piecewise_construct,
+            s.migrating_objects_.emplace(std::piecewise_construct,
                 std::forward_as_tuple(id), std::forward_as_tuple());
         HPX_ASSERT(p.second);
         it = p.first;
@@ -272,12 +339,13 @@ bool primary_namespace::end_migration(naming::gid_type id)
     );
     counter_data_.increment_end_migration_count();
 
-    std::unique_lock<mutex_type> l(mutex_);
+    shard& s = get_shard(id);
+    std::unique_lock<mutex_type> l(s.mutex_);
 
     using hpx::util::get;
 
-    migration_table_type::iterator it = migrating_objects_.find(id);
-    if (it == migrating_objects_.end() || !get<0>(it->second))
+    migration_table_type::iterator it = s.migrating_objects_.find(id);
+    if (it == s.migrating_objects_.end() || !get<0>(it->second))
         return false;
 
     // ignore before notifying everyone about the ended migration.
@@ -289,6 +357,19 @@ bool primary_namespace::end_migration(naming::gid_type id)
     // flag this id as not being migrated anymore
     get<0>(it->second) = false;
 
+    std::vector<parcelset::parcel> parcels;
+    std::swap(parcels, get<3>(it->second));
+
+    if (get<1>(it->second) == 0)
+        s.migrating_objects_.erase(it);
+
+    l.unlock();
+
+    // route all parcels which have arrived while the object was being
+    // migrated, this will deliver them to the new location of the object
+    for (parcelset::parcel& p : parcels)
+        route(std::move(p));
+
     return true;
 }
 
@@ -302,15 +383,18 @@ void primary_namespace::wait_for_migration_locked(
 
     using hpx::util::get;
 
-    migration_table_type::iterator it = migrating_objects_.find(id);
-    if (it != migrating_objects_.end() && get<0>(it->second))
+    shard& s = get_shard(id);
+    HPX_ASSERT(l.mutex() == &s.mutex_);
+
+    migration_table_type::iterator it = s.migrating_objects_.find(id);
+    if (it != s.migrating_objects_.end() && get<0>(it->second))
     {
         ++get<1>(it->second);
 
         get<2>(it->second).wait(l, ec);
 
         if (--get<1>(it->second) == 0 && !get<0>(it->second))
-            migrating_objects_.erase(it);
+            s.migrating_objects_.erase(it);
     }
 }
 
@@ -328,24 +412,32 @@ bool primary_namespace::bind_gid(
 
     naming::detail::strip_internal_bits_from_gid(id);
 
-    std::unique_lock<mutex_type> l(mutex_);
+    naming::gid_type upper_bound(id + (g.count - 1));
 
-    gva_table_type::iterator it = gvas_.lower_bound(id)
-                           , begin = gvas_.begin()
-                           , end = gvas_.end();
+    if (HPX_UNLIKELY(id.get_msb() != upper_bound.get_msb()))
+    {
+        HPX_THROW_EXCEPTION(internal_server_error
+          , "primary_namespace::bind_gid"
+          , "MSBs of lower and upper range bound do not match");
+    }
 
-    if (it != end)
+    std::uint64_t const num_blocks = get_num_blocks(id, g.count);
+    gva_table_data_type const data(g, locality);
+
+    shard& s = get_shard(id);
+    std::unique_lock<mutex_type> l(s.mutex_);
+
+    // Look for an existing range covering the new id.
+    resolved_type r = resolve_gid_locked(l, id, hpx::throws);
+    if (get<0>(r))
     {
         // If we got an exact match, this is a request to update an existing
         // binding (e.g. move semantics).
-        if (it->first == id)
+        if (get<0>(r) == id)
         {
-            gva& gaddr = it->second.first;
-            naming::gid_type& loc = it->second.second;
-
             // Check for count mismatch (we can't change block sizes of
             // existing bindings).
-            if (HPX_UNLIKELY(gaddr.count != g.count))
+            if (HPX_UNLIKELY(get<1>(r).count != g.count))
             {
                 // REVIEW: Is this the right error code to use?
                 l.unlock();
@@ -380,13 +472,29 @@ bool primary_namespace::bind_gid(
             }
 
             // Store the new endpoint and offset
-            gaddr.prefix = g.prefix;
-            gaddr.type   = g.type;
-            gaddr.lva(g.lva());
-            gaddr.offset = g.offset;
-            loc = locality;
+            if (num_blocks > max_range_fragments)
+            {
+                hpx::util::ignore_while_checking<
+                    std::unique_lock<mutex_type>
+                > il(&l);
+                std::lock_guard<mutex_type> ll(large_gvas_mutex_);
+
+                gva_table_type::iterator it = large_gvas_.find(id);
+                HPX_ASSERT(it != large_gvas_.end());
+                it->second = data;
+            }
+            else
+            {
+                gva_fragment_table_type::iterator it = s.gvas_.find(id);
+                HPX_ASSERT(it != s.gvas_.end());
+                it->second.data_ = data;
 
-            l.unlock();
+                l.unlock();
+                store_range_fragments(id, num_blocks, data);
+            }
+
+            if (l.owns_lock())
+                l.unlock();
 
             LAGAS_(info) << hpx::util::format(
                 "primary_namespace::bind_gid, gid(%1%), gva(%2%), "
@@ -396,50 +504,14 @@ bool primary_namespace::bind_gid(
             return false;
         }
 
-        // We're about to decrement the iterator it - first, we
-        // check that it's safe to do this.
-        else if (it != begin)
-        {
-            --it;
-
-            // Check that a previous range doesn't cover the new id.
-            if (HPX_UNLIKELY((it->first + it->second.first.count) > id))
-            {
-                // REVIEW: Is this the right error code to use?
-                l.unlock();
-
-                HPX_THROW_EXCEPTION(bad_parameter
-                  , "primary_namespace::bind_gid"
-                  , "the new GID is contained in an existing range");
-            }
-        }
-    }
-
-    else if (HPX_LIKELY(!gvas_.empty()))
-    {
-        --it;
-
         // Check that a previous range doesn't cover the new id.
-        if ((it->first + it->second.first.count) > id)
-        {
-            // REVIEW: Is this the right error code to use?
-            l.unlock();
-
-            HPX_THROW_EXCEPTION(bad_parameter
-              , "primary_namespace::bind_gid"
-              , "the new GID is contained in an existing range");
-        }
-    }
 
-    naming::gid_type upper_bound(id + (g.count - 1));
-
-    if (HPX_UNLIKELY(id.get_msb() != upper_bound.get_msb()))
-    {
+        // REVIEW: Is this the right error code to use?
         l.unlock();
 
-        HPX_THROW_EXCEPTION(internal_server_error
+        HPX_THROW_EXCEPTION(bad_parameter
           , "primary_namespace::bind_gid"
-          , "MSBs of lower and upper range bound do not match");
+          , "the new GID is contained in an existing range");
     }
 
     if (HPX_UNLIKELY(components::component_invalid == g.type))
@@ -455,8 +527,22 @@ bool primary_namespace::bind_gid(
     }
 
     // Insert a GID -> GVA entry into the GVA table.
-    if (HPX_UNLIKELY(!util::insert_checked(gvas_.insert(
-            std::make_pair(id, std::make_pair(g, locality))))))
+    bool inserted = false;
+    if (num_blocks > max_range_fragments)
+    {
+        hpx::util::ignore_while_checking<std::unique_lock<mutex_type>> il(&l);
+        std::lock_guard<mutex_type> ll(large_gvas_mutex_);
+
+        inserted = util::insert_checked(
+            large_gvas_.insert(std::make_pair(id, data)));
+    }
+    else
+    {
+        gva_fragment f = { id, data };
+        inserted = util::insert_checked(s.gvas_.insert(std::make_pair(id, f)));
+    }
+
+    if (HPX_UNLIKELY(!inserted))
     {
         l.unlock();
 
@@ -470,6 +556,9 @@ bool primary_namespace::bind_gid(
 
     l.unlock();
 
+    if (num_blocks <= max_range_fragments)
+        store_range_fragments(id, num_blocks, data);
+
     LAGAS_(info) << hpx::util::format(
         "primary_namespace::bind_gid, gid(%1%), gva(%2%), locality(%3%)",
         id, g, locality);
@@ -488,7 +577,7 @@ primary_namespace::resolved_type primary_namespace::resolve_gid(naming::gid_type
     resolved_type r;
 
     {
-        std::unique_lock<mutex_type> l(mutex_);
+        std::unique_lock<mutex_type> l(get_shard(id).mutex_);
 
         // wait for any migration to be completed
         wait_for_migration_locked(l, id, hpx::throws);
@@ -532,14 +621,34 @@ naming::address primary_namespace::unbind_gid(
 
     naming::detail::strip_internal_bits_from_gid(id);
 
-    std::unique_lock<mutex_type> l(mutex_);
+    shard& s = get_shard(id);
+    std::unique_lock<mutex_type> l(s.mutex_);
 
-    gva_table_type::iterator it = gvas_.find(id)
-                           , end = gvas_.end();
+    gva_table_data_type data;
+    bool found = false;
 
-    if (it != end)
+    gva_fragment_table_type::iterator it = s.gvas_.find(id);
+    if (it != s.gvas_.end() && it->second.base_ == id)
     {
-        if (HPX_UNLIKELY(it->second.first.count != count))
+        data = it->second.data_;
+        found = true;
+    }
+    else
+    {
+        hpx::util::ignore_while_checking<std::unique_lock<mutex_type>> il(&l);
+        std::lock_guard<mutex_type> ll(large_gvas_mutex_);
+
+        gva_table_type::iterator lit = large_gvas_.find(id);
+        if (lit != large_gvas_.end())
+        {
+            data = lit->second;
+            found = true;
+        }
+    }
+
+    if (found)
+    {
+        if (HPX_UNLIKELY(data.first.count != count))
         {
             l.unlock();
 
@@ -548,11 +657,26 @@ naming::address primary_namespace::unbind_gid(
               , "block sizes must match");
         }
 
-        gva_table_data_type data = it->second;
+        std::uint64_t const num_blocks = get_num_blocks(id, count);
+        if (num_blocks > max_range_fragments)
+        {
+            hpx::util::ignore_while_checking<
+                std::unique_lock<mutex_type>
+            > il(&l);
+            std::lock_guard<mutex_type> ll(large_gvas_mutex_);
 
-        gvas_.erase(it);
+            large_gvas_.erase(id);
+        }
+        else
+        {
+            s.gvas_.erase(it);
+        }
 
         l.unlock();
+
+        if (num_blocks <= max_range_fragments)
+            erase_range_fragments(id, num_blocks);
+
         LAGAS_(info) << hpx::util::format(
             "primary_namespace::unbind_gid, gid(%1%), count(%2%), gva(%3%), "
             "locality_id(%4%)",
@@ -640,6 +764,13 @@ std::vector<std::int64_t> primary_namespace::decrement_credit(
 
             free_components_sync(free_list, lower, upper, hpx::throws);
         }
+        // Increment, these are sent along with decrements by clients which
+        // batch their reference count updates.
+        else if (credits > 0)
+        {
+            std::int64_t increment_credits = credits;
+            increment(lower, upper, increment_credits, hpx::throws);
+        }
         else
         {
             HPX_THROW_EXCEPTION(bad_parameter
@@ -717,37 +848,39 @@ std::pair<naming::gid_type, naming::gid_type> primary_namespace::allocate(
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
     void primary_namespace::dump_refcnt_matches(
-        refcnt_table_type::iterator lower_it
-      , refcnt_table_type::iterator upper_it
-      , naming::gid_type const& lower
+        naming::gid_type const& lower
       , naming::gid_type const& upper
-      , std::unique_lock<mutex_type>& l
       , const char* func_name
         )
     { // dump_refcnt_matches implementation
-        HPX_ASSERT(l.owns_lock());
-
-        if (lower_it == refcnts_.end() && upper_it == refcnts_.end())
-            // We got nothing, bail - our caller is probably about to throw.
-            return;
-
         std::stringstream ss;
         hpx::util::format_to(ss,
             "%1%, dumping server-side refcnt table matches, lower(%2%), "
             "upper(%3%):",
             func_name, lower, upper);
 
-        for (/**/; lower_it != upper_it; ++lower_it)
+        bool found = false;
+        for (naming::gid_type raw = lower; raw != upper; ++raw)
         {
+            shard& s = get_shard(raw);
+            std::lock_guard<mutex_type> l(s.mutex_);
+
+            refcnt_table_type::iterator it = s.refcnts_.find(raw);
+            if (it == s.refcnts_.end())
+                continue;
+
             // The [server] tag is in there to make it easier to filter
             // through the logs.
             hpx::util::format_to(ss,
                 "\n  [server] lower(%1%), credits(%2%)",
-                lower_it->first,
-                lower_it->second);
+                it->first,
+                it->second);
+            found = true;
         }
 
-        LAGAS_(debug) << ss.str();
+        // If we got nothing, bail - our caller is probably about to throw.
+        if (found)
+            LAGAS_(debug) << ss.str();
     } // dump_refcnt_matches implementation
 #endif
 
@@ -759,28 +892,10 @@ void primary_namespace::increment(
   , error_code& ec
     )
 { // {{{ increment implementation
-    std::unique_lock<mutex_type> l(mutex_);
-
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
     if (LAGAS_ENABLED(debug))
     {
-        typedef refcnt_table_type::iterator iterator;
-
-        // Find the mappings that we're about to touch.
-        refcnt_table_type::iterator lower_it = refcnts_.find(lower);
-        refcnt_table_type::iterator upper_it;
-        if (lower != upper)
-        {
-            upper_it = refcnts_.find(upper);
-        }
-        else
-        {
-            upper_it = lower_it;
-            ++upper_it;
-        }
-
-        dump_refcnt_matches(lower_it, upper_it, lower, upper, l,
-            "primary_namespace::increment");
+        dump_refcnt_matches(lower, upper, "primary_namespace::increment");
     }
 #endif
 
@@ -796,14 +911,17 @@ void primary_namespace::increment(
 
     for (naming::gid_type raw = lower; raw != upper; ++raw)
     {
-        refcnt_table_type::iterator it = refcnts_.find(raw);
-        if (it == refcnts_.end())
+        shard& s = get_shard(raw);
+        std::unique_lock<mutex_type> l(s.mutex_);
+
+        refcnt_table_type::iterator it = s.refcnts_.find(raw);
+        if (it == s.refcnts_.end())
         {
             std::int64_t count =
                 std::int64_t(HPX_GLOBALCREDIT_INITIAL) + credits;
 
             std::pair<refcnt_table_type::iterator, bool> p =
-                refcnts_.insert(refcnt_table_type::value_type(raw, count));
+                s.refcnts_.insert(refcnt_table_type::value_type(raw, count));
             if (!p.second)
             {
                 l.unlock();
@@ -835,7 +953,8 @@ void primary_namespace::increment(
 
 ///////////////////////////////////////////////////////////////////////////////
 void primary_namespace::resolve_free_list(
-    std::unique_lock<mutex_type>& l
+    shard& s
+  , std::unique_lock<mutex_type>& l
   , std::list<refcnt_table_type::iterator> const& free_list
   , std::list<free_entry>& free_entry_list
   , naming::gid_type const& lower
@@ -844,6 +963,7 @@ void primary_namespace::resolve_free_list(
     )
 {
     HPX_ASSERT_OWNS_LOCK(l);
+    HPX_ASSERT(l.mutex() == &s.mutex_);
 
     using hpx::util::get;
 
@@ -919,7 +1039,7 @@ void primary_namespace::resolve_free_list(
         free_entry_list.push_back(free_entry(resolved, gid, get<2>(r)));
 
         // remove this entry from the refcnt table
-        refcnts_.erase(it);
+        s.refcnts_.erase(it);
     }
 }
 
@@ -939,109 +1059,96 @@ void primary_namespace::decrement_sweep(
 
     free_entry_list.clear();
 
-    {
-        std::unique_lock<mutex_type> l(mutex_);
-
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
-        if (LAGAS_ENABLED(debug))
-        {
-            typedef refcnt_table_type::iterator iterator;
-
-            // Find the mappings that we just added or modified.
-            refcnt_table_type::iterator lower_it = refcnts_.find(lower);
-            refcnt_table_type::iterator upper_it;
-            if (lower != upper)
-            {
-                upper_it = refcnts_.find(upper);
-            }
-            else
-            {
-                upper_it = lower_it;
-                ++upper_it;
-            }
-
-            dump_refcnt_matches(lower_it, upper_it, lower, upper, l,
-                "primary_namespace::decrement_sweep");
-        }
+    if (LAGAS_ENABLED(debug))
+    {
+        dump_refcnt_matches(lower, upper,
+            "primary_namespace::decrement_sweep");
+    }
 #endif
 
-        ///////////////////////////////////////////////////////////////////////
-        // Apply the decrement across the entire key space (e.g. [lower, upper]).
+    ///////////////////////////////////////////////////////////////////////////
+    // Apply the decrement across the entire key space (e.g. [lower, upper]).
 
-        // The third parameter we pass here is the default data to use in case
-        // the key is not mapped. We don't insert GIDs into the refcnt table
-        // when we allocate/bind them, so if a GID is not in the refcnt table,
-        // we know that it's global reference count is the initial global
-        // reference count.
+    // The third parameter we pass here is the default data to use in case
+    // the key is not mapped. We don't insert GIDs into the refcnt table
+    // when we allocate/bind them, so if a GID is not in the refcnt table,
+    // we know that it's global reference count is the initial global
+    // reference count.
 
-        std::list<refcnt_table_type::iterator> free_list;
-        for (naming::gid_type raw = lower; raw != upper; ++raw)
+    for (naming::gid_type raw = lower; raw != upper; ++raw)
+    {
+        shard& s = get_shard(raw);
+        std::unique_lock<mutex_type> l(s.mutex_);
+
+        refcnt_table_type::iterator it = s.refcnts_.find(raw);
+        if (it == s.refcnts_.end())
         {
-            refcnt_table_type::iterator it = refcnts_.find(raw);
-            if (it == refcnts_.end())
-            {
-                if (credits > std::int64_t(HPX_GLOBALCREDIT_INITIAL))
-                {
-                    l.unlock();
-
-                    HPX_THROWS_IF(ec, invalid_data
-                      , "primary_namespace::decrement_sweep"
-                      , hpx::util::format(
-                            "negative entry in reference count table, raw(%1%), "
-                            "refcount(%2%)",
-                            raw,
-                            std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits));
-                    return;
-                }
-
-                std::int64_t count =
-                    std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits;
-
-                std::pair<refcnt_table_type::iterator, bool> p =
-                    refcnts_.insert(refcnt_table_type::value_type(raw, count));
-                if (!p.second)
-                {
-                    l.unlock();
-
-                    HPX_THROWS_IF(ec, invalid_data
-                      , "primary_namespace::decrement_sweep"
-                      , hpx::util::format(
-                            "couldn't create entry in reference count table, "
-                            "raw(%1%), ref-count(%2%)",
-                            raw, count));
-                    return;
-                }
-
-                it = p.first;
-            }
-            else
+            if (credits > std::int64_t(HPX_GLOBALCREDIT_INITIAL))
             {
-                it->second -= credits;
+                l.unlock();
+
+                HPX_THROWS_IF(ec, invalid_data
+                  , "primary_namespace::decrement_sweep"
+                  , hpx::util::format(
+                        "negative entry in reference count table, raw(%1%), "
+                        "refcount(%2%)",
+                        raw,
+                        std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits));
+                return;
             }
 
-            // Sanity check.
-            if (it->second < 0)
+            std::int64_t count =
+                std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits;
+
+            std::pair<refcnt_table_type::iterator, bool> p =
+                s.refcnts_.insert(refcnt_table_type::value_type(raw, count));
+            if (!p.second)
             {
                 l.unlock();
 
                 HPX_THROWS_IF(ec, invalid_data
                   , "primary_namespace::decrement_sweep"
                   , hpx::util::format(
-                        "negative entry in reference count table, raw(%1%), "
-                        "refcount(%2%)",
-                        raw, it->second));
+                        "couldn't create entry in reference count table, "
+                        "raw(%1%), ref-count(%2%)",
+                        raw, count));
                 return;
             }
 
-            // this objects needs to be deleted
-            if (it->second == 0)
-                free_list.push_back(it);
+            it = p.first;
+        }
+        else
+        {
+            it->second -= credits;
+        }
+
+        // Sanity check.
+        if (it->second < 0)
+        {
+            l.unlock();
+
+            HPX_THROWS_IF(ec, invalid_data
+              , "primary_namespace::decrement_sweep"
+              , hpx::util::format(
+                    "negative entry in reference count table, raw(%1%), "
+                    "refcount(%2%)",
+                    raw, it->second));
+            return;
         }
 
-        // Resolve the objects which have to be deleted.
-        resolve_free_list(l, free_list, free_entry_list, lower, upper, ec);
+        // this objects needs to be deleted, resolve it while holding the
+        // lock of its shard
+        if (it->second == 0)
+        {
+            std::list<refcnt_table_type::iterator> free_list;
+            free_list.push_back(it);
 
-    } // Unlock the mutex.
+            resolve_free_list(s, l, free_list, free_entry_list, lower, upper,
+                ec);
+            if (ec) return;
+        }
+    }
 
     if (&ec != &throws)
         ec = make_success_code();
@@ -1107,81 +1214,55 @@ primary_namespace::resolved_type primary_namespace::resolve_gid_locked(
     naming::gid_type id = gid;
     naming::detail::strip_internal_bits_from_gid(id);
 
-    gva_table_type::const_iterator it = gvas_.lower_bound(id)
-                                 , begin = gvas_.begin()
-                                 , end = gvas_.end();
-
-    if (it != end)
-    {
-        // Check for exact match
-        if (it->first == id)
-        {
-            if (&ec != &throws)
-                ec = make_success_code();
-
-            gva_table_data_type const& data = it->second;
-            return resolved_type(it->first, data.first, data.second);
-        }
+    shard& s = get_shard(id);
+    HPX_ASSERT(l.mutex() == &s.mutex_);
 
-        // We need to decrement the iterator, first we check that it's safe
-        // to do this.
-        else if (it != begin)
-        {
-            --it;
-
-            // Found the GID in a range
-            gva_table_data_type const& data = it->second;
-            if ((it->first + data.first.count) > id)
-            {
-                if (HPX_UNLIKELY(id.get_msb() != it->first.get_msb()))
-                {
-                    l.unlock();
+    resolved_type r(naming::invalid_gid, gva(), naming::invalid_gid);
 
-                    HPX_THROWS_IF(ec, internal_server_error
-                      , "primary_namespace::resolve_gid_locked"
-                      , "MSBs of lower and upper range bound do not match");
-                    return resolved_type(naming::invalid_gid, gva(),
-                        naming::invalid_gid);
-                }
-
-                if (&ec != &throws)
-                    ec = make_success_code();
+    // The last fragment starting at or before the given id is the only one
+    // which may cover it (fragments don't overlap).
+    gva_fragment_table_type::const_iterator it = s.gvas_.upper_bound(id);
+    if (it != s.gvas_.begin())
+    {
+        --it;
 
-                return resolved_type(it->first, data.first, data.second);
-            }
-        }
+        gva_fragment const& f = it->second;
+        if ((f.base_ + f.data_.first.count) > id)
+            r = resolved_type(f.base_, f.data_.first, f.data_.second);
     }
 
-    else if (HPX_LIKELY(!gvas_.empty()))
+    // Fall back to the ranges which are not split into fragments.
+    if (!hpx::util::get<0>(r))
     {
-        --it;
+        hpx::util::ignore_while_checking<std::unique_lock<mutex_type>> il(&l);
+        std::lock_guard<mutex_type> ll(large_gvas_mutex_);
 
-        // Found the GID in a range
-        gva_table_data_type const& data = it->second;
-        if ((it->first + data.first.count) > id)
+        gva_table_type::const_iterator lit = large_gvas_.upper_bound(id);
+        if (lit != large_gvas_.begin())
         {
-            if (HPX_UNLIKELY(id.get_msb() != it->first.get_msb()))
-            {
-                l.unlock();
+            --lit;
 
-                HPX_THROWS_IF(ec, internal_server_error
-                  , "primary_namespace::resolve_gid_locked"
-                  , "MSBs of lower and upper range bound do not match");
-                return resolved_type(naming::invalid_gid, gva(),
-                    naming::invalid_gid);
-            }
+            gva_table_data_type const& data = lit->second;
+            if ((lit->first + data.first.count) > id)
+                r = resolved_type(lit->first, data.first, data.second);
+        }
+    }
 
-            if (&ec != &throws)
-                ec = make_success_code();
+    naming::gid_type const& base = hpx::util::get<0>(r);
+    if (base && HPX_UNLIKELY(id.get_msb() != base.get_msb()))
+    {
+        l.unlock();
 
-            return resolved_type(it->first, data.first, data.second);
-        }
+        HPX_THROWS_IF(ec, internal_server_error
+          , "primary_namespace::resolve_gid_locked"
+          , "MSBs of lower and upper range bound do not match");
+        return resolved_type(naming::invalid_gid, gva(), naming::invalid_gid);
     }
 
     if (&ec != &throws)
         ec = make_success_code();
 
-    return resolved_type(naming::invalid_gid, gva(), naming::invalid_gid);
+    return r;
 } // }}}
 
 naming::gid_type primary_namespace::statistics_counter(std::string const& name)
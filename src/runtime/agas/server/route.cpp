@@ -56,10 +56,20 @@ namespace hpx { namespace agas { namespace server
         // resolve destination addresses, we should be able to resolve all of
         // them, otherwise it's an error
         {
-            std::unique_lock<mutex_type> l(mutex_);
-
-            // wait for any migration to be completed
-            wait_for_migration_locked(l, gid, ec);
+            shard& s = get_shard(gid);
+            std::unique_lock<mutex_type> l(s.mutex_);
+
+            // Don't block while the destination object is being migrated,
+            // keep the parcel instead, it will be routed again as soon as
+            // the migration has finished (see end_migration).
+            migration_table_type::iterator it =
+                s.migrating_objects_.find(gid);
+            if (it != s.migrating_objects_.end() &&
+                hpx::util::get<0>(it->second))
+            {
+                hpx::util::get<3>(it->second).push_back(std::move(p));
+                return;
+            }
 
             cache_address = resolve_gid_locked(l, gid, ec);
 
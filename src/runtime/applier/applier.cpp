@@ -252,6 +252,22 @@ namespace hpx { namespace applier
         app->get_thread_manager().register_work(data, state, ec);
     }
 
+    void register_work_plain(
+        threads::thread_init_data* data, std::size_t count,
+        threads::thread_state_enum state, error_code& ec)
+    {
+        hpx::applier::applier* app = hpx::applier::get_applier_ptr();
+        if (nullptr == app)
+        {
+            HPX_THROWS_IF(ec, invalid_status,
+                "hpx::applier::register_work_plain",
+                "global applier object is not accessible");
+            return;
+        }
+
+        app->get_thread_manager().register_work(data, count, state, ec);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::util::thread_specific_ptr<applier*, applier::tls_tag> applier::applier_;
 
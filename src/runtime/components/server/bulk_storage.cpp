@@ -0,0 +1,128 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/error_code.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/applier/bind_naming_wrappers.hpp>
+#include <hpx/runtime/components/server/bulk_storage.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <new>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace components { namespace detail
+{
+    namespace
+    {
+        struct bulk_storage_block
+        {
+            char* begin_;
+            std::size_t count_;         // number of instances
+            std::size_t size_;          // size of one instance
+            std::size_t live_;          // number of instances not freed yet
+            naming::gid_type base_gid_;
+        };
+
+        // All blocks are kept in a table sorted by the address of their
+        // ends, this allows to find the block an instance belongs to.
+        struct bulk_storage_registry
+        {
+            typedef lcos::local::spinlock mutex_type;
+            typedef std::map<char const*, bulk_storage_block> blocks_type;
+
+            // expects the lock to be held
+            blocks_type::iterator find(char const* p)
+            {
+                blocks_type::iterator it = blocks_.upper_bound(p);
+                if (it != blocks_.end() && it->second.begin_ <= p)
+                    return it;
+                return blocks_.end();
+            }
+
+            mutex_type mtx_;
+            blocks_type blocks_;
+        };
+
+        bulk_storage_registry& get_bulk_storage_registry()
+        {
+            static bulk_storage_registry registry;
+            return registry;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void* allocate_bulk_storage(std::size_t count, std::size_t size)
+    {
+        HPX_ASSERT(count != 0 && size != 0);
+
+        bulk_storage_block block;
+        block.begin_ = static_cast<char*>(::operator new(count * size));
+        block.count_ = count;
+        block.size_ = size;
+        block.live_ = count;
+
+        bulk_storage_registry& registry = get_bulk_storage_registry();
+        {
+            std::lock_guard<bulk_storage_registry::mutex_type> l(registry.mtx_);
+            registry.blocks_.insert(bulk_storage_registry::blocks_type::value_type(
+                block.begin_ + count * size, block));
+        }
+
+        return block.begin_;
+    }
+
+    void set_bulk_storage_gid(void* storage, naming::gid_type const& base_gid)
+    {
+        bulk_storage_registry& registry = get_bulk_storage_registry();
+
+        std::lock_guard<bulk_storage_registry::mutex_type> l(registry.mtx_);
+
+        bulk_storage_registry::blocks_type::iterator it =
+            registry.find(static_cast<char const*>(storage));
+
+        HPX_ASSERT(it != registry.blocks_.end());
+        HPX_ASSERT(it->second.begin_ == storage);
+
+        it->second.base_gid_ = naming::detail::get_stripped_gid(base_gid);
+    }
+
+    bool free_bulk_storage(void* p, std::size_t count)
+    {
+        bulk_storage_registry& registry = get_bulk_storage_registry();
+        bulk_storage_block block;
+
+        {
+            std::lock_guard<bulk_storage_registry::mutex_type> l(registry.mtx_);
+
+            bulk_storage_registry::blocks_type::iterator it =
+                registry.find(static_cast<char const*>(p));
+            if (it == registry.blocks_.end())
+                return false;
+
+            HPX_ASSERT(it->second.live_ >= count);
+            it->second.live_ -= count;
+            if (it->second.live_ != 0)
+                return true;
+
+            // the last instance has been freed, release the block
+            block = it->second;
+            registry.blocks_.erase(it);
+        }
+
+        if (block.base_gid_)
+        {
+            error_code ec(lightweight);
+            applier::unbind_range_local(block.base_gid_, block.count_, ec);
+        }
+
+        ::operator delete(block.begin_);
+        return true;
+    }
+}}}
@@ -0,0 +1,68 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/parcelset/detail/compression_policy.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace hpx { namespace parcelset { namespace detail
+{
+    compression_policy::compression_policy(std::size_t threshold,
+            double max_ratio, std::size_t sample_interval)
+      : threshold_(threshold)
+      , max_ratio_(max_ratio)
+      , sample_interval_(static_cast<std::uint32_t>(
+            (std::max)(sample_interval, std::size_t(1))))
+    {}
+
+    bool compression_policy::use_compression(char const* action,
+        std::size_t size)
+    {
+        if (size < threshold_)
+            return false;
+
+        std::lock_guard<mutex_type> l(mtx_);
+        action_state& state = data_[action];
+        if (!state.disabled_)
+            return true;
+
+        // re-sample disabled actions from time to time
+        if (++state.num_skipped_ < sample_interval_)
+            return false;
+
+        state.num_skipped_ = 0;
+        return true;
+    }
+
+    void compression_policy::add_sample(char const* action,
+        std::size_t raw_bytes, std::size_t compressed_bytes)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        action_state& state = data_[action];
+
+        state.raw_bytes_ += raw_bytes;
+        state.compressed_bytes_ += compressed_bytes;
+
+        // a single sample decides whether compression for a disabled action
+        // is enabled again, otherwise the ratio is averaged
+        if (!state.disabled_ && ++state.num_samples_ < num_samples)
+            return;
+
+        if (state.raw_bytes_ != 0)
+        {
+            double ratio = double(state.compressed_bytes_) /
+                double(state.raw_bytes_);
+            state.disabled_ = ratio > max_ratio_;
+        }
+
+        state.raw_bytes_ = 0;
+        state.compressed_bytes_ = 0;
+        state.num_samples_ = 0;
+    }
+}}}
@@ -50,6 +50,14 @@ namespace hpx { namespace parcelset { namespace detail
         std::lock_guard<mutex_type> l(mtx_);
         return data_[action].total_bytes(reset);
     }
+
+    // total data managed, uncompressed (bytes)
+    std::int64_t per_action_data_counter::total_raw_bytes(
+        std::string const& action, bool reset)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return data_[action].total_raw_bytes(reset);
+    }
 }}}
 
 #endif
@@ -291,6 +291,18 @@ namespace hpx { namespace parcelset
         return did_some_work;
     }
 
+    bool parcelhandler::has_pending_background_work()
+    {
+#if defined(HPX_HAVE_NETWORKING)
+        for (pports_type::value_type& pp : pports_)
+        {
+            if (pp.first > 0 && pp.second->has_pending_background_work())
+                return true;
+        }
+#endif
+        return false;
+    }
+
     void parcelhandler::flush_parcels()
     {
         // now flush all parcel ports to be shut down
@@ -979,6 +991,27 @@ namespace hpx { namespace parcelset
         return pp ? pp->get_connection_cache_statistics(stat_type, reset) : 0;
     }
 
+    // receive buffer pool statistics
+    std::int64_t parcelhandler::get_receive_buffer_pool_statistics(
+        std::string const& pp_type,
+        parcelport::receive_buffer_pool_statistics_type stat_type,
+        bool reset) const
+    {
+        error_code ec(lightweight);
+        parcelport* pp = find_parcelport(pp_type, ec);
+        return pp ? pp->get_receive_buffer_pool_statistics(stat_type, reset) : 0;
+    }
+
+    // decode statistics
+    std::int64_t parcelhandler::get_decode_statistics(
+        std::string const& pp_type,
+        parcelport::decode_statistics_type stat_type, bool reset) const
+    {
+        error_code ec(lightweight);
+        parcelport* pp = find_parcelport(pp_type, ec);
+        return pp ? pp->get_decode_statistics(stat_type, reset) : 0;
+    }
+
 #if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
     // same as above, just separated data for each action
     // number of parcels sent
@@ -1036,6 +1069,24 @@ namespace hpx { namespace parcelset
         parcelport* pp = find_parcelport(pp_type, ec);
         return pp ? pp->get_action_data_received(action, reset) : 0;
     }
+
+    // total data (uncompressed) sent (bytes)
+    std::int64_t parcelhandler::get_action_raw_data_sent(
+        std::string const& pp_type, std::string const& action, bool reset) const
+    {
+        error_code ec(lightweight);
+        parcelport* pp = find_parcelport(pp_type, ec);
+        return pp ? pp->get_action_raw_data_sent(action, reset) : 0;
+    }
+
+    // total data (uncompressed) received (bytes)
+    std::int64_t parcelhandler::get_action_raw_data_received(
+        std::string const& pp_type, std::string const& action, bool reset) const
+    {
+        error_code ec(lightweight);
+        parcelport* pp = find_parcelport(pp_type, ec);
+        return pp ? pp->get_action_raw_data_received(action, reset) : 0;
+    }
 #endif
 
     ///////////////////////////////////////////////////////////////////////////
@@ -1046,6 +1097,8 @@ namespace hpx { namespace parcelset
         {
             register_counter_types(pp.second->type());
             register_connection_cache_counter_types(pp.second->type());
+            register_receive_buffer_pool_counter_types(pp.second->type());
+            register_decode_counter_types(pp.second->type());
         }
 
         using util::placeholders::_1;
@@ -1186,12 +1239,25 @@ namespace hpx { namespace parcelset
             ));
 #endif
 
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+        util::function_nonser<std::int64_t(std::string const&, bool)>
+            data_raw_sent(util::bind(
+                &parcelhandler::get_action_raw_data_sent, this,
+                pp_type, _1, _2
+            ));
+        util::function_nonser<std::int64_t(std::string const&, bool)>
+            data_raw_received(util::bind(
+                &parcelhandler::get_action_raw_data_received, this,
+                pp_type, _1, _2
+            ));
+#else
         util::function_nonser<std::int64_t(bool)> data_raw_sent(
             util::bind(&parcelhandler::get_raw_data_sent, this,
                 pp_type, _1));
         util::function_nonser<std::int64_t(bool)> data_raw_received(
             util::bind(&parcelhandler::get_raw_data_received, this,
                 pp_type, _1));
+#endif
 
         util::function_nonser<std::int64_t(bool)> buffer_allocate_time_sent(
             util::bind(&parcelhandler::get_buffer_allocate_time_sent, this,
@@ -1337,9 +1403,16 @@ namespace hpx { namespace parcelset
                   "sent using the %s connection type by the referenced "
                   "locality", pp_type),
               HPX_PERFORMANCE_COUNTER_V1,
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+              util::bind(
+                  &performance_counters::per_action_data_counter_creator,
+                  _1, std::move(data_raw_sent), _2),
+              &performance_counters::per_action_data_counter_discoverer,
+#else
               util::bind(&performance_counters::locality_raw_counter_creator,
                   _1, std::move(data_raw_sent), _2),
               &performance_counters::locality_counter_discoverer,
+#endif
               "bytes"
             },
             { hpx::util::format("/data/count/%s/received", pp_type),
@@ -1349,9 +1422,16 @@ namespace hpx { namespace parcelset
                   "received using the %s connection type by the referenced "
                   "locality", pp_type),
               HPX_PERFORMANCE_COUNTER_V1,
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+              util::bind(
+                  &performance_counters::per_action_data_counter_creator,
+                  _1, std::move(data_raw_received), _2),
+              &performance_counters::per_action_data_counter_discoverer,
+#else
               util::bind(&performance_counters::locality_raw_counter_creator,
                   _1, std::move(data_raw_received), _2),
               &performance_counters::locality_counter_discoverer,
+#endif
               "bytes"
             },
             { hpx::util::format(
@@ -1525,6 +1605,126 @@ namespace hpx { namespace parcelset
 #endif
     }
 
+    // register connection specific performance counters related to the
+    // pooling of receive buffers
+    void parcelhandler::register_receive_buffer_pool_counter_types(
+        std::string const& pp_type)
+    {
+        using hpx::util::placeholders::_1;
+        using hpx::util::placeholders::_2;
+
+#if defined(HPX_HAVE_NETWORKING)
+        util::function_nonser<std::int64_t(bool)> pool_hits(
+            util::bind(&parcelhandler::get_receive_buffer_pool_statistics,
+                this, pp_type, parcelport::receive_buffer_pool_hits, _1));
+        util::function_nonser<std::int64_t(bool)> pool_misses(
+            util::bind(&parcelhandler::get_receive_buffer_pool_statistics,
+                this, pp_type, parcelport::receive_buffer_pool_misses, _1));
+        util::function_nonser<std::int64_t(bool)> pool_bytes_retained(
+            util::bind(&parcelhandler::get_receive_buffer_pool_statistics,
+                this, pp_type, parcelport::receive_buffer_pool_bytes_retained,
+                _1));
+
+        performance_counters::generic_counter_type_data const
+            receive_buffer_pool_types[] =
+        {
+            { hpx::util::format(
+                  "/parcelport/count/%s/receive-buffer-pool-hits", pp_type),
+              performance_counters::counter_raw,
+              hpx::util::format(
+                  "returns the number of receive buffers allocated from the "
+                  "receive buffer pool of the %s connection type on the "
+                  "referenced locality", pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(pool_hits), _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { hpx::util::format(
+                  "/parcelport/count/%s/receive-buffer-pool-misses", pp_type),
+              performance_counters::counter_raw,
+              hpx::util::format(
+                  "returns the number of receive buffers which could not be "
+                  "allocated from the receive buffer pool of the %s connection "
+                  "type on the referenced locality", pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(pool_misses), _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { hpx::util::format(
+                  "/parcelport/count/%s/receive-buffer-pool-retained", pp_type),
+              performance_counters::counter_raw,
+              hpx::util::format(
+                  "returns the number of bytes currently retained by the "
+                  "receive buffer pool of the %s connection type on the "
+                  "referenced locality", pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(pool_bytes_retained), _2),
+              &performance_counters::locality_counter_discoverer,
+              "bytes"
+            }
+        };
+        performance_counters::install_counter_types(receive_buffer_pool_types,
+            sizeof(receive_buffer_pool_types) /
+                sizeof(receive_buffer_pool_types[0]));
+#endif
+    }
+
+    // register connection specific performance counters related to where
+    // received messages are decoded
+    void parcelhandler::register_decode_counter_types(
+        std::string const& pp_type)
+    {
+        using hpx::util::placeholders::_1;
+        using hpx::util::placeholders::_2;
+
+#if defined(HPX_HAVE_NETWORKING)
+        util::function_nonser<std::int64_t(bool)> decodes_inline(
+            util::bind(&parcelhandler::get_decode_statistics,
+                this, pp_type, parcelport::decode_inline, _1));
+        util::function_nonser<std::int64_t(bool)> decodes_offloaded(
+            util::bind(&parcelhandler::get_decode_statistics,
+                this, pp_type, parcelport::decode_offloaded, _1));
+
+        performance_counters::generic_counter_type_data const
+            decode_types[] =
+        {
+            { hpx::util::format(
+                  "/parcelport/count/%s/decode-inline", pp_type),
+              performance_counters::counter_raw,
+              hpx::util::format(
+                  "returns the number of messages received by the %s "
+                  "connection type on the referenced locality which were "
+                  "decoded on the receiving thread", pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(decodes_inline), _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { hpx::util::format(
+                  "/parcelport/count/%s/decode-offloaded", pp_type),
+              performance_counters::counter_raw,
+              hpx::util::format(
+                  "returns the number of messages received by the %s "
+                  "connection type on the referenced locality which were "
+                  "decoded on a separate HPX worker thread", pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, std::move(decodes_offloaded), _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            }
+        };
+        performance_counters::install_counter_types(decode_types,
+            sizeof(decode_types) / sizeof(decode_types[0]));
+#endif
+    }
+
     std::vector<plugins::parcelport_factory_base *> &
     parcelhandler::get_parcelport_factories()
     {
@@ -1589,6 +1789,11 @@ namespace hpx { namespace parcelset
                 "$[hpx.parcel.array_optimization]}",
             "enable_security = ${HPX_PARCEL_ENABLE_SECURITY:0}",
             "async_serialization = ${HPX_PARCEL_ASYNC_SERIALIZATION:1}",
+            "async_decode_threshold = ${HPX_PARCEL_ASYNC_DECODE_THRESHOLD:16384}",
+            "compression_threshold = ${HPX_PARCEL_COMPRESSION_THRESHOLD:512}",
+            "compression_ratio = ${HPX_PARCEL_COMPRESSION_RATIO:0.9}",
+            "compression_sample_interval = "
+                "${HPX_PARCEL_COMPRESSION_SAMPLE_INTERVAL:64}",
 #if defined(HPX_HAVE_PARCEL_COALESCING)
             "message_handlers = ${HPX_PARCEL_MESSAGE_HANDLERS:1}"
 #else
@@ -19,6 +19,7 @@
 #include <hpx/util/apex.hpp>
 #endif
 #include <hpx/util/assert.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
 
 #include <cstdint>
 #include <cstddef>
@@ -33,7 +34,6 @@ namespace hpx { namespace parcelset
     parcelport::parcelport(util::runtime_configuration const& ini,
             locality const & here, std::string const& type)
       : applier_(nullptr),
-        num_parcel_destinations_(0),
         here_(here),
         max_inbound_message_size_(ini.get_max_inbound_message_size()),
         max_outbound_message_size_(ini.get_max_outbound_message_size()),
@@ -41,6 +41,17 @@ namespace hpx { namespace parcelset
         allow_zero_copy_optimizations_(true),
         enable_security_(false),
         async_serialization_(false),
+        async_decode_threshold_(hpx::util::get_entry_as<std::size_t>(ini,
+            "hpx.parcel.async_decode_threshold", "16384")),
+        decodes_inline_(0),
+        decodes_offloaded_(0),
+        compression_policy_(
+            hpx::util::get_entry_as<std::size_t>(ini,
+                "hpx.parcel.compression_threshold", "512"),
+            hpx::util::get_entry_as<double>(ini,
+                "hpx.parcel.compression_ratio", "0.9"),
+            hpx::util::get_entry_as<std::size_t>(ini,
+                "hpx.parcel.compression_sample_interval", "64")),
         priority_(hpx::util::get_entry_as<int>(ini,
             "hpx.parcel." + type + ".priority", "0")),
         type_(type)
@@ -76,6 +87,44 @@ namespace hpx { namespace parcelset
         }
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    bool parcelport::async_decode(std::size_t inbound_data_size)
+    {
+        // small messages are decoded right away, handing them to another
+        // thread would cost more than decoding them
+        if (async_serialization_ &&
+            inbound_data_size >= async_decode_threshold_ &&
+            hpx::is_running())
+        {
+            ++decodes_offloaded_;
+            return true;
+        }
+
+        ++decodes_inline_;
+        return false;
+    }
+
+    std::int64_t parcelport::get_decode_statistics(
+        decode_statistics_type stat_type, bool reset)
+    {
+        switch (stat_type)
+        {
+        case decode_inline:
+            return util::get_and_reset_value(decodes_inline_, reset);
+
+        case decode_offloaded:
+            return util::get_and_reset_value(decodes_offloaded_, reset);
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(bad_parameter,
+            "parcelport::get_decode_statistics",
+            "invalid decode statistics type");
+        return 0;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Update performance counter data
     void parcelport::add_received_data(
@@ -193,16 +242,7 @@ namespace hpx { namespace parcelset
 
     std::int64_t parcelport::get_pending_parcels_count(bool /*reset*/)
     {
-        std::lock_guard<lcos::local::spinlock> l(mtx_);
-        std::int64_t count = 0;
-        for (auto && p : pending_parcels_)
-        {
-            count += hpx::util::get<0>(p.second).size();
-            HPX_ASSERT(
-                hpx::util::get<0>(p.second).size() ==
-                hpx::util::get<1>(p.second).size());
-        }
-        return count;
+        return static_cast<std::int64_t>(pending_parcels_.size());
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -263,6 +303,24 @@ namespace hpx { namespace parcelset
             return parcels_received_.total_bytes(reset);
         return action_parcels_received_.total_bytes(action, reset);
     }
+
+    // total data (uncompressed) sent (bytes)
+    std::int64_t parcelport::get_action_raw_data_sent(
+        std::string const& action, bool reset)
+    {
+        if (action.empty())
+            return parcels_sent_.total_raw_bytes(reset);
+        return action_parcels_sent_.total_raw_bytes(action, reset);
+    }
+
+    // total data (uncompressed) received (bytes)
+    std::int64_t parcelport::get_action_raw_data_received(
+        std::string const& action, bool reset)
+    {
+        if (action.empty())
+            return parcels_received_.total_raw_bytes(reset);
+        return action_parcels_received_.total_raw_bytes(action, reset);
+    }
 #endif
 
     ///////////////////////////////////////////////////////////////////////////
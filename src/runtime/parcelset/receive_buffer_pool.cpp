@@ -0,0 +1,121 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/parcelset/receive_buffer_pool.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace hpx { namespace parcelset
+{
+    receive_buffer_pool::receive_buffer_pool(std::size_t max_retained_bytes)
+      : max_retained_bytes_(max_retained_bytes)
+      , retained_bytes_(0)
+      , hits_(0)
+      , misses_(0)
+    {}
+
+    receive_buffer_pool::~receive_buffer_pool()
+    {
+        clear();
+    }
+
+    std::size_t receive_buffer_pool::size_class(std::size_t size)
+    {
+        std::size_t cls = min_size_class;
+        while (cls <= max_size_class && (std::size_t(1) << cls) < size)
+            ++cls;
+        return cls;
+    }
+
+    void* receive_buffer_pool::allocate(std::size_t size)
+    {
+        std::size_t const cls = size_class(size);
+        if (cls > max_size_class)
+        {
+            ++misses_;
+            return ::operator new(size);
+        }
+
+        free_list& l = free_lists_[cls - min_size_class];
+        {
+            std::lock_guard<mutex_type> lk(l.mtx_);
+            if (!l.blocks_.empty())
+            {
+                void* p = l.blocks_.back();
+                l.blocks_.pop_back();
+                retained_bytes_ -= std::size_t(1) << cls;
+                ++hits_;
+                return p;
+            }
+        }
+
+        ++misses_;
+        return ::operator new(std::size_t(1) << cls);
+    }
+
+    void receive_buffer_pool::deallocate(void* p, std::size_t size)
+    {
+        std::size_t const cls = size_class(size);
+        if (cls > max_size_class)
+        {
+            ::operator delete(p);
+            return;
+        }
+
+        // retain the block only if this does not exceed the configured
+        // limit
+        std::size_t const bytes = std::size_t(1) << cls;
+        if (retained_bytes_.fetch_add(bytes) + bytes > max_retained_bytes_)
+        {
+            retained_bytes_ -= bytes;
+            ::operator delete(p);
+            return;
+        }
+
+        free_list& l = free_lists_[cls - min_size_class];
+        std::lock_guard<mutex_type> lk(l.mtx_);
+        l.blocks_.push_back(p);
+    }
+
+    void receive_buffer_pool::clear()
+    {
+        for (std::size_t i = 0; i != num_size_classes; ++i)
+        {
+            free_list& l = free_lists_[i];
+            std::vector<void*> blocks;
+            {
+                std::lock_guard<mutex_type> lk(l.mtx_);
+                std::swap(blocks, l.blocks_);
+            }
+
+            retained_bytes_ -= blocks.size() * (std::size_t(1) <<
+                (i + min_size_class));
+            for (void* p : blocks)
+                ::operator delete(p);
+        }
+    }
+
+    std::int64_t receive_buffer_pool::get_hits(bool reset)
+    {
+        return util::get_and_reset_value(hits_, reset);
+    }
+
+    std::int64_t receive_buffer_pool::get_misses(bool reset)
+    {
+        return util::get_and_reset_value(misses_, reset);
+    }
+
+    std::int64_t receive_buffer_pool::get_bytes_retained(bool) const
+    {
+        return static_cast<std::int64_t>(retained_bytes_.load());
+    }
+}}
@@ -138,6 +138,9 @@ namespace hpx { namespace resource { namespace detail
         case resource::local_priority_lifo:
             sched = "local_priority_lifo";
             break;
+        case resource::local_priority_numa:
+            sched = "local_priority_numa";
+            break;
         case resource::static_:
             sched = "static";
             break;
@@ -420,6 +423,10 @@ namespace hpx { namespace resource { namespace detail
         {
             default_scheduler = scheduling_policy::local_priority_lifo;
         }
+        else if (0 == std::string("local-priority-numa").find(cfg_.queuing_))
+        {
+            default_scheduler = scheduling_policy::local_priority_numa;
+        }
         else if (0 == std::string("static").find(cfg_.queuing_))
         {
             default_scheduler = scheduling_policy::static_;
@@ -29,12 +29,12 @@ namespace hpx { namespace serialization
     {
         if(!split_gids_) return naming::gid_type();
 
-        split_gids_type::iterator it = split_gids_->find(&gid);
-        HPX_ASSERT(it != split_gids_->end());
-        HPX_ASSERT(it->second != naming::invalid_gid);
-        naming::gid_type new_gid = it->second;
+        naming::gid_type* split_gid = split_gids_->find(&gid);
+        HPX_ASSERT(split_gid != nullptr);
+        HPX_ASSERT(*split_gid != naming::invalid_gid);
+        naming::gid_type new_gid = *split_gid;
 #if defined(HPX_DEBUG)
-        it->second = naming::invalid_gid;
+        *split_gid = naming::invalid_gid;
 #endif
         return new_gid;
     }
@@ -133,6 +133,63 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         HPX_ASSERT(this->m_state == super_type::ctx_running);
     }
 
+    void coroutine_impl::invoke_stackless()
+    {
+        typedef super_type::context_exit_status context_exit_status;
+        context_exit_status status = super_type::ctx_exited_return;
+
+        HPX_ASSERT(this->is_stackless());
+        HPX_ASSERT(this->is_ready());
+
+#if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
+        ++this->m_phase;
+#endif
+        this->m_state = super_type::ctx_running;
+
+        // this mirrors the trampoline above, except that there is no
+        // context switch involved in entering or leaving the function
+        std::exception_ptr tinfo;
+        try
+        {
+            HPX_ASSERT(this->count() > 0);
+
+            {
+                coroutine_self* old_self = coroutine_self::get_self();
+                coroutine_self self(this, old_self);
+                reset_self_on_exit on_exit(&self, old_self);
+
+                this->m_result_last = m_fun(*this->args());
+
+                // if this thread returned 'terminated' we need to reset
+                // the functor and the bound arguments
+                if (this->m_result_last.first == terminated)
+                    this->reset();
+            }
+
+            // return value to the caller
+            this->bind_result(&this->m_result_last);
+        }
+        catch (exit_exception const&) {
+            status = super_type::ctx_exited_exit;
+            tinfo = std::current_exception();
+            this->reset();            // reset functor
+        }
+        catch (...) {
+            status = super_type::ctx_exited_abnormally;
+            tinfo = std::current_exception();
+            this->reset();
+        }
+
+        this->m_type_info = std::move(tinfo);
+        this->m_state = super_type::ctx_exited;
+        this->m_exit_status = status;
+
+        if (status == super_type::ctx_exited_abnormally)
+            std::rethrow_exception(this->m_type_info);
+        if (status == super_type::ctx_exited_exit)
+            throw coroutine_exited();
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // the memory for the threads is managed by a lockfree caching_freelist
     struct coroutine_heap
@@ -174,6 +231,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
     struct heap_tag_medium {};
     struct heap_tag_large {};
     struct heap_tag_huge {};
+    struct heap_tag_nostack {};
 
     template <std::size_t NumHeaps, typename Tag>
     static coroutine_heap& get_heap(std::size_t i)
@@ -185,6 +243,11 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
     static coroutine_heap& get_heap(std::size_t i, std::ptrdiff_t stacksize)
     {
+        // stackless coroutines must not be reused for threads with a stack
+        if (stacksize == HPX_NOSTACK_STACK_SIZE)
+            return get_heap<HPX_COROUTINE_NUM_HEAPS,
+                heap_tag_nostack>(i % HPX_COROUTINE_NUM_HEAPS);
+
         // FIXME: This should check the sizes in runtime_configuration, not the
         // default macro sizes
         if (stacksize > HPX_MEDIUM_STACK_SIZE)
@@ -207,6 +270,9 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
     static std::size_t get_heap_count(ptrdiff_t stacksize)
     {
+        if (stacksize == HPX_NOSTACK_STACK_SIZE)
+            return HPX_COROUTINE_NUM_HEAPS;
+
         if (stacksize > HPX_MEDIUM_STACK_SIZE)
             return HPX_COROUTINE_NUM_HEAPS / 4; //-V112
 
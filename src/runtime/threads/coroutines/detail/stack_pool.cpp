@@ -0,0 +1,217 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+// include unist.d conditionally to check for POSIX version. Not all OSs have the
+// unistd header...
+#if defined(HPX_HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
+
+#if defined(_POSIX_VERSION)
+#include <hpx/runtime/threads/coroutines/detail/posix_utility.hpp>
+
+#if defined(HPX_HAVE_THREAD_STACK_MMAP) && defined(_POSIX_MAPPED_FILES) \
+ && _POSIX_MAPPED_FILES > 0
+
+#include <hpx/compat/mutex.hpp>
+
+#include <boost/lockfree/stack.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace threads { namespace coroutines { namespace detail
+{
+namespace posix
+{
+    namespace
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The stack pool keeps idle stacks around instead of unmapping them,
+        // avoiding the mmap/mprotect/munmap system calls otherwise needed
+        // whenever a coroutine object is created or destroyed outside of the
+        // recycle heaps of the thread queues. Dirty pages of idle stacks are
+        // handed back to the OS, thus the pooled stacks occupy address space
+        // only.
+        class stack_pool
+        {
+        private:
+            // the configured stack sizes (small, medium, large, huge) are the
+            // only sizes used in practice, stacks of sizes beyond the
+            // available size classes are not pooled
+            enum { num_size_classes = 8 };
+
+            struct size_class
+            {
+                size_class()
+                  : size_(0), stacks_(64), count_(0)
+                {}
+
+                std::atomic<std::size_t> size_;
+                boost::lockfree::stack<void*> stacks_;
+                std::atomic<std::size_t> count_;
+            };
+
+            typedef compat::mutex mutex_type;
+
+        public:
+            stack_pool()
+              : reserved_bytes_(0)
+            {}
+
+            void* allocate(std::size_t size)
+            {
+                size_class* c = get_size_class(size);
+
+                void* stack = nullptr;
+                if (c != nullptr && c->stacks_.pop(stack))
+                {
+                    --c->count_;
+                    return stack;
+                }
+
+                stack = map_stack(size);
+
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    stacks_.insert(std::make_pair(stack, size));
+                }
+                reserved_bytes_ += size;
+
+                return stack;
+            }
+
+            void deallocate(void* stack, std::size_t size)
+            {
+                size_class* c = get_size_class(size);
+                if (c != nullptr &&
+                    c->count_.fetch_add(1) < stack_pool_high_water_mark)
+                {
+                    // the stack will sit idle for a while, let the OS
+                    // reclaim its dirty pages
+                    reset_stack(stack, size);
+
+                    if (c->stacks_.push(stack))
+                        return;
+                }
+                if (c != nullptr)
+                    --c->count_;
+
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    stacks_.erase(stack);
+                }
+                reserved_bytes_ -= size;
+
+                unmap_stack(stack, size);
+            }
+
+            std::int64_t get_reserved_bytes() const
+            {
+                return reserved_bytes_.load(std::memory_order_relaxed);
+            }
+
+            // Determine the number of pages currently backed by physical
+            // memory for all stacks. This is expensive, but it is used for
+            // performance counters only.
+            std::int64_t get_committed_bytes() const
+            {
+                std::size_t const pagesize = EXEC_PAGESIZE;
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+                std::vector<unsigned char> pages;
+#else
+                std::vector<char> pages;
+#endif
+                std::int64_t committed = 0;
+
+                std::lock_guard<mutex_type> l(mtx_);
+                for (auto const& p : stacks_)
+                {
+                    pages.resize((p.second + pagesize - 1) / pagesize);
+                    if (::mincore(p.first, p.second, pages.data()) != 0)
+                        continue;
+
+                    for (auto page : pages)
+                    {
+                        if (page & 0x1)
+                            committed += pagesize;
+                    }
+                }
+                return committed;
+            }
+
+        private:
+            size_class* get_size_class(std::size_t size)
+            {
+                for (std::size_t i = 0; i != num_size_classes; ++i)
+                {
+                    size_class& c = size_classes_[i];
+
+                    std::size_t class_size =
+                        c.size_.load(std::memory_order_acquire);
+                    if (class_size == size)
+                        return &c;
+
+                    // claim an unused size class for this stack size
+                    if (class_size == 0 &&
+                        (c.size_.compare_exchange_strong(class_size, size) ||
+                            class_size == size))
+                    {
+                        return &c;
+                    }
+                }
+                return nullptr;
+            }
+
+            size_class size_classes_[num_size_classes];
+
+            // all stacks which are currently mapped, be it in use or pooled
+            mutable mutex_type mtx_;
+            std::map<void*, std::size_t> stacks_;
+            std::atomic<std::int64_t> reserved_bytes_;
+        };
+
+        // The pool is never destroyed as stacks may be released during
+        // static destruction.
+        stack_pool& get_stack_pool()
+        {
+            static stack_pool* pool = new stack_pool;
+            return *pool;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void* alloc_stack(std::size_t size)
+    {
+        return get_stack_pool().allocate(size);
+    }
+
+    void free_stack(void* stack, std::size_t size)
+    {
+        get_stack_pool().deallocate(stack, size);
+    }
+
+    std::int64_t get_stack_reserved_bytes(bool)
+    {
+        return get_stack_pool().get_reserved_bytes();
+    }
+
+    std::int64_t get_stack_committed_bytes(bool)
+    {
+        return get_stack_pool().get_committed_bytes();
+    }
+}
+}}}}
+
+#endif
+#endif
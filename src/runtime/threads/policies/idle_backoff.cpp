@@ -0,0 +1,287 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/threads/policies/idle_backoff.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/lexical_cast.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux) || defined(linux) || defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#define HPX_IDLE_BACKOFF_USE_FUTEX
+#endif
+
+#if defined(HPX_MSVC)
+#include <intrin.h>
+#endif
+
+namespace hpx { namespace threads { namespace policies
+{
+    namespace
+    {
+        inline void cpu_relax()
+        {
+#if defined(HPX_MSVC)
+            _mm_pause();
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            __asm__ __volatile__("rep; nop" : : : "memory");
+#endif
+        }
+
+#if defined(HPX_IDLE_BACKOFF_USE_FUTEX)
+        // returns false on timeout
+        bool futex_wait(std::atomic<std::uint32_t>& word,
+            std::uint32_t expected, std::int64_t timeout_us)
+        {
+            struct timespec timeout;
+            timeout.tv_sec = static_cast<time_t>(timeout_us / 1000000);
+            timeout.tv_nsec = static_cast<long>((timeout_us % 1000000) * 1000);
+
+            long r = ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+                FUTEX_WAIT_PRIVATE, expected, &timeout, nullptr, 0);
+            return r == 0 || errno != ETIMEDOUT;
+        }
+
+        void futex_wake(std::atomic<std::uint32_t>& word)
+        {
+            ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+                FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+        }
+#endif
+
+        template <typename T>
+        T get_entry_as(char const* key, char const* dflt)
+        {
+            return boost::lexical_cast<T>(hpx::get_config_entry(key, dflt));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    idle_backoff::idle_backoff(std::size_t num_threads)
+      : num_threads_(num_threads),
+        states_(new worker_state[num_threads]),
+        num_parked_(0),
+        next_victim_(0),
+        pause_rounds_(get_entry_as<std::uint32_t>(
+            "hpx.idle_pause_rounds", "2")),
+        yield_rounds_(get_entry_as<std::uint32_t>(
+            "hpx.idle_yield_rounds", "2")),
+        max_park_time_(get_entry_as<std::int64_t>(
+            "hpx.max_idle_park_time", "10000"))
+    {}
+
+    idle_backoff::~idle_backoff()
+    {
+        HPX_ASSERT(num_parked_ == 0);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void idle_backoff::pause(std::uint32_t rounds)
+    {
+        // spin a bit longer every round
+        std::size_t const count = std::size_t(1) << (rounds < 10 ? rounds : 10);
+        for (std::size_t i = 0; i != count; ++i)
+            cpu_relax();
+    }
+
+    void idle_backoff::yield()
+    {
+        std::this_thread::yield();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void idle_backoff::prepare_park(worker_state& s)
+    {
+        HPX_ASSERT(s.parked_.load(std::memory_order_relaxed) == not_parked);
+        s.parked_.store(parked);
+        ++num_parked_;
+    }
+
+    void idle_backoff::cancel_park(worker_state& s)
+    {
+        std::uint32_t expected = parked;
+        if (s.parked_.compare_exchange_strong(expected, not_parked))
+        {
+            --num_parked_;
+            return;
+        }
+
+        // somebody else is waking us up already, wait for it to finish
+        while (s.parked_.load(std::memory_order_acquire) != not_parked)
+            cpu_relax();
+    }
+
+    void idle_backoff::park(worker_state& s)
+    {
+        ++s.parks_;
+
+#if defined(HPX_IDLE_BACKOFF_USE_FUTEX)
+        std::uint64_t const start = util::high_resolution_clock::now();
+        std::int64_t remaining = max_park_time_;
+
+        while (s.parked_.load(std::memory_order_acquire) == parked)
+        {
+            if (!futex_wait(s.parked_, parked, remaining))
+                break;
+
+            // woken up spuriously, sleep for the remaining time
+            std::int64_t const elapsed = static_cast<std::int64_t>(
+                (util::high_resolution_clock::now() - start) / 1000);
+            remaining = max_park_time_ - elapsed;
+            if (remaining <= 0)
+                break;
+        }
+#else
+        {
+            std::unique_lock<compat::mutex> l(mtx_);
+            cond_.wait_for(l, std::chrono::microseconds(max_park_time_),
+                [&]() -> bool
+                {
+                    return s.parked_.load(std::memory_order_acquire) !=
+                        parked;
+                });
+        }
+#endif
+
+        // withdraw from being parked if nobody has woken us up
+        std::uint32_t expected = parked;
+        if (s.parked_.compare_exchange_strong(expected, not_parked))
+        {
+            --num_parked_;
+            return;
+        }
+
+        while (s.parked_.load(std::memory_order_acquire) != not_parked)
+            cpu_relax();
+
+        // this worker was explicitly woken up, there is new work
+        ++s.unparks_;
+        ++s.unpark_latency_samples_;
+        s.unpark_latency_ += static_cast<std::int64_t>(
+            util::high_resolution_clock::now() -
+                s.notify_time_.load(std::memory_order_relaxed));
+        s.rounds_ = 0;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool idle_backoff::unpark(worker_state& s)
+    {
+        std::uint32_t expected = parked;
+        if (s.parked_.load(std::memory_order_relaxed) != parked ||
+            !s.parked_.compare_exchange_strong(expected, waking_up))
+        {
+            return false;
+        }
+
+        --num_parked_;
+        s.notify_time_.store(
+            util::high_resolution_clock::now(), std::memory_order_relaxed);
+        s.parked_.store(not_parked, std::memory_order_release);
+
+#if defined(HPX_IDLE_BACKOFF_USE_FUTEX)
+        futex_wake(s.parked_);
+#else
+        {
+            std::lock_guard<compat::mutex> l(mtx_);
+        }
+        cond_.notify_all();
+#endif
+        return true;
+    }
+
+    void idle_backoff::unpark_one(std::size_t num_thread)
+    {
+        // prefer the worker the work has been scheduled for
+        if (num_thread != std::size_t(-1) &&
+            unpark(states_[num_thread % num_threads_]))
+        {
+            return;
+        }
+
+        // otherwise wake up any parked worker, start looking at a different
+        // position every time to distribute the load
+        std::size_t const start = next_victim_++;
+        for (std::size_t i = 0;
+             i != num_threads_ && num_parked_.load() != 0; ++i)
+        {
+            if (unpark(states_[(start + i) % num_threads_]))
+                return;
+        }
+    }
+
+    void idle_backoff::notify_all()
+    {
+        for (std::size_t i = 0;
+             i != num_threads_ && num_parked_.load() != 0; ++i)
+        {
+            unpark(states_[i]);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t idle_backoff::get_park_count(
+        std::size_t num_thread, bool reset)
+    {
+        if (num_thread != std::size_t(-1))
+            return util::get_and_reset_value(states_[num_thread].parks_, reset);
+
+        std::int64_t result = 0;
+        for (std::size_t i = 0; i != num_threads_; ++i)
+            result += util::get_and_reset_value(states_[i].parks_, reset);
+        return result;
+    }
+
+    std::int64_t idle_backoff::get_unpark_count(
+        std::size_t num_thread, bool reset)
+    {
+        if (num_thread != std::size_t(-1))
+            return util::get_and_reset_value(states_[num_thread].unparks_, reset);
+
+        std::int64_t result = 0;
+        for (std::size_t i = 0; i != num_threads_; ++i)
+            result += util::get_and_reset_value(states_[i].unparks_, reset);
+        return result;
+    }
+
+    std::int64_t idle_backoff::get_average_unpark_latency(
+        std::size_t num_thread, bool reset)
+    {
+        std::int64_t unparks = 0;
+        std::int64_t latency = 0;
+
+        if (num_thread != std::size_t(-1))
+        {
+            unparks = util::get_and_reset_value(
+                states_[num_thread].unpark_latency_samples_, reset);
+            latency = util::get_and_reset_value(
+                states_[num_thread].unpark_latency_, reset);
+        }
+        else
+        {
+            for (std::size_t i = 0; i != num_threads_; ++i)
+            {
+                unparks += util::get_and_reset_value(
+                    states_[i].unpark_latency_samples_, reset);
+                latency += util::get_and_reset_value(
+                    states_[i].unpark_latency_, reset);
+            }
+        }
+        return unparks == 0 ? 0 : latency / unparks;
+    }
+}}}
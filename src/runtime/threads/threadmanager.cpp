@@ -31,8 +31,17 @@
 #include <hpx/util/block_profiler.hpp>
 #include <hpx/util/hardware/timestamp.hpp>
 #include <hpx/util/itt_notify.hpp>
+#include <hpx/util/log_linear_histogram.hpp>
 #include <hpx/util/logging.hpp>
 #include <hpx/util/runtime_configuration.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#if !defined(HPX_WINDOWS)
+#include <hpx/runtime/threads/coroutines/detail/posix_utility.hpp>
+#endif
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
 
 #include <cstddef>
 #include <cstdint>
@@ -44,6 +53,7 @@
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
 ///////////////////////////////////////////////////////////////////////////////
@@ -313,6 +323,9 @@ namespace hpx { namespace threads
         if (size == thread_stacksize_unknown)
             return "unknown";
 
+        if (size == thread_stacksize_nostack || size == HPX_NOSTACK_STACK_SIZE)
+            return "nostack";
+
         util::runtime_configuration const& rtcfg = hpx::get_config();
         if (rtcfg.get_stack_size(thread_stacksize_small) == size)
             size = thread_stacksize_small;
@@ -499,6 +512,43 @@ namespace hpx { namespace threads
                 break;
             }
 
+            case resource::local_priority_numa:
+            {
+                // set parameters for scheduler and pool instantiation and
+                // perform compatibility checks
+                hpx::detail::ensure_hierarchy_arity_compatibility(cfg_.vm_);
+                std::size_t num_high_priority_queues =
+                    hpx::detail::get_num_high_priority_queues(
+                        cfg_, rp.get_num_threads(name));
+                std::string affinity_desc;
+                std::size_t numa_sensitive =
+                    hpx::detail::get_affinity_description(cfg_, affinity_desc);
+
+                // instantiate the scheduler, enable hierarchical stealing
+                typedef hpx::threads::policies::local_priority_queue_scheduler<
+                    compat::mutex, hpx::threads::policies::lockfree_fifo>
+                    local_sched_type;
+                local_sched_type::init_parameter_type init(num_threads_in_pool,
+                    num_high_priority_queues, 1000, numa_sensitive,
+                    "core-local_priority_queue_scheduler-numa", true);
+                std::unique_ptr<local_sched_type> sched(
+                    new local_sched_type(init));
+
+                // instantiate the pool
+                std::unique_ptr<detail::thread_pool_base> pool(
+                    new hpx::threads::detail::scheduled_thread_pool<
+                            local_sched_type
+                        >(std::move(sched),
+                        notifier_, i, name.c_str(),
+                        policies::scheduler_mode(policies::do_background_work |
+                            policies::reduce_thread_priority |
+                            policies::delay_exit),
+                        thread_offset));
+                pools_.push_back(std::move(pool));
+
+                break;
+            }
+
             case resource::static_:
             {
 #if defined(HPX_HAVE_STATIC_SCHEDULER)
@@ -942,6 +992,22 @@ namespace hpx { namespace threads
         pool->create_work(data, initial_state, ec);
     }
 
+    void threadmanager::register_work(thread_init_data* data,
+        std::size_t count, thread_state_enum initial_state, error_code& ec)
+    {
+        detail::thread_pool_base *pool = nullptr;
+        if (get_self_ptr())
+        {
+            auto tid = get_self_id();
+            pool = tid->get_scheduler_base()->get_parent_pool();
+        }
+        else
+        {
+            pool = &default_pool();
+        }
+        pool->create_work(data, count, initial_state, ec);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     HPX_CONSTEXPR std::size_t all_threads = std::size_t(-1);
 
@@ -980,6 +1046,63 @@ namespace hpx { namespace threads
         return result;
     }
 
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+    namespace
+    {
+        void merge_histogram(std::vector<std::int64_t>& result,
+            std::vector<std::int64_t> const& data)
+        {
+            if (data.empty())
+                return;
+
+            HPX_ASSERT(data.size() == result.size());
+            for (std::size_t i = 0; i != data.size(); ++i)
+                result[i] += data[i];
+        }
+
+        typedef util::log_linear_histogram<> latency_histogram_type;
+    }
+
+    std::vector<std::int64_t> threadmanager::get_queue_wait_histogram(
+        bool reset)
+    {
+        std::vector<std::int64_t> result(
+            latency_histogram_type::num_buckets, 0);
+        for (auto const& pool_iter : pools_)
+        {
+            merge_histogram(result,
+                pool_iter->get_queue_wait_histogram(all_threads, reset));
+        }
+        return result;
+    }
+
+    std::vector<std::int64_t> threadmanager::get_execution_time_histogram(
+        bool reset)
+    {
+        std::vector<std::int64_t> result(
+            latency_histogram_type::num_buckets, 0);
+        for (auto const& pool_iter : pools_)
+        {
+            merge_histogram(result,
+                pool_iter->get_execution_time_histogram(all_threads, reset));
+        }
+        return result;
+    }
+
+    std::vector<std::int64_t> threadmanager::get_suspension_histogram(
+        bool reset)
+    {
+        std::vector<std::int64_t> result(
+            latency_histogram_type::num_buckets, 0);
+        for (auto const& pool_iter : pools_)
+        {
+            merge_histogram(result,
+                pool_iter->get_suspension_histogram(all_threads, reset));
+        }
+        return result;
+    }
+#endif
+
 #ifdef HPX_HAVE_THREAD_IDLE_RATES
     std::int64_t threadmanager::avg_idle_rate(bool reset)
     {
@@ -1078,6 +1201,34 @@ namespace hpx { namespace threads
 #endif
 #endif
 
+    std::int64_t threadmanager::get_num_task_descriptions_reused(bool reset)
+    {
+        std::int64_t result = 0;
+        for (auto const& pool_iter : pools_)
+            result += pool_iter->get_num_task_descriptions_reused(
+                all_threads, reset);
+        return result;
+    }
+
+    std::int64_t threadmanager::get_num_task_descriptions_allocated(
+        bool reset)
+    {
+        std::int64_t result = 0;
+        for (auto const& pool_iter : pools_)
+            result += pool_iter->get_num_task_descriptions_allocated(
+                all_threads, reset);
+        return result;
+    }
+
+    std::int64_t threadmanager::get_num_cross_worker_frees(bool reset)
+    {
+        std::int64_t result = 0;
+        for (auto const& pool_iter : pools_)
+            result += pool_iter->get_num_cross_worker_frees(
+                all_threads, reset);
+        return result;
+    }
+
 #ifdef HPX_HAVE_THREAD_STEALING_COUNTS
     std::int64_t threadmanager::get_num_pending_misses(bool reset)
     {
@@ -1126,6 +1277,59 @@ namespace hpx { namespace threads
             result += pool_iter->get_num_stolen_to_staged(all_threads, reset);
         return result;
     }
+
+    std::int64_t threadmanager::get_num_stolen_local(bool reset)
+    {
+        std::int64_t result = 0;
+        for (auto const& pool_iter : pools_)
+            result += pool_iter->get_num_stolen_local(all_threads, reset);
+        return result;
+    }
+
+    std::int64_t threadmanager::get_num_stolen_remote(bool reset)
+    {
+        std::int64_t result = 0;
+        for (auto const& pool_iter : pools_)
+            result += pool_iter->get_num_stolen_remote(all_threads, reset);
+        return result;
+    }
+
+    std::int64_t threadmanager::get_num_stolen_continuations(bool reset)
+    {
+        std::int64_t result = 0;
+        for (auto const& pool_iter : pools_)
+        {
+            result += pool_iter->get_num_stolen_continuations(
+                all_threads, reset);
+        }
+        return result;
+    }
+#endif
+
+#ifdef HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF
+    std::int64_t threadmanager::get_num_idle_parks(bool reset)
+    {
+        std::int64_t result = 0;
+        for (auto const& pool_iter : pools_)
+            result += pool_iter->get_num_idle_parks(all_threads, reset);
+        return result;
+    }
+
+    std::int64_t threadmanager::get_num_idle_unparks(bool reset)
+    {
+        std::int64_t result = 0;
+        for (auto const& pool_iter : pools_)
+            result += pool_iter->get_num_idle_unparks(all_threads, reset);
+        return result;
+    }
+
+    std::int64_t threadmanager::get_average_unpark_latency(bool reset)
+    {
+        std::int64_t result = 0;
+        for (auto const& pool_iter : pools_)
+            result += pool_iter->get_average_unpark_latency(all_threads, reset);
+        return result / static_cast<std::int64_t>(pools_.size());
+    }
 #endif
 
     ///////////////////////////////////////////////////////////////////////////
@@ -1211,6 +1415,121 @@ namespace hpx { namespace threads
         return naming::invalid_gid;
     }
 
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+    // The counter parameters optionally specify the lower and upper boundary
+    // and the number of buckets of the returned histogram, the samples are
+    // collected independently of those.
+    naming::gid_type threadmanager::latency_histogram_counter_creator(
+        threadmanager_histogram_func total_func,
+        threadpool_histogram_func pool_func,
+        std::int64_t min_boundary, std::int64_t max_boundary,
+        std::int64_t num_buckets,
+        performance_counters::counter_info const& info, error_code& ec)
+    {
+        // verify the validity of the counter instance name
+        performance_counters::counter_path_elements paths;
+        performance_counters::get_counter_path_elements(
+            info.fullname_, paths, ec);
+        if (ec)
+            return naming::invalid_gid;
+
+        if (paths.parentinstance_is_basename_)
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "latency_histogram_counter_creator",
+                "invalid counter instance parent name: " +
+                    paths.parentinstancename_);
+            return naming::invalid_gid;
+        }
+
+        if (!paths.parameters_.empty())
+        {
+            std::vector<std::string> params;
+            boost::algorithm::split(params, paths.parameters_,
+                boost::algorithm::is_any_of(","),
+                boost::algorithm::token_compress_off);
+
+            if (params.size() > 0 && !params[0].empty())
+                min_boundary = util::safe_lexical_cast<std::int64_t>(params[0]);
+            if (params.size() > 1 && !params[1].empty())
+                max_boundary = util::safe_lexical_cast<std::int64_t>(params[1]);
+            if (params.size() > 2 && !params[2].empty())
+                num_buckets = util::safe_lexical_cast<std::int64_t>(params[2]);
+        }
+
+        if (min_boundary < 0 || min_boundary >= max_boundary ||
+            num_buckets <= 0)
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "latency_histogram_counter_creator",
+                "invalid counter parameter: " + paths.parameters_ +
+                    " (expected: min_boundary,max_boundary,num_buckets)");
+            return naming::invalid_gid;
+        }
+
+        using hpx::util::placeholders::_1;
+
+        util::function_nonser<std::vector<std::int64_t>(bool)> f;
+
+        detail::thread_pool_base& pool = default_pool();
+        if (paths.instancename_ == "total" && paths.instanceindex_ == -1)
+        {
+            // overall counter
+            f = util::bind(total_func, this, _1);
+        }
+        else if (paths.instancename_ == "pool")
+        {
+            if (paths.instanceindex_ >= 0 &&
+                std::size_t(paths.instanceindex_) <
+                    hpx::resource::get_num_thread_pools())
+            {
+                // specific for given pool counter
+                detail::thread_pool_base& pool_instance =
+                    hpx::resource::get_thread_pool(paths.instanceindex_);
+
+                f = util::bind(pool_func, &pool_instance,
+                    static_cast<std::size_t>(paths.subinstanceindex_), _1);
+            }
+        }
+        else if (paths.instancename_ == "worker-thread" &&
+            paths.instanceindex_ >= 0 &&
+            std::size_t(paths.instanceindex_) < pool.get_os_thread_count())
+        {
+            // specific counter from default
+            f = util::bind(pool_func, &pool,
+                static_cast<std::size_t>(paths.instanceindex_), _1);
+        }
+
+        if (f.empty())
+        {
+            HPX_THROWS_IF(ec, bad_parameter,
+                "latency_histogram_counter_creator",
+                "invalid counter instance name: " + paths.instancename_);
+            return naming::invalid_gid;
+        }
+
+        // convert the collected log-linear histogram into the requested
+        // linear representation whenever the counter is queried
+        auto histogram =
+            [f, min_boundary, max_boundary, num_buckets](bool reset)
+            ->  std::vector<std::int64_t>
+            {
+                std::vector<std::int64_t> data = f(reset);
+                if (data.empty())
+                    data.resize(latency_histogram_type::num_buckets, 0);
+
+                return latency_histogram_type::to_linear(
+                    data, min_boundary, max_boundary, num_buckets);
+            };
+
+        using performance_counters::detail::create_raw_counter;
+        return create_raw_counter(info,
+            util::function_nonser<std::vector<std::int64_t>(bool)>(
+                std::move(histogram)),
+            ec);
+    }
+#endif
+
     // scheduler utilization counter creation function
     naming::gid_type threadmanager::scheduler_utilization_counter_creator(
         performance_counters::counter_info const& info, error_code& ec)
@@ -1468,6 +1787,16 @@ namespace hpx { namespace threads
                 util::bind(
                     &coroutine_type::impl_type::get_stack_unbind_count, _1),
                 util::function_nonser<std::uint64_t(bool)>(), "", 0},
+#endif
+#if !defined(HPX_WINDOWS)
+            // /threads{locality#%d/total}/count/stack-bytes-reserved
+            {"count/stack-bytes-reserved",
+                &coroutines::detail::posix::get_stack_reserved_bytes,
+                util::function_nonser<std::uint64_t(bool)>(), "", 0},
+            // /threads{locality#%d/total}/count/stack-bytes-committed
+            {"count/stack-bytes-committed",
+                &coroutines::detail::posix::get_stack_committed_bytes,
+                util::function_nonser<std::uint64_t(bool)>(), "", 0},
 #endif
             // /threads{locality#%d/total}/count/objects
             // /threads{locality#%d/allocator%d}/count/objects
@@ -1651,6 +1980,43 @@ namespace hpx { namespace threads
                     &detail::thread_pool_base::get_cumulative_duration, _1, _2),
                 &performance_counters::locality_pool_thread_counter_discoverer,
                 "ns"},
+#ifdef HPX_HAVE_THREAD_LATENCY_HISTOGRAMS
+            {"/threads/time/queue-wait-histogram",
+                performance_counters::counter_histogram,
+                "returns a histogram of the times HPX-threads spent waiting "
+                "in the scheduler queues before being executed on the "
+                "referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1,
+                util::bind(&threadmanager::latency_histogram_counter_creator,
+                    this, &threadmanager::get_queue_wait_histogram,
+                    &detail::thread_pool_base::get_queue_wait_histogram,
+                    0, 1000000, 100, _1, _2),
+                &performance_counters::locality_pool_thread_counter_discoverer,
+                "ns"},
+            {"/threads/time/execution-histogram",
+                performance_counters::counter_histogram,
+                "returns a histogram of the overall execution times of the "
+                "HPX-threads which have terminated on the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1,
+                util::bind(&threadmanager::latency_histogram_counter_creator,
+                    this, &threadmanager::get_execution_time_histogram,
+                    &detail::thread_pool_base::get_execution_time_histogram,
+                    0, 1000000, 100, _1, _2),
+                &performance_counters::locality_pool_thread_counter_discoverer,
+                "ns"},
+            {"/threads/count/suspension-histogram",
+                performance_counters::counter_histogram,
+                "returns a histogram of the number of times the HPX-threads "
+                "which have terminated on the referenced locality have been "
+                "suspended",
+                HPX_PERFORMANCE_COUNTER_V1,
+                util::bind(&threadmanager::latency_histogram_counter_creator,
+                    this, &threadmanager::get_suspension_histogram,
+                    &detail::thread_pool_base::get_suspension_histogram,
+                    0, 100, 100, _1, _2),
+                &performance_counters::locality_pool_thread_counter_discoverer,
+                ""},
+#endif
             {"/threads/count/instantaneous/all",
                 performance_counters::counter_raw,
                 "returns the overall current number of HPX-threads "
@@ -1723,12 +2089,66 @@ namespace hpx { namespace threads
                 "operations performed for the referenced locality",
                 HPX_PERFORMANCE_COUNTER_V1, counts_creator,
                 &performance_counters::locality_counter_discoverer, ""},
+#endif
+#if !defined(HPX_WINDOWS)
+            {"/threads/count/stack-bytes-reserved",
+                performance_counters::counter_raw,
+                "returns the number of bytes of address space reserved for "
+                "the stacks of HPX-threads (in use or pooled) for the "
+                "referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+                &performance_counters::locality_counter_discoverer, "bytes"},
+            {"/threads/count/stack-bytes-committed",
+                performance_counters::counter_raw,
+                "returns the number of bytes of the stacks of HPX-threads "
+                "(in use or pooled) currently backed by physical memory for "
+                "the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+                &performance_counters::locality_counter_discoverer, "bytes"},
 #endif
             {"/threads/count/objects", performance_counters::counter_raw,
                 "returns the overall number of created HPX-thread objects for "
                 "the referenced locality",
                 HPX_PERFORMANCE_COUNTER_V1, counts_creator,
                 &locality_allocator_counter_discoverer, ""},
+            {"/threads/count/task-descriptions-reused",
+                performance_counters::counter_raw,
+                "returns the number of staged task descriptions which were "
+                "taken from the freelist of the referenced worker-thread's "
+                "queue on the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1,
+                util::bind(&threadmanager::locality_pool_thread_counter_creator,
+                    this, &threadmanager::get_num_task_descriptions_reused,
+                    &detail::thread_pool_base::get_num_task_descriptions_reused,
+                    _1, _2),
+                &performance_counters::locality_pool_thread_counter_discoverer,
+                ""},
+            {"/threads/count/task-descriptions-allocated",
+                performance_counters::counter_raw,
+                "returns the number of staged task descriptions which had to "
+                "be allocated because the freelist of the referenced "
+                "worker-thread's queue on the referenced locality was empty",
+                HPX_PERFORMANCE_COUNTER_V1,
+                util::bind(&threadmanager::locality_pool_thread_counter_creator,
+                    this, &threadmanager::get_num_task_descriptions_allocated,
+                    &detail::thread_pool_base::
+                        get_num_task_descriptions_allocated,
+                    _1, _2),
+                &performance_counters::locality_pool_thread_counter_discoverer,
+                ""},
+            {"/threads/count/cross-worker-frees",
+                performance_counters::counter_raw,
+                "returns the number of HPX-thread objects owned by the "
+                "referenced worker-thread's queue on the referenced locality "
+                "which have terminated on a different worker-thread and were "
+                "handed back in batches",
+                HPX_PERFORMANCE_COUNTER_V1,
+                util::bind(&threadmanager::locality_pool_thread_counter_creator,
+                    this, &threadmanager::get_num_cross_worker_frees,
+                    &detail::thread_pool_base::get_num_cross_worker_frees,
+                    _1, _2),
+                &performance_counters::locality_pool_thread_counter_discoverer,
+                ""},
 #ifdef HPX_HAVE_THREAD_STEALING_COUNTS
             {"/threads/count/pending-misses", performance_counters::counter_raw,
                 "returns the number of times that the referenced worker-thread "
@@ -1795,6 +2215,75 @@ namespace hpx { namespace threads
                     &detail::thread_pool_base::get_num_stolen_to_staged, _1, _2),
                 &performance_counters::locality_pool_thread_counter_discoverer,
                 ""},
+            {"/threads/count/stolen-local",
+                performance_counters::counter_raw,
+                "returns the overall number of HPX-threads and task "
+                "descriptions stolen from schedulers located in the same "
+                "NUMA domain for the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1,
+                util::bind(&threadmanager::locality_pool_thread_counter_creator,
+                    this, &threadmanager::get_num_stolen_local,
+                    &detail::thread_pool_base::get_num_stolen_local, _1, _2),
+                &performance_counters::locality_pool_thread_counter_discoverer,
+                ""},
+            {"/threads/count/stolen-remote",
+                performance_counters::counter_raw,
+                "returns the overall number of HPX-threads and task "
+                "descriptions stolen from schedulers located in other "
+                "NUMA domains for the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1,
+                util::bind(&threadmanager::locality_pool_thread_counter_creator,
+                    this, &threadmanager::get_num_stolen_remote,
+                    &detail::thread_pool_base::get_num_stolen_remote, _1, _2),
+                &performance_counters::locality_pool_thread_counter_discoverer,
+                ""},
+            {"/threads/count/stolen-continuations",
+                performance_counters::counter_raw,
+                "returns the overall number of continuations of forking "
+                "HPX-threads (see launch::fork) stolen from the schedulers "
+                "of the referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1,
+                util::bind(&threadmanager::locality_pool_thread_counter_creator,
+                    this, &threadmanager::get_num_stolen_continuations,
+                    &detail::thread_pool_base::get_num_stolen_continuations,
+                    _1, _2),
+                &performance_counters::locality_pool_thread_counter_discoverer,
+                ""},
+#endif
+#ifdef HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF
+            {"/threads/count/idle-parks",
+                performance_counters::counter_raw,
+                "returns the overall number of times the worker threads of "
+                "the referenced locality have been parked while idling",
+                HPX_PERFORMANCE_COUNTER_V1,
+                util::bind(&threadmanager::locality_pool_thread_counter_creator,
+                    this, &threadmanager::get_num_idle_parks,
+                    &detail::thread_pool_base::get_num_idle_parks, _1, _2),
+                &performance_counters::locality_pool_thread_counter_discoverer,
+                ""},
+            {"/threads/count/idle-unparks",
+                performance_counters::counter_raw,
+                "returns the overall number of times parked worker threads "
+                "of the referenced locality have been woken up because of "
+                "new work",
+                HPX_PERFORMANCE_COUNTER_V1,
+                util::bind(&threadmanager::locality_pool_thread_counter_creator,
+                    this, &threadmanager::get_num_idle_unparks,
+                    &detail::thread_pool_base::get_num_idle_unparks, _1, _2),
+                &performance_counters::locality_pool_thread_counter_discoverer,
+                ""},
+            {"/threads/time/average-unpark-latency",
+                performance_counters::counter_raw,
+                "returns the average time between requesting a parked worker "
+                "thread to wake up and it resuming to look for work for the "
+                "referenced locality",
+                HPX_PERFORMANCE_COUNTER_V1,
+                util::bind(&threadmanager::locality_pool_thread_counter_creator,
+                    this, &threadmanager::get_average_unpark_latency,
+                    &detail::thread_pool_base::get_average_unpark_latency,
+                    _1, _2),
+                &performance_counters::locality_pool_thread_counter_discoverer,
+                "ns"},
 #endif
             // scheduler utilization
             {"/scheduler/utilization/instantaneous",
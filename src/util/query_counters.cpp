@@ -38,6 +38,68 @@
 
 namespace hpx { namespace util
 {
+    namespace
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Estimate a percentile from the data returned by a histogram
+        // counter: the lower and upper boundaries and the number of buckets,
+        // followed by the bucket counts (optionally enclosed by an underflow
+        // and an overflow bucket). Values are interpolated linearly inside a
+        // bucket.
+        double histogram_percentile(std::vector<std::int64_t> const& values,
+            double fraction)
+        {
+            if (values.size() < 4 || values[2] <= 0 || values[1] <= values[0])
+                return 0.0;
+
+            double const min_boundary = double(values[0]);
+            double const max_boundary = double(values[1]);
+            std::size_t const num_buckets = std::size_t(values[2]);
+            std::size_t const num_values = values.size() - 3;
+            bool const has_outer_buckets = num_values == num_buckets + 2;
+
+            double total = 0.0;
+            for (std::size_t i = 3; i != values.size(); ++i)
+                total += double(values[i]);
+            if (total == 0.0)
+                return 0.0;
+
+            double const width =
+                (max_boundary - min_boundary) / double(num_buckets);
+            double const target = fraction * total;
+
+            double count = 0.0;
+            for (std::size_t i = 0; i != num_values; ++i)
+            {
+                double const bucket_count = double(values[i + 3]);
+                if (bucket_count == 0.0 || count + bucket_count < target)
+                {
+                    count += bucket_count;
+                    continue;
+                }
+
+                if (has_outer_buckets)
+                {
+                    if (i == 0)
+                        return min_boundary;
+                    if (i == num_values - 1)
+                        return max_boundary;
+                    --i;
+                }
+
+                return min_boundary + width *
+                    (double(i) + (target - count) / bucket_count);
+            }
+            return max_boundary;
+        }
+
+        double const histogram_percentiles[] = { 0.5, 0.99, 0.999 };
+        char const* const histogram_percentile_names[] =
+        {
+            "p50", "p99", "p999"
+        };
+    }
+
     query_counters::query_counters(std::vector<std::string> const& names,
             std::vector<std::string> const& reset_names,
             std::int64_t interval, std::string const& dest, std::string const& form,
@@ -188,6 +250,13 @@ namespace hpx { namespace util
 
         if (!uom.empty())
             *out << ",[" << uom << "]";
+
+        for (std::size_t i = 0; i != 3; ++i)
+        {
+            *out << "," << histogram_percentile_names[i] << "="
+                 << hpx::util::format("%.0f", histogram_percentile(
+                        value.values_, histogram_percentiles[i]));
+        }
         *out << "\n";
     }
 
@@ -237,6 +306,12 @@ namespace hpx { namespace util
             first = false;
             *out << val;
         }
+
+        for (double percentile : histogram_percentiles)
+        {
+            *out << "," << hpx::util::format("%.0f",
+                histogram_percentile(value.values_, percentile));
+        }
     }
 
     template <typename Stream>
@@ -264,7 +339,8 @@ namespace hpx { namespace util
                     print_name_csv(output, infos[i].fullname_);
                 }
 
-                // now print array value counters
+                // now print array value counters, followed by the
+                // percentiles calculated from them
                 for (std::size_t i = 0; i != infos.size(); ++i)
                 {
                     if (infos[i].type_ != performance_counters::counter_histogram)
@@ -273,6 +349,12 @@ namespace hpx { namespace util
                         output << ",";
                     first = false;
                     print_name_csv(output, infos[i].fullname_);
+                    for (char const* name : histogram_percentile_names)
+                    {
+                        output << ",";
+                        print_name_csv(output,
+                            infos[i].fullname_ + "/" + name);
+                    }
                 }
 
                 output << "\n";
@@ -291,7 +373,8 @@ namespace hpx { namespace util
                     print_name_csv_short(output, counter_shortnames_[i]);
                 }
 
-                // now print array value counters
+                // now print array value counters, followed by the
+                // percentiles calculated from them
                 for (std::size_t i = 0; i != counter_shortnames_.size(); ++i)
                 {
                     if (infos[i].type_ != performance_counters::counter_histogram)
@@ -300,6 +383,12 @@ namespace hpx { namespace util
                         output << ",";
                     first = false;
                     print_name_csv_short(output, counter_shortnames_[i]);
+                    for (char const* name : histogram_percentile_names)
+                    {
+                        output << ",";
+                        print_name_csv_short(output,
+                            counter_shortnames_[i] + "/" + name);
+                    }
                 }
 
                 output << "\n";
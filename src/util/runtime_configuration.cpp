@@ -78,6 +78,10 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         // this global (urghhh) variable is used to control whether guard pages
         // will be used or not
         HPX_EXPORT bool use_guard_pages = true;
+
+        // this global variable limits the number of idle stacks kept by the
+        // stack pool (per stack size)
+        HPX_EXPORT std::size_t stack_pool_high_water_mark = 1024;
     }
 }}}}
 #endif
@@ -195,6 +199,9 @@ namespace hpx { namespace util
                 HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_IDLE_LOOP_COUNT_MAX)) "}",
             "max_busy_loop_count = ${HPX_MAX_BUSY_LOOP_COUNT:"
                 HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_BUSY_LOOP_COUNT_MAX)) "}",
+            "idle_pause_rounds = ${HPX_IDLE_PAUSE_ROUNDS:2}",
+            "idle_yield_rounds = ${HPX_IDLE_YIELD_ROUNDS:2}",
+            "max_idle_park_time = ${HPX_MAX_IDLE_PARK_TIME:10000}",
 
             /// If HPX_HAVE_ATTACH_DEBUGGER_ON_TEST_FAILURE is set,
             /// then apply the test-failure value as default.
@@ -230,6 +237,7 @@ namespace hpx { namespace util
                 HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_HUGE_STACK_SIZE)) "}",
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
             "use_guard_pages = ${HPX_USE_GUARD_PAGES:1}",
+            "pool_high_water_mark = ${HPX_STACK_POOL_HIGH_WATER_MARK:1024}",
 #endif
 
             "[hpx.threadpools]",
@@ -245,9 +253,21 @@ namespace hpx { namespace util
                 "${HPX_THREAD_QUEUE_MIN_TASKS_TO_STEAL_PENDING:0}",
             "min_tasks_to_steal_staged = "
                 "${HPX_THREAD_QUEUE_MIN_TASKS_TO_STEAL_STAGED:10}",
+            "min_tasks_to_steal_pending_socket = "
+                "${HPX_THREAD_QUEUE_MIN_TASKS_TO_STEAL_PENDING_SOCKET:0}",
+            "min_tasks_to_steal_staged_socket = "
+                "${HPX_THREAD_QUEUE_MIN_TASKS_TO_STEAL_STAGED_SOCKET:10}",
+            "min_tasks_to_steal_pending_remote = "
+                "${HPX_THREAD_QUEUE_MIN_TASKS_TO_STEAL_PENDING_REMOTE:4}",
+            "min_tasks_to_steal_staged_remote = "
+                "${HPX_THREAD_QUEUE_MIN_TASKS_TO_STEAL_STAGED_REMOTE:20}",
+            "max_remote_steal_backoff = "
+                "${HPX_THREAD_QUEUE_MAX_REMOTE_STEAL_BACKOFF:64}",
             "min_add_new_count = ${HPX_THREAD_QUEUE_MIN_ADD_NEW_COUNT:10}",
             "max_add_new_count = ${HPX_THREAD_QUEUE_MAX_ADD_NEW_COUNT:10}",
             "max_delete_count = ${HPX_THREAD_QUEUE_MAX_DELETE_COUNT:1000}",
+            "thread_return_batch_size = "
+                "${HPX_THREAD_QUEUE_THREAD_RETURN_BATCH_SIZE:16}",
             "max_terminated_threads = ${HPX_SCHEDULER_MAX_TERMINATED_THREADS:"
               HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_SCHEDULER_MAX_TERMINATED_THREADS)) "}",
 
@@ -294,6 +314,11 @@ namespace hpx { namespace util
                 HPX_PP_STRINGIZE(HPX_PP_EXPAND(
                     HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS))
                 "}",
+            "refcnt_flush_interval = "
+                "${HPX_AGAS_REFCNT_FLUSH_INTERVAL:"
+                HPX_PP_STRINGIZE(HPX_PP_EXPAND(
+                    HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL))
+                "}",
             "service_mode = hosted",
             "local_cache_size = ${HPX_AGAS_LOCAL_CACHE_SIZE:"
                 HPX_PP_STRINGIZE(HPX_PP_EXPAND(HPX_AGAS_LOCAL_CACHE_SIZE)) "}",
@@ -511,6 +536,8 @@ namespace hpx { namespace util
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
         threads::coroutines::detail::posix::use_guard_pages =
             init_use_stack_guard_pages();
+        threads::coroutines::detail::posix::stack_pool_high_water_mark =
+            init_stack_pool_high_water_mark();
 #endif
 #ifdef HPX_HAVE_VERIFY_LOCKS
         if (enable_lock_detection())
@@ -572,6 +599,8 @@ namespace hpx { namespace util
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
         threads::coroutines::detail::posix::use_guard_pages =
             init_use_stack_guard_pages();
+        threads::coroutines::detail::posix::stack_pool_high_water_mark =
+            init_stack_pool_high_water_mark();
 #endif
 #ifdef HPX_HAVE_VERIFY_LOCKS
         if (enable_lock_detection())
@@ -743,6 +772,20 @@ namespace hpx { namespace util
         return HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS;
     }
 
+    std::uint64_t
+    runtime_configuration::get_agas_refcnt_flush_interval() const
+    {
+        if (has_section("hpx.agas")) {
+            util::section const* sec = get_section("hpx.agas");
+            if (nullptr != sec) {
+                return hpx::util::get_entry_as<std::uint64_t>(
+                    *sec, "refcnt_flush_interval",
+                    HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL);
+            }
+        }
+        return HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL;
+    }
+
     bool runtime_configuration::get_itt_notify_mode() const
     {
 #if HPX_HAVE_ITTNOTIFY != 0
@@ -948,6 +991,18 @@ namespace hpx { namespace util
         }
         return true;    // default is true
     }
+
+    std::size_t runtime_configuration::init_stack_pool_high_water_mark() const
+    {
+        if (has_section("hpx")) {
+            util::section const* sec = get_section("hpx.stacks");
+            if (nullptr != sec) {
+                return hpx::util::get_entry_as<std::size_t>(
+                    *sec, "pool_high_water_mark", "1024");
+            }
+        }
+        return 1024;    // default is 1024
+    }
 #endif
 
     std::ptrdiff_t runtime_configuration::init_small_stack_size() const
@@ -1041,6 +1096,9 @@ namespace hpx { namespace util
         case threads::thread_stacksize_huge:
             return huge_stacksize;
 
+        case threads::thread_stacksize_nostack:
+            return HPX_NOSTACK_STACK_SIZE;
+
         default:
         case threads::thread_stacksize_small:
             break;
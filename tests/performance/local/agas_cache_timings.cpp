@@ -1,4 +1,4 @@
-//  Copyright (c) 2016 Hartmut Kaiser
+//  Copyright (c) 2016-2017 Hartmut Kaiser
 //
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -11,10 +11,12 @@
 #include <hpx/hpx.hpp>
 #include <hpx/hpx_init.hpp>
 
+#include <hpx/runtime/agas/detail/gva_cache.hpp>
 #include <hpx/util/cache/entries/lfu_entry.hpp>
 #include <hpx/util/cache/local_cache.hpp>
 #include <hpx/util/cache/statistics/local_full_statistics.hpp>
 #include <hpx/util/detail/pp/stringize.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/util/histogram.hpp>
 
 #include <boost/program_options.hpp>
@@ -25,6 +27,7 @@
 #include <cstdint>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -226,6 +229,114 @@ void test_update(gva_cache_type& cache, hpx::naming::gid_type first_key)
     calculate_histogram("update", timings);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Measure the throughput of concurrent lookups, the original cache is
+// protected by a single lock (as it was in the addressing_service)
+typedef hpx::lcos::local::spinlock mutex_type;
+
+void get_locked(gva_cache_type& cache, mutex_type& mtx,
+    hpx::naming::gid_type first_key, std::size_t num_entries,
+    std::uint64_t iterations)
+{
+    for (std::uint64_t i = 0; i != iterations; ++i)
+    {
+        gva_cache_key key(first_key + (i % num_entries), 1);
+        gva_cache_key idbase;
+        gva_cache_type::entry_type e;
+
+        std::lock_guard<mutex_type> l(mtx);
+        cache.get_entry(key, idbase, e);
+    }
+}
+
+void get_concurrent(hpx::agas::detail::gva_cache& cache,
+    hpx::naming::gid_type first_key, std::size_t num_entries,
+    std::uint64_t iterations)
+{
+    for (std::uint64_t i = 0; i != iterations; ++i)
+    {
+        hpx::naming::gid_type idbase;
+        hpx::agas::gva g;
+
+        cache.get_entry(first_key + (i % num_entries), idbase, g);
+    }
+}
+
+template <typename F>
+double run_tasks(std::size_t num_tasks, F const& f)
+{
+    hpx::util::high_resolution_timer t;
+
+    std::vector<hpx::future<void> > tasks;
+    tasks.reserve(num_tasks);
+    for (std::size_t i = 0; i != num_tasks; ++i)
+        tasks.push_back(hpx::async(f));
+    hpx::wait_all(tasks);
+
+    return t.elapsed();
+}
+
+void test_scaling(std::size_t cache_size, std::size_t num_entries,
+    std::uint64_t iterations)
+{
+    hpx::naming::gid_type locality = hpx::get_locality();
+    std::uint32_t ct = hpx::components::component_invalid;
+
+    // make sure both caches are able to hold all entries, otherwise this
+    // would measure cache misses only
+    cache_size = (std::max)(cache_size, 2 * num_entries);
+
+    gva_cache_type cache;
+    cache.reserve(cache_size);
+    mutex_type mtx;
+
+    hpx::agas::detail::gva_cache concurrent_cache(cache_size);
+
+    hpx::naming::gid_type first_key = hpx::detail::get_next_id(num_entries);
+    for (std::size_t i = 0; i != num_entries; ++i)
+    {
+        hpx::agas::gva value(locality, ct, 1, std::uint64_t(i), 0);
+
+        cache.insert(gva_cache_key(first_key + i, 1), value);
+
+        hpx::naming::gid_type collision_base;
+        std::uint64_t collision_count = 0;
+        concurrent_cache.update_entry(first_key + i, 1, value,
+            collision_base, collision_count);
+    }
+
+    std::cout
+        << "scaling: entries: " << num_entries
+        << ", cached (locked): " << cache.size()
+        << ", cached (concurrent): " << concurrent_cache.size()
+        << std::endl;
+
+    std::size_t const num_threads = hpx::get_os_thread_count();
+    for (std::size_t num_tasks = 1; num_tasks <= num_threads; num_tasks *= 2)
+    {
+        double locked = run_tasks(num_tasks,
+            [&]()
+            {
+                get_locked(cache, mtx, first_key, num_entries, iterations);
+            });
+
+        double concurrent = run_tasks(num_tasks,
+            [&]()
+            {
+                get_concurrent(concurrent_cache, first_key, num_entries,
+                    iterations);
+            });
+
+        double const num_ops = double(num_tasks * iterations);
+        std::cout
+            << "tasks: " << std::setw(3) << num_tasks
+            << ", locked: " << std::setw(12) << num_ops / locked << " [ops/s]"
+            << ", concurrent: " << std::setw(12) << num_ops / concurrent
+            << " [ops/s]"
+            << std::endl;
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(boost::program_options::variables_map& vm)
 {
@@ -246,6 +357,9 @@ int hpx_main(boost::program_options::variables_map& vm)
     test_get(cache, first_key);
     test_update(cache, first_key);
 
+    std::uint64_t iterations = vm["iterations"].as<std::uint64_t>();
+    test_scaling(cache_size, num_entries, iterations);
+
     return hpx::finalize();
 }
 
@@ -261,6 +375,9 @@ int main(int argc, char* argv[])
          HPX_PP_STRINGIZE(HPX_AGAS_LOCAL_CACHE_SIZE_PER_THREAD) ")")
         ("num_entries,n", value<std::size_t>(),
          "number of items to insert into cache (default: 1000)")
+        ("iterations", value<std::uint64_t>()->default_value(100000),
+         "number of concurrent lookups performed by each task "
+         "(default: 100000)")
         ;
 
     // Initialize and run HPX
@@ -0,0 +1,230 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the throughput of the AGAS primary namespace
+// (resolve_gid, route, and increment_credit) while being invoked concurrently
+// from all worker threads. It uses a private instance of the primary
+// namespace which maps its gids onto a local sink component.
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/runtime/agas/server/primary_namespace.hpp>
+#include <hpx/runtime/parcelset/put_parcel.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+std::atomic<std::uint64_t> sent_parcels(0);
+std::atomic<std::uint64_t> routed_parcels(0);
+
+struct sink
+  : hpx::components::component_base<sink>
+{
+    void touch()
+    {
+        ++routed_parcels;
+    }
+    HPX_DEFINE_COMPONENT_ACTION(sink, touch, touch_action);
+};
+
+typedef hpx::components::component<sink> sink_type;
+HPX_REGISTER_COMPONENT(sink_type, sink);
+
+typedef sink::touch_action touch_action;
+HPX_REGISTER_ACTION(touch_action);
+
+typedef hpx::agas::server::primary_namespace primary_namespace;
+
+///////////////////////////////////////////////////////////////////////////////
+enum operation
+{
+    op_resolve = 0,
+    op_route = 1,
+    op_incref = 2,
+    op_mixed = 3
+};
+
+char const* const operation_names[] =
+{
+    "resolve", "route", "incref", "mixed"
+};
+
+void invoke(primary_namespace& pns, operation op, hpx::naming::gid_type id)
+{
+    switch (op)
+    {
+    case op_resolve:
+        pns.resolve_gid(id);
+        break;
+
+    case op_route:
+        {
+            // don't let the primary namespace update the AGAS cache
+            hpx::naming::detail::set_dont_store_in_cache(id);
+
+            hpx::parcelset::parcel p =
+                hpx::parcelset::detail::create_parcel::call(std::false_type(),
+                    std::move(id), hpx::naming::address(), touch_action());
+            p.set_source_id(hpx::find_here());
+
+            ++sent_parcels;
+            pns.route(std::move(p));
+        }
+        break;
+
+    case op_incref:
+        pns.increment_credit(1, id, id);
+        break;
+
+    default:
+        HPX_ASSERT(false);
+        break;
+    }
+}
+
+void worker(primary_namespace& pns, operation op,
+    std::vector<hpx::naming::gid_type> const& gids, std::uint64_t iterations,
+    std::size_t seed)
+{
+    std::mt19937 gen(static_cast<std::uint32_t>(seed));
+    std::uniform_int_distribution<std::size_t> dist_gid(0, gids.size() - 1);
+    std::uniform_int_distribution<int> dist_op(op_resolve, op_incref);
+
+    for (std::uint64_t i = 0; i != iterations; ++i)
+    {
+        operation current = (op == op_mixed) ?
+            static_cast<operation>(dist_op(gen)) : op;
+        invoke(pns, current, gids[dist_gid(gen)]);
+    }
+}
+
+void run(primary_namespace& pns, operation op,
+    std::vector<hpx::naming::gid_type> const& gids, std::size_t num_tasks,
+    std::uint64_t iterations)
+{
+    sent_parcels.store(0);
+    routed_parcels.store(0);
+
+    hpx::util::high_resolution_timer t;
+
+    std::vector<hpx::future<void> > tasks;
+    tasks.reserve(num_tasks);
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        tasks.push_back(hpx::async(&worker, std::ref(pns), op, std::cref(gids),
+            iterations, i));
+    }
+    hpx::wait_all(tasks);
+
+    double elapsed = t.elapsed();
+
+    // wait for all routed parcels to be delivered
+    while (routed_parcels.load() != sent_parcels.load())
+        hpx::this_thread::yield();
+
+    std::uint64_t const num_ops = num_tasks * iterations;
+    std::cout
+        << operation_names[op] << ": "
+        << num_ops << " operations, "
+        << elapsed << " [s], "
+        << (elapsed * 1e9) / num_ops << " [ns/op], "
+        << num_ops / elapsed << " [ops/s]"
+        << std::endl;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t num_gids = vm["num-gids"].as<std::size_t>();
+    std::uint64_t range_size = vm["range-size"].as<std::uint64_t>();
+    std::uint64_t iterations = vm["iterations"].as<std::uint64_t>();
+
+    std::size_t num_tasks = hpx::get_os_thread_count();
+    if (vm.count("tasks"))
+        num_tasks = vm["tasks"].as<std::size_t>();
+
+    if (num_gids == 0 || range_size == 0)
+    {
+        std::cerr << "num-gids and range-size have to be larger than zero"
+            << std::endl;
+        return hpx::finalize();
+    }
+
+    // all routed parcels are delivered to this object
+    hpx::id_type target = hpx::new_<sink>(hpx::find_here()).get();
+    hpx::naming::address addr =
+        hpx::agas::resolve(hpx::launch::sync, target);
+
+    // use a locality id which is not in use to avoid clashes with the
+    // gids managed by the runtime system
+    std::unique_ptr<primary_namespace> pns(new primary_namespace);
+    pns->set_local_locality(
+        hpx::naming::get_gid_from_locality_id(0xfffffffe));
+
+    // bind ranges of gids, all of them refer to the sink
+    std::vector<hpx::naming::gid_type> gids;
+    gids.reserve(num_gids);
+
+    while (gids.size() < num_gids)
+    {
+        std::pair<hpx::naming::gid_type, hpx::naming::gid_type> range =
+            pns->allocate(range_size);
+
+        hpx::naming::gid_type base = range.first;
+        hpx::naming::detail::strip_internal_bits_from_gid(base);
+
+        pns->bind_gid(
+            hpx::agas::gva(addr.locality_, addr.type_, range_size,
+                addr.address_, 0),
+            base, addr.locality_);
+
+        for (std::uint64_t i = 0; i != range_size && gids.size() < num_gids; ++i)
+            gids.push_back(base + i);
+    }
+
+    std::cout << "tasks: " << num_tasks << ", gids: " << num_gids
+        << ", range-size: " << range_size << std::endl;
+
+    run(*pns, op_resolve, gids, num_tasks, iterations);
+    run(*pns, op_route, gids, num_tasks, iterations);
+    run(*pns, op_incref, gids, num_tasks, iterations);
+    run(*pns, op_mixed, gids, num_tasks, iterations);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("num-gids", value<std::size_t>()->default_value(100000),
+         "number of gids bound in the primary namespace (default: 100000)")
+        ("range-size", value<std::uint64_t>()->default_value(1),
+         "number of gids bound per range (default: 1)")
+        ("iterations", value<std::uint64_t>()->default_value(100000),
+         "number of operations performed by each task (default: 100000)")
+        ("tasks", value<std::size_t>(),
+         "number of concurrent tasks (default: number of worker threads)")
+        ;
+
+    // Initialize and run HPX
+    return hpx::init(desc_commandline, argc, argv);
+}
@@ -0,0 +1,109 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the time needed to create (and destroy) a number
+// of components using hpx::new_<T[]>(), the components are created in bulk
+// on the local locality.
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct simple
+  : hpx::components::component_base<simple>
+{
+    simple() : value_(0) {}
+    explicit simple(std::uint64_t value) : value_(value) {}
+
+    std::uint64_t get_value() const
+    {
+        return value_;
+    }
+    HPX_DEFINE_COMPONENT_ACTION(simple, get_value, get_value_action);
+
+    std::uint64_t value_;
+};
+
+typedef hpx::components::component<simple> simple_type;
+HPX_REGISTER_COMPONENT(simple_type, simple);
+
+typedef simple::get_value_action get_value_action;
+HPX_REGISTER_ACTION(get_value_action);
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t count = vm["count"].as<std::size_t>();
+    std::uint64_t iterations = vm["iterations"].as<std::uint64_t>();
+
+    hpx::id_type here = hpx::find_here();
+
+    double create_time = 0.0;
+    double destroy_time = 0.0;
+
+    for (std::uint64_t i = 0; i != iterations; ++i)
+    {
+        hpx::util::high_resolution_timer t;
+
+        std::vector<hpx::id_type> ids =
+            hpx::new_<simple[]>(here, count, i).get();
+
+        create_time += t.elapsed();
+
+        // make sure the objects are reachable through their ids
+        if (get_value_action()(ids.back()) != i)
+        {
+            std::cerr << "unexpected value returned from component"
+                << std::endl;
+            return hpx::finalize();
+        }
+
+        t.restart();
+
+        ids.clear();
+        hpx::agas::garbage_collect();
+
+        destroy_time += t.elapsed();
+    }
+
+    std::uint64_t const num_objects = count * iterations;
+    std::cout
+        << "components: " << count << ", iterations: " << iterations
+        << std::endl
+        << "create: " << create_time << " [s], "
+        << (create_time * 1e9) / num_objects << " [ns/component]"
+        << std::endl
+        << "destroy: " << destroy_time << " [s], "
+        << (destroy_time * 1e9) / num_objects << " [ns/component]"
+        << std::endl;
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("count", value<std::size_t>()->default_value(100000),
+         "number of components created at once (default: 100000)")
+        ("iterations", value<std::uint64_t>()->default_value(10),
+         "number of times the components are created (default: 10)")
+        ;
+
+    // Initialize and run HPX
+    return hpx::init(desc_commandline, argc, argv);
+}
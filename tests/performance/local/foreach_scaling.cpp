@@ -8,6 +8,7 @@
 #include <hpx/util/high_resolution_clock.hpp>
 #include <hpx/include/parallel_algorithm.hpp>
 #include <hpx/include/parallel_executor_parameters.hpp>
+#include <hpx/include/parallel_executors.hpp>
 #include <hpx/include/iostreams.hpp>
 #include "worker_timed.hpp"
 
@@ -127,6 +128,52 @@ std::uint64_t average_out_task(std::size_t vector_size)
     return (hpx::util::high_resolution_clock::now() - start) / test_count;
 }
 
+// spawn one task per element using the bulk interface of the executor, this
+// registers all tasks with the scheduler at once
+std::uint64_t average_out_bulk_spawn(std::size_t vector_size)
+{
+    std::vector<std::size_t> data_representation(vector_size);
+    std::iota(std::begin(data_representation),
+        std::end(data_representation),
+        std::rand());
+
+    hpx::parallel::execution::parallel_executor exec;
+
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    for(auto i = 0; i < test_count; i++)
+    {
+        hpx::wait_all(hpx::parallel::execution::bulk_async_execute(exec,
+            [](std::size_t) {
+                worker_timed(delay);
+            },
+            data_representation));
+    }
+
+    return (hpx::util::high_resolution_clock::now() - start) / test_count;
+}
+
+// spawn one task per element using hpx::async for each of them
+std::uint64_t average_out_async_spawn(std::size_t vector_size)
+{
+    std::vector<hpx::future<void> > tasks;
+    tasks.reserve(vector_size);
+
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    for(auto i = 0; i < test_count; i++)
+    {
+        for (std::size_t j = 0; j != vector_size; ++j)
+        {
+            tasks.push_back(hpx::async([]() { worker_timed(delay); }));
+        }
+        hpx::wait_all(tasks);
+        tasks.clear();
+    }
+
+    return (hpx::util::high_resolution_clock::now() - start) / test_count;
+}
+
 std::uint64_t average_out_sequential(std::size_t vector_size)
 {
     std::uint64_t start = hpx::util::high_resolution_clock::now();
@@ -160,11 +207,15 @@ int hpx_main(boost::program_options::variables_map& vm)
         std::uint64_t par_time = average_out_parallel(vector_size);
         std::uint64_t task_time = average_out_task(vector_size);
         std::uint64_t seq_time = average_out_sequential(vector_size);
+        std::uint64_t bulk_spawn_time = average_out_bulk_spawn(vector_size);
+        std::uint64_t async_spawn_time = average_out_async_spawn(vector_size);
 
         if(csvoutput) {
             hpx::cout << "," << seq_time/1e9
                       << "," << par_time/1e9
-                      << "," << task_time/1e9 << "\n" << hpx::flush;
+                      << "," << task_time/1e9
+                      << "," << bulk_spawn_time/1e9
+                      << "," << async_spawn_time/1e9 << "\n" << hpx::flush;
         }
         else {
         // print results(Formatted). Setw(x) assures that all output is right justified
@@ -185,13 +236,23 @@ int hpx_main(boost::program_options::variables_map& vm)
                              << std::right << std::setw(8) << task_time/1e9 << "\n"
                 << std::left << "Average sequential execution time: "
                              << std::right << std::setw(8) << seq_time/1e9 << "\n"
+                << std::left << "Average bulk spawn time          : "
+                             << std::right << std::setw(8)
+                             << bulk_spawn_time/1e9 << "\n"
+                << std::left << "Average async spawn time         : "
+                             << std::right << std::setw(8)
+                             << async_spawn_time/1e9 << "\n"
                              << hpx::flush;
 
             hpx::cout << "---------Execution Time Difference---------\n"
                 << std::left << "Parallel Scale: " << std::right  << std::setw(27)
                              << (double(seq_time) / par_time) << "\n"
                 << std::left << "Task Scale    : " << std::right  << std::setw(27)
-                             << (double(seq_time) / task_time) << "\n" << hpx::flush;
+                             << (double(seq_time) / task_time) << "\n"
+                << std::left << "Bulk Spawn Speedup: " << std::right
+                             << std::setw(23)
+                             << (double(async_spawn_time) / bulk_spawn_time)
+                             << "\n" << hpx::flush;
         }
     }
 
@@ -13,6 +13,7 @@
 #include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/include/async.hpp>
 #include <hpx/include/iostreams.hpp>
+#include <hpx/include/threads.hpp>
 
 #include <cstdint>
 #include <stdexcept>
@@ -30,8 +31,12 @@ using hpx::naming::id_type;
 
 using hpx::future;
 using hpx::async;
+using hpx::make_ready_future;
 using hpx::lcos::wait_each;
 
+using hpx::threads::executors::default_executor;
+using hpx::threads::executors::stackless_executor;
+
 using hpx::util::high_resolution_timer;
 
 using hpx::cout;
@@ -120,6 +125,78 @@ void measure_function_futures(std::uint64_t count, bool csv)
             duration) << flush;
 }
 
+template <typename Executor>
+void measure_function_futures_executor(std::uint64_t count, bool csv,
+    Executor& exec, char const* name)
+{
+    std::vector<future<double> > futures;
+
+    futures.reserve(count);
+
+    // start the clock
+    high_resolution_timer walltime;
+
+    for (std::uint64_t i = 0; i < count; ++i)
+        futures.push_back(async(exec, &null_function));
+
+    wait_each(scratcher(), futures);
+
+    // stop the clock
+    const double duration = walltime.elapsed();
+
+    if (csv)
+        hpx::util::format_to(cout,
+            "%1%,%2%\n",
+            count,
+            duration) << flush;
+    else
+        hpx::util::format_to(cout,
+            "invoked %1% futures (functions, %2%) in %3% seconds\n",
+            count,
+            name,
+            duration) << flush;
+}
+
+struct continuation
+{
+    double operator()(future<double> r) const
+    {
+        return r.get() + null_function();
+    }
+};
+
+template <typename Executor>
+void measure_continuation_futures(std::uint64_t count, bool csv,
+    Executor& exec, char const* name)
+{
+    std::vector<future<double> > futures;
+
+    futures.reserve(count);
+
+    // start the clock
+    high_resolution_timer walltime;
+
+    for (std::uint64_t i = 0; i < count; ++i)
+        futures.push_back(make_ready_future(0.).then(exec, continuation()));
+
+    wait_each(scratcher(), futures);
+
+    // stop the clock
+    const double duration = walltime.elapsed();
+
+    if (csv)
+        hpx::util::format_to(cout,
+            "%1%,%2%\n",
+            count,
+            duration) << flush;
+    else
+        hpx::util::format_to(cout,
+            "invoked %1% futures (continuations, %2%) in %3% seconds\n",
+            count,
+            name,
+            duration) << flush;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(
     variables_map& vm
@@ -133,8 +210,20 @@ int hpx_main(
         if (HPX_UNLIKELY(0 == count))
             throw std::logic_error("error: count of 0 futures specified\n");
 
-        measure_action_futures(count, vm.count("csv") != 0);
-        measure_function_futures(count, vm.count("csv") != 0);
+        bool csv = vm.count("csv") != 0;
+
+        measure_action_futures(count, csv);
+        measure_function_futures(count, csv);
+
+        // compare threads with a stack of their own with stackless threads
+        default_executor stackful;
+        stackless_executor stackless;
+
+        measure_function_futures_executor(count, csv, stackful, "stackful");
+        measure_function_futures_executor(count, csv, stackless, "stackless");
+
+        measure_continuation_futures(count, csv, stackful, "stackful");
+        measure_continuation_futures(count, csv, stackless, "stackless");
     }
 
     finalize();
@@ -15,6 +15,7 @@
 #include <cstdint>
 #include <fstream>
 #include <iterator>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -41,7 +42,7 @@ std::size_t get_archive_size(hpx::parcelset::parcel const& p,
 
 ///////////////////////////////////////////////////////////////////////////////
 double benchmark_serialization(std::size_t data_size, std::size_t iterations,
-    bool continuation, bool zerocopy)
+    bool continuation, bool zerocopy, bool reuse)
 {
     hpx::naming::id_type const here = hpx::find_here();
     hpx::naming::address addr(hpx::get_locality(),
@@ -115,11 +116,65 @@ double benchmark_serialization(std::size_t data_size, std::size_t iterations,
     if (zerocopy)
         chunks = new std::vector<hpx::serialization::serialization_chunk>();
 
+    // the archives used if those are reused across messages
+    hpx::serialization::detail::preprocess gather_size;
+    std::vector<char> reused_buffer;
+    std::unique_ptr<hpx::serialization::output_archive> size_archive;
+    std::unique_ptr<hpx::serialization::output_archive> out_archive;
+    std::unique_ptr<hpx::serialization::input_archive> in_archive;
+
     //std::uint32_t dest_locality_id = outp.destination_locality_id();
     hpx::util::high_resolution_timer t;
 
     for (std::size_t i = 0; i != iterations; ++i)
     {
+        if (reuse)
+        {
+            // gather the required size for the archive
+            if (!size_archive)
+            {
+                size_archive.reset(new hpx::serialization::output_archive(
+                    gather_size, out_archive_flags, chunks));
+            }
+            else
+            {
+                size_archive->reset();
+            }
+            *size_archive << outp;
+
+            std::size_t arg_size = gather_size.size();
+            if (reused_buffer.size() < arg_size + HPX_PARCEL_SERIALIZATION_OVERHEAD)
+                reused_buffer.resize(arg_size + HPX_PARCEL_SERIALIZATION_OVERHEAD);
+
+            // serialize the parcel
+            if (!out_archive)
+            {
+                out_archive.reset(new hpx::serialization::output_archive(
+                    reused_buffer, out_archive_flags, chunks));
+            }
+            else
+            {
+                out_archive->reset();
+            }
+            *out_archive << outp;
+            arg_size = out_archive->bytes_written();
+
+            // deserialize the parcel
+            hpx::parcelset::parcel inp;
+            if (!in_archive)
+            {
+                in_archive.reset(new hpx::serialization::input_archive(
+                    reused_buffer, arg_size, chunks));
+            }
+            else
+            {
+                in_archive->reset(arg_size, chunks);
+            }
+            *in_archive >> inp;
+
+            continue;
+        }
+
         std::size_t arg_size = get_archive_size(outp, out_archive_flags, chunks);
         std::vector<char> out_buffer;
 
@@ -160,13 +215,14 @@ int hpx_main(boost::program_options::variables_map& vm)
     bool print_header = vm.count("no-header") == 0;
     bool continuation = vm.count("continuation") != 0;
     bool zerocopy = vm.count("zerocopy") != 0;
+    bool reuse = vm.count("reuse-archives") != 0;
 
     std::vector<hpx::future<double> > timings;
     for (std::size_t i = 0; i != concurrency; ++i)
     {
         timings.push_back(hpx::async(
             &benchmark_serialization, data_size, iterations,
-            continuation, zerocopy));
+            continuation, zerocopy, reuse));
     }
 
     double overall_time = 0;
@@ -207,6 +263,9 @@ int main(int argc, char* argv[])
         ( "zerocopy"
         , "use zero copy serialization of bitwise copyable arguments")
 
+        ( "reuse-archives"
+        , "reuse the archives (and their buffers) for all serialized parcels")
+
         ( "no-header"
         , "do not print out the csv header row")
         ;
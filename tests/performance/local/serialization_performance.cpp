@@ -4,6 +4,8 @@
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <hpx/include/plain_actions.hpp>
+#include <hpx/runtime/actions/transfer_action.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
 #include <hpx/runtime/serialization/string.hpp>
 #include <hpx/runtime/serialization/vector.hpp>
@@ -173,6 +175,50 @@ namespace hpx_test
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// plain actions with bitwise serializable arguments
+void action0() {}
+HPX_PLAIN_ACTION(action0, action0_action)
+
+void action1(double) {}
+HPX_PLAIN_ACTION(action1, action1_action)
+
+void action4(int, double, std::uint64_t, float) {}
+HPX_PLAIN_ACTION(action4, action4_action)
+
+template <typename Action, typename ...Ts>
+void hpx_action_serialization_test(char const* name, std::size_t iterations,
+    Ts const&... vs)
+{
+    hpx::actions::transfer_action<Action> action(vs...);
+    std::vector<char> serialized;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        serialized.clear();
+        {
+            hpx::serialization::output_archive archiver(serialized);
+            action.save(archiver);
+        }
+        {
+            hpx::actions::transfer_action<Action> received;
+            hpx::serialization::input_archive archiver(
+                serialized, serialized.size());
+            received.load(archiver);
+        }
+    }
+
+    auto finish = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        finish - start).count();
+
+    std::cout << "hpx: " << name << ", size = " << serialized.size()
+              << " bytes, time = " << duration << " milliseconds"
+              << std::endl;
+}
+
 void hpx_serialization_test(std::size_t iterations)
 {
     using namespace hpx_test;
@@ -239,5 +285,13 @@ int main(int argc, char **argv)
     }
 
     hpx_serialization_test(iterations);
+
+    hpx_action_serialization_test<action0_action>(
+        "action with 0 arguments", iterations);
+    hpx_action_serialization_test<action1_action>(
+        "action with 1 argument ", iterations, 42.0);
+    hpx_action_serialization_test<action4_action>(
+        "action with 4 arguments", iterations,
+        42, 42.0, std::uint64_t(42), 42.0f);
 }
 
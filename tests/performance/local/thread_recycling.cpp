@@ -0,0 +1,130 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the cost of creating HPX-threads on one worker
+// thread while they are stolen and terminated by the other worker threads.
+// The thread objects terminated this way are handed back to the queue of
+// the creating worker thread in batches (see the configuration setting
+// hpx.thread_queue.thread_return_batch_size), the number of those
+// cross-worker frees is reported alongside the timings.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/include/thread_executors.hpp>
+#include <hpx/util/detail/pp/stringize.hpp>
+#include <hpx/util/format.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/program_options.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "worker_timed.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t iterations = 100000;
+std::size_t repetitions = 5;
+std::uint64_t delay = 0;
+
+void just_wait()
+{
+    worker_timed(delay * 1000);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+double measure_once()
+{
+    // create all threads on the first worker thread, all others have to
+    // steal the work (and terminate the stolen threads)
+    hpx::threads::executors::default_executor exec(std::size_t(0));
+
+    std::vector<hpx::future<void> > threads;
+    threads.reserve(iterations);
+
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+
+    for (std::size_t i = 0; i != iterations; ++i)
+        threads.push_back(hpx::async(exec, &just_wait));
+
+    hpx::wait_all(threads);
+
+    std::uint64_t stop = hpx::util::high_resolution_clock::now();
+    return (stop - start) / 1e9;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    {
+#       define HPX_SIZEOF(type)                                               \
+            hpx::util::format("%1% %|40t|%2%\n",                              \
+                HPX_PP_STRINGIZE(type), sizeof(type))                         \
+            /**/
+
+        hpx::cout << HPX_SIZEOF(hpx::threads::thread_data) << hpx::flush;
+
+#       undef HPX_SIZEOF
+    }
+
+    hpx::performance_counters::performance_counter frees(
+        "/threads{locality#0/total}/count/cross-worker-frees");
+    hpx::performance_counters::performance_counter objects(
+        "/threads{locality#0/total}/count/objects");
+
+    // reset the counters
+    frees.get_value<std::int64_t>(hpx::launch::sync, true);
+
+    bool print_header = vm.count("no-header") == 0;
+    if (print_header)
+    {
+        hpx::cout
+            << "num_cores,num_threads,time[s],cross_worker_frees,objects"
+            << hpx::endl;
+    }
+
+    for (std::size_t i = 0; i != repetitions; ++i)
+    {
+        double elapsed = measure_once();
+
+        hpx::util::format_to(hpx::cout, "%d,%d,%f,%d,%d",
+            hpx::get_os_thread_count(),
+            iterations,
+            elapsed,
+            frees.get_value<std::int64_t>(hpx::launch::sync, true),
+            objects.get_value<std::int64_t>(hpx::launch::sync)) << hpx::endl;
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    namespace po = boost::program_options;
+    po::options_description cmdline(
+        "usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ("delay",
+            po::value<std::uint64_t>(&delay)->default_value(0),
+            "time to busy wait in delay loop [microseconds] "
+            "(default: no busy waiting)")
+        ("num_threads",
+            po::value<std::size_t>(&iterations)->default_value(100000),
+            "number of threads to create while measuring execution "
+            "(default: 100000)")
+        ("repetitions",
+            po::value<std::size_t>(&repetitions)->default_value(5),
+            "number of times to repeat the measurement (default: 5)")
+        ("no-header", "do not print out the csv header row")
+        ;
+
+    return hpx::init(cmdline, argc, argv);
+}
@@ -64,6 +64,8 @@ bool header = true;
 bool csv_header = false;
 std::string scaling("weak");
 std::string distribution("static-balanced");
+bool run_now = false;
+bool bulk = false;
 
 std::uint64_t suspend_step = 0;
 std::uint64_t no_suspend_step = 1;
@@ -98,7 +100,8 @@ void print_results(
     if (csv_header)
     {
         header = false;
-        cout << "Delay,Tasks,STasks,OS_Threads,Execution_Time_sec,Warmup_sec";
+        cout << "Delay,Tasks,STasks,OS_Threads,Execution_Time_sec,Warmup_sec"
+                ",Tasks_per_sec";
 
         for (std::uint64_t i = 0; i < counter_shortnames.size(); ++i)
         {
@@ -113,7 +116,9 @@ void print_results(
     {
         cout << "# BENCHMARK: " << benchmark_name
                  << " (" << scaling << " scaling, "
-                 << distribution << " distribution)\n";
+                 << distribution << " distribution, "
+                 << (run_now ? "immediate" : (bulk ? "bulk" : "staged"))
+                 << " creation)\n";
 
         cout << "# VERSION: " << HPX_HAVE_GIT_COMMIT << " "
                  << format_build_date(__DATE__) << "\n"
@@ -129,9 +134,10 @@ void print_results(
                 "## 3:OSTHRDS:OS-threads - Independent Variable\n"
                 "## 4:WTIME:Total Walltime [seconds]\n"
                 "## 5:WARMUP:Total Walltime [seconds]\n"
+                "## 6:RATE:Task Throughput [tasks/second]\n"
                 ;
 
-        std::uint64_t const last_index = 5;
+        std::uint64_t const last_index = 6;
 
         for (std::uint64_t i = 0; i < counter_shortnames.size(); ++i)
         {
@@ -147,14 +153,19 @@ void print_results(
         }
     }
 
+    // total number of tasks executed during this run
+    std::uint64_t const total_tasks =
+        ("weak" == scaling) ? tasks * cores : tasks;
+
     hpx::util::format_to(cout,
-        "%lu, %lu, %lu, %lu, %.14g, %.14g",
+        "%lu, %lu, %lu, %lu, %.14g, %.14g, %.14g",
         delay,
         tasks,
         suspended_tasks,
         cores,
         walltime,
-        warmup_estimate
+        warmup_estimate,
+        total_tasks / walltime
     );
 
     if (ac)
@@ -230,7 +241,7 @@ void stage_worker_static_balanced_stackbased(
             &invoke_worker_timed_suspension
           , "invoke_worker_timed_suspension"
           , hpx::threads::pending
-          , false
+          , run_now
           , hpx::threads::thread_priority_normal
           , target_thread
             );
@@ -239,7 +250,7 @@ void stage_worker_static_balanced_stackbased(
             &invoke_worker_timed_no_suspension
           , "invoke_worker_timed_no_suspension"
           , hpx::threads::pending
-          , false
+          , run_now
           , hpx::threads::thread_priority_normal
           , target_thread
             );
@@ -255,7 +266,7 @@ void stage_worker_static_imbalanced(
             &invoke_worker_timed_suspension
           , "invoke_worker_timed_suspension"
           , hpx::threads::pending
-          , false
+          , run_now
           , hpx::threads::thread_priority_normal
           , 0
             );
@@ -264,7 +275,7 @@ void stage_worker_static_imbalanced(
             &invoke_worker_timed_no_suspension
           , "invoke_worker_timed_no_suspension"
           , hpx::threads::pending
-          , false
+          , run_now
           , hpx::threads::thread_priority_normal
           , 0
             );
@@ -280,17 +291,50 @@ void stage_worker_round_robin(
             &invoke_worker_timed_suspension
           , "invoke_worker_timed_suspension"
           , hpx::threads::pending
-          , false
+          , run_now
             );
     else
         hpx::threads::register_thread_plain(
             &invoke_worker_timed_no_suspension
           , "invoke_worker_timed_no_suspension"
           , hpx::threads::pending
-          , false
+          , run_now
             );
 }
 
+// Register all tasks of a feeder at once, the scheduler distributes them over
+// its queues in one go.
+void stage_workers_bulk(
+    std::uint64_t local_tasks
+    )
+{
+    std::vector<hpx::threads::thread_init_data> data;
+    data.reserve(local_tasks);
+
+    hpx::util::thread_description const desc_suspension(
+        "invoke_worker_timed_suspension");
+    hpx::util::thread_description const desc_no_suspension(
+        "invoke_worker_timed_no_suspension");
+
+    for (std::uint64_t i = 0; i < local_tasks;)
+    {
+        for (std::uint64_t j = 0; j < suspend_step; ++j)
+        {
+            data.emplace_back(&invoke_worker_timed_suspension,
+                desc_suspension);
+            ++i;
+        }
+        for (std::uint64_t j = 0; j < no_suspend_step; ++j)
+        {
+            data.emplace_back(&invoke_worker_timed_no_suspension,
+                desc_no_suspension);
+            ++i;
+        }
+    }
+
+    hpx::threads::register_work_plain(data.data(), data.size());
+}
+
 void stage_workers(
     std::uint64_t target_thread
   , std::uint64_t local_tasks
@@ -313,6 +357,12 @@ void stage_workers(
         return;
     }
 
+    if (bulk)
+    {
+        stage_workers_bulk(local_tasks);
+        return;
+    }
+
     for (std::uint64_t i = 0; i < local_tasks;)
     {
         for (std::uint64_t j = 0; j < suspend_step; ++j)
@@ -340,6 +390,16 @@ int hpx_main(
         if (vm.count("csv-header"))
             csv_header = true;
 
+        if (vm.count("run-now"))
+            run_now = true;
+
+        if (vm.count("bulk"))
+            bulk = true;
+
+        if (run_now && bulk)
+            throw std::invalid_argument(
+                "--run-now and --bulk can't be used together\n");
+
         if (0 == tasks)
             throw std::invalid_argument("count of 0 tasks specified\n");
 
@@ -352,7 +412,8 @@ int hpx_main(
         ///////////////////////////////////////////////////////////////////////
         stage_worker_function stage_worker;
 
-        if ("static-balanced-stackbased" == distribution)
+        if ("static-balanced" == distribution ||
+            "static-balanced-stackbased" == distribution)
             stage_worker = &stage_worker_static_balanced_stackbased;
         else if ("static-imbalanced" == distribution)
             stage_worker = &stage_worker_static_imbalanced;
@@ -532,6 +593,16 @@ int main(
         , value<std::uint64_t>(&delay)->default_value(5)
         , "duration of delay in microseconds")
 
+        ( "run-now"
+        , "create the thread objects immediately instead of staging the "
+          "tasks (this stresses the thread creation and recycling path of "
+          "the scheduler queues)")
+
+        ( "bulk"
+        , "register all tasks of a feeder at once (this exercises the batched "
+          "thread creation path of the scheduler, the tasks are distributed "
+          "by the scheduler regardless of the selected distribution)")
+
         ( "counter"
         , value<std::vector<std::string> >()->composing()
         , "activate and report the specified performance counter")
@@ -8,7 +8,12 @@
 
 #include <hpx/hpx_init.hpp>
 
+#include <boost/program_options.hpp>
+
 #include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 void print_header();
 void run_benchmark(boost::program_options::variables_map & vm);
@@ -42,7 +47,33 @@ int main(int argc, char* argv[])
          "Minimum size of message to send")
         ("max-size",
          boost::program_options::value<std::size_t>()->default_value((1<<22)),
-         "Maximum size of message to send");
+         "Maximum size of message to send")
+        ("tcp-window-size",
+         boost::program_options::value<std::uint32_t>(),
+         "Number of messages which may be in flight on a single TCP "
+         "connection (1 disables pipelining, default: "
+         "hpx.parcel.tcp.window_size)");
+
+    // The TCP window size has to be known before the runtime is started,
+    // extract it from the command line up front.
+    std::vector<std::string> cfg;
+    {
+        using namespace boost::program_options;
+
+        options_description pipelining;
+        pipelining.add_options()
+            ("tcp-window-size", value<std::uint32_t>());
+
+        variables_map vm;
+        store(command_line_parser(argc, argv)
+            .options(pipelining).allow_unregistered().run(), vm);
+
+        if (vm.count("tcp-window-size"))
+        {
+            cfg.push_back("hpx.parcel.tcp.window_size!=" +
+                std::to_string(vm["tcp-window-size"].as<std::uint32_t>()));
+        }
+    }
 
-    return hpx::init(desc, argc, argv);
+    return hpx::init(desc, argc, argv, cfg);
 }
@@ -101,6 +101,9 @@ double ireceive(hpx::naming::id_type dest, std::size_t loop,
 void print_header()
 {
     hpx::cout << "# OSU HPX Bandwidth Test\n"
+              << "# TCP window size: "
+              << hpx::get_config_entry("hpx.parcel.tcp.window_size", "1")
+              << "\n"
               << "# Size    Bandwidth (MB/s)"
               << std::endl;
 }
@@ -142,6 +142,9 @@ double receive(
 void print_header()
 {
     hpx::cout << "# OSU HPX Latency Test\n"
+              << "# TCP window size: "
+              << hpx::get_config_entry("hpx.parcel.tcp.window_size", "1")
+              << "\n"
               << "# Size    Latency (microsec)"
               << std::endl;
 }
@@ -7,7 +7,9 @@
 #include <hpx/hpx.hpp>
 #include <hpx/include/iostreams.hpp>
 #include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
 #include <hpx/include/serialization.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
 
 #include <cstddef>
 #include <complex>
@@ -28,12 +30,73 @@ namespace pingpong
 HPX_PLAIN_ACTION(pingpong::server::get_element, pingpong_get_element_action);
 //HPX_ACTION_USES_MESSAGE_COALESCING(pingpong_get_element_action);
 
+///////////////////////////////////////////////////////////////////////////////
+// Many-to-many variant: every locality runs several concurrent senders, each
+// of which sends its parcels round robin to all other localities. This
+// exercises the outgoing parcel queues with many threads sending to many
+// destinations at the same time.
+void send_to_all(std::vector<hpx::naming::id_type> const& localities,
+    std::size_t sender, std::size_t n)
+{
+    pingpong_get_element_action act;
+
+    std::vector<hpx::future<std::complex<double> > > vec;
+    vec.reserve(n);
+
+    for (std::size_t i = 0; i != n; ++i)
+    {
+        vec.push_back(hpx::async(act,
+            localities[(sender + i) % localities.size()]));
+    }
+
+    hpx::wait_all(vec);
+    for (hpx::future<std::complex<double> >& f : vec)
+        f.get();
+}
+
+void run_many_to_many(std::size_t n, std::size_t senders)
+{
+    std::vector<hpx::naming::id_type> localities =
+        hpx::find_remote_localities();
+
+    hpx::util::high_resolution_timer t;
+
+    std::vector<hpx::future<void> > vec;
+    vec.reserve(senders);
+    for (std::size_t i = 0; i != senders; ++i)
+    {
+        vec.push_back(hpx::async(&send_to_all, std::cref(localities), i, n));
+    }
+    hpx::wait_all(vec);
+
+    double elapsed = t.elapsed();
+
+    // make sure no locality shuts down while others are still sending
+    hpx::lcos::barrier::synchronize();
+
+    hpx::cout << "Locality " << hpx::get_locality_id() << ": "
+              << senders << " senders sent " << senders * n
+              << " parcels to " << localities.size() << " localities in "
+              << elapsed << " [s] (" << (senders * n) / elapsed
+              << " parcels/s)\n" << hpx::flush;
+}
+
 
 int hpx_main(boost::program_options::variables_map& vm)
 {
    //Commandline specific code
     std::size_t const n = vm["nparcels"].as<std::size_t>();
 
+    if (vm.count("many-to-many"))
+    {
+        std::size_t senders = vm["senders"].as<std::size_t>();
+        if (senders == 0)
+            senders = hpx::get_os_thread_count();
+
+        run_many_to_many(n, senders);
+        return hpx::finalize();
+    }
+
     if (0 == hpx::get_locality_id())
     {
         hpx::cout << "Running With nparcel = " << n << "\n" << hpx::flush;
@@ -81,6 +144,13 @@ int main(int argc, char* argv[])
         ("nparcels,n",
          boost::program_options::value<std::size_t>()->default_value(100),
          "the number of parcels to create")
+        ("many-to-many",
+         "send from several threads on every locality to all other "
+         "localities")
+        ("senders",
+         boost::program_options::value<std::size_t>()->default_value(0),
+         "the number of concurrent senders for --many-to-many on each "
+         "locality (default: number of OS threads)")
         ;
     // Initialize and run HPX
     std::vector<std::string> cfg;
@@ -0,0 +1,228 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that credit increments for remote objects are merged
+// while a request to the same locality is in flight, and that buffered
+// decrements are sent along with (after) those increments.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/runtime/agas/interface.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <tests/unit/agas/components/simple_refcnt_checker.hpp>
+#include <tests/unit/agas/components/managed_refcnt_checker.hpp>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using hpx::init;
+using hpx::finalize;
+
+using std::chrono::milliseconds;
+
+using hpx::naming::id_type;
+
+using hpx::components::component_type;
+using hpx::components::get_component_type;
+
+using hpx::agas::garbage_collect;
+
+using hpx::performance_counters::performance_counter;
+
+using hpx::test::simple_refcnt_monitor;
+using hpx::test::managed_refcnt_monitor;
+
+using hpx::util::report_errors;
+
+using hpx::cout;
+using hpx::flush;
+
+///////////////////////////////////////////////////////////////////////////////
+struct refcnt_counters
+{
+    refcnt_counters()
+      : merged_("/agas{locality#0/total}/count/refcnt/merged")
+      , sent_("/agas{locality#0/total}/count/refcnt/sent")
+      , messages_("/agas{locality#0/total}/count/refcnt/messages")
+    {}
+
+    void reset()
+    {
+        merged_.get_value<std::int64_t>(hpx::launch::sync, true);
+        sent_.get_value<std::int64_t>(hpx::launch::sync, true);
+        messages_.get_value<std::int64_t>(hpx::launch::sync, true);
+    }
+
+    std::int64_t merged()
+    {
+        return merged_.get_value<std::int64_t>(hpx::launch::sync);
+    }
+    std::int64_t sent()
+    {
+        return sent_.get_value<std::int64_t>(hpx::launch::sync);
+    }
+    std::int64_t messages()
+    {
+        return messages_.get_value<std::int64_t>(hpx::launch::sync);
+    }
+
+    performance_counter merged_;
+    performance_counter sent_;
+    performance_counter messages_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <
+    typename Client
+>
+void hpx_test_main(
+    variables_map& vm
+  , refcnt_counters& counters
+    )
+{
+    std::uint64_t const delay = vm["delay"].as<std::uint64_t>();
+    std::int64_t const increments = vm["increments"].as<std::int64_t>();
+
+    typedef typename Client::server_type server_type;
+
+    component_type ctype = get_component_type<server_type>();
+    std::vector<id_type> remote_localities = hpx::find_remote_localities(ctype);
+
+    if (remote_localities.empty())
+        throw std::logic_error("this test cannot be run on one locality");
+
+    Client monitor0(remote_localities[0]);
+    Client monitor1(remote_localities[0]);
+
+    {
+        id_type id0 = monitor0.detach().get();
+        id_type id1 = monitor1.detach().get();
+
+        counters.reset();
+
+        // Issue all increments at once, only one request per locality is in
+        // flight, the remaining increments are merged while it is pending.
+        std::vector<hpx::future<std::int64_t> > increfs;
+        increfs.reserve(static_cast<std::size_t>(increments));
+        for (std::int64_t i = 0; i != increments; ++i)
+        {
+            increfs.push_back(hpx::agas::incref(id0.get_gid(), 1, id0));
+        }
+
+        // This decrement is buffered and sent along with the next batch of
+        // increments for the same locality, it is applied after those.
+        hpx::agas::decref(id0.get_gid(), increments);
+
+        // Make sure at least one more batch of increments is sent.
+        HPX_TEST_EQ(hpx::agas::incref(id1.get_gid(), 1, id1).get(), 0);
+
+        hpx::wait_all(increfs);
+        for (hpx::future<std::int64_t>& f : increfs)
+        {
+            // no decrements were compensated by any of the increments
+            HPX_TEST_EQ(f.get(), 0);
+        }
+
+        hpx::agas::decref(id1.get_gid(), 1);
+
+        std::int64_t const merged = counters.merged();
+        std::int64_t const sent = counters.sent();
+        std::int64_t const messages = counters.messages();
+
+        cout << "merged: " << merged << ", sent: " << sent
+             << ", messages: " << messages << "\n" << flush;
+
+        // all increments for the first object which were not sent right
+        // away have been merged
+        HPX_TEST_LT(std::int64_t(0), messages);
+        HPX_TEST_LT(messages, increments);
+        HPX_TEST_LTE(increments - messages, merged);
+
+        // the decrement was sent along with at least one increment
+        HPX_TEST_LTE(messages + 1, sent);
+
+        // The components should still be alive, the credits of the
+        // increments have been returned by the decrements.
+        HPX_TEST_EQ(false, monitor0.is_ready(milliseconds(delay)));
+        HPX_TEST_EQ(false, monitor1.is_ready(milliseconds(delay)));
+    }
+
+    // Flush pending reference counting operations.
+    garbage_collect(remote_localities[0]);
+    garbage_collect();
+    garbage_collect(remote_localities[0]);
+    garbage_collect();
+
+    // The components should be out of scope now.
+    HPX_TEST_EQ(true, monitor0.is_ready(milliseconds(delay)));
+    HPX_TEST_EQ(true, monitor1.is_ready(milliseconds(delay)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(
+    variables_map& vm
+    )
+{
+    {
+        refcnt_counters counters;
+
+        cout << std::string(80, '#') << "\n"
+             << "simple component test\n"
+             << std::string(80, '#') << "\n" << flush;
+
+        hpx_test_main<simple_refcnt_monitor>(vm, counters);
+
+        cout << std::string(80, '#') << "\n"
+             << "managed component test\n"
+             << std::string(80, '#') << "\n" << flush;
+
+        hpx_test_main<managed_refcnt_monitor>(vm, counters);
+    }
+
+    finalize();
+    return report_errors();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(
+    int argc
+  , char* argv[]
+    )
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "delay"
+        , value<std::uint64_t>()->default_value(1000)
+        , "number of milliseconds to wait for object destruction")
+        ( "increments"
+        , value<std::int64_t>()->default_value(100)
+        , "number of concurrent credit increments")
+        ;
+
+    // We need to explicitly enable the test components used by this test.
+    // Decrements are buffered until they are explicitly flushed or sent
+    // along with increments.
+    std::vector<std::string> const cfg = {
+        "hpx.components.simple_refcnt_checker.enabled! = 1",
+        "hpx.components.managed_refcnt_checker.enabled! = 1",
+        "hpx.agas.refcnt_flush_interval! = 60000000"
+    };
+
+    // Initialize and run HPX.
+    return init(cmdline, argc, argv, cfg);
+}
@@ -68,6 +68,11 @@ struct test_server
         return *this;
     }
 
+    // The state of this component can be serialized while its actions are
+    // being executed, which allows it to be migrated using
+    // hpx::components::live_migrate<>.
+    static HPX_CONSTEXPR bool supports_live_migration() { return true; }
+
     HPX_DEFINE_COMPONENT_ACTION(test_server, call, call_action);
     HPX_DEFINE_COMPONENT_ACTION(test_server, busy_work, busy_work_action);
     HPX_DEFINE_COMPONENT_ACTION(test_server, get_data, get_data_action);
@@ -315,6 +320,99 @@ bool test_migrate_busy_component2(hpx::id_type source, hpx::id_type target)
     return true;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+bool test_live_migrate_component(hpx::id_type source, hpx::id_type target)
+{
+    // create component on given locality
+    test_client t1 = hpx::new_<test_client>(source, 42);
+    HPX_TEST_NEQ(hpx::naming::invalid_id, t1.get_id());
+
+    // the new object should live on the source locality
+    HPX_TEST_EQ(t1.call(), source);
+    HPX_TEST_EQ(t1.get_data(), 42);
+
+    try {
+        // migrate t1 to the target, the object is pre-copied
+        test_client t2(hpx::components::live_migrate(t1, target));
+
+        // wait for migration to be done
+        HPX_TEST_NEQ(hpx::naming::invalid_id, t2.get_id());
+
+        // the migrated object should have the same id as before
+        HPX_TEST_EQ(t1.get_id(), t2.get_id());
+
+        // the migrated object should live on the target now
+        HPX_TEST_EQ(t2.call(), target);
+        HPX_TEST_EQ(t2.get_data(), 42);
+    }
+    catch (hpx::exception const& e) {
+        hpx::cout << hpx::get_error_what(e) << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool test_live_migrate_busy_component(hpx::id_type source, hpx::id_type target)
+{
+    test_client t1 = hpx::new_<test_client>(source, 42);
+    HPX_TEST_NEQ(hpx::naming::invalid_id, t1.get_id());
+
+    // the new object should live on the source locality
+    HPX_TEST_EQ(t1.call(), source);
+    HPX_TEST_EQ(t1.get_data(), 42);
+
+    std::size_t N = 100;
+
+    // migrate the object back and forth while it is being accessed, this
+    // forces some of the pre-copied objects to be copied again
+    hpx::future<void> migrate_future = hpx::async(
+        [source, target, t1, N]() mutable
+        {
+            for(std::size_t i = 0; i < N; ++i)
+            {
+                test_client t2(hpx::components::live_migrate(t1, target));
+
+                // wait for migration to be done
+                HPX_TEST_NEQ(hpx::naming::invalid_id, t2.get_id());
+
+                // the migrated object should have the same id as before
+                HPX_TEST_EQ(t1.get_id(), t2.get_id());
+
+                // the migrated object should live on the target now
+                HPX_TEST_EQ(t2.call(), target);
+                HPX_TEST_EQ(t2.get_data(), 42);
+
+                std::swap(source, target);
+            }
+        }
+    );
+
+    hpx::future<void> create_work = hpx::async(
+        [t1, N]()
+        {
+            for(std::size_t i = 0; i < 2*N; ++i)
+            {
+                HPX_TEST_EQ(t1.get_data(), 42);
+            }
+        }
+    );
+
+    hpx::wait_all(migrate_future, create_work);
+
+    // rethrow exceptions
+    try {
+        migrate_future.get();
+        create_work.get();
+    }
+    catch (hpx::exception const& e) {
+        hpx::cout << hpx::get_error_what(e) << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int main()
 {
@@ -352,6 +450,22 @@ int main()
         HPX_TEST(test_migrate_busy_component2(id, hpx::find_here()));
     }
 
+    for (hpx::id_type const& id : localities)
+    {
+        hpx::cout << "test_live_migrate_component: ->" << id << std::endl;
+        HPX_TEST(test_live_migrate_component(hpx::find_here(), id));
+        hpx::cout << "test_live_migrate_component: <-" << id << std::endl;
+        HPX_TEST(test_live_migrate_component(id, hpx::find_here()));
+    }
+
+    for (hpx::id_type const& id : localities)
+    {
+        hpx::cout << "test_live_migrate_busy_component: ->" << id << std::endl;
+        HPX_TEST(test_live_migrate_busy_component(hpx::find_here(), id));
+        hpx::cout << "test_live_migrate_busy_component: <-" << id << std::endl;
+        HPX_TEST(test_live_migrate_busy_component(id, hpx::find_here()));
+    }
+
     return hpx::util::report_errors();
 }
 
@@ -0,0 +1,128 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test sends large zero-copy (pointer) chunks to a second locality on
+// the same host and back. The payload is larger than the shared memory ring,
+// which forces the IPC parcelport to stream the chunks through it.
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/runtime/serialization/serialize_buffer.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+typedef hpx::serialization::serialize_buffer<double> buffer_type;
+
+std::size_t const vsize_default = 1024 * 1024;      // 8 MB of doubles
+std::size_t const numparcels_default = 4;
+
+///////////////////////////////////////////////////////////////////////////////
+buffer_type echo(buffer_type const& data)
+{
+    return data;
+}
+HPX_PLAIN_ACTION(echo);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_large_chunks(hpx::id_type const& id, std::size_t vsize,
+    std::size_t numparcels)
+{
+    std::vector<hpx::future<buffer_type> > results;
+    results.reserve(numparcels);
+
+    for (std::size_t i = 0; i != numparcels; ++i)
+    {
+        buffer_type data(vsize);
+        for (std::size_t j = 0; j != vsize; ++j)
+            data[j] = double(i * vsize + j);
+
+        results.push_back(hpx::async<echo_action>(id, data));
+    }
+
+    hpx::wait_all(results);
+
+    for (std::size_t i = 0; i != numparcels; ++i)
+    {
+        buffer_type data = results[i].get();
+
+        HPX_TEST_EQ(data.size(), vsize);
+        if (data.size() != vsize)
+            continue;
+
+        std::size_t mismatches = 0;
+        for (std::size_t j = 0; j != vsize; ++j)
+        {
+            if (data[j] != double(i * vsize + j))
+                ++mismatches;
+        }
+        HPX_TEST_EQ(mismatches, std::size_t(0));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::int64_t get_counter_value(std::string const& name)
+{
+    hpx::performance_counters::performance_counter c(name);
+    return c.get_value<std::int64_t>(hpx::launch::sync);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t vsize = vm["vsize"].as<std::size_t>();
+    std::size_t numparcels = vm["parcels"].as<std::size_t>();
+
+    std::vector<hpx::id_type> localities = hpx::find_remote_localities();
+    HPX_TEST(!localities.empty());
+
+    for (hpx::id_type const& id : localities)
+    {
+        test_large_chunks(id, vsize, numparcels);
+    }
+
+    // verify that the messages were actually sent over the IPC parcelport
+    std::int64_t sent =
+        get_counter_value("/messages{locality#0/total}/count/ipc/sent");
+    std::int64_t received =
+        get_counter_value("/messages{locality#0/total}/count/ipc/received");
+
+    hpx::cout << "ipc messages sent: " << sent
+              << ", received: " << received << "\n" << hpx::flush;
+
+    HPX_TEST_LTE(std::int64_t(localities.size() * numparcels), sent);
+    HPX_TEST_LTE(std::int64_t(localities.size() * numparcels), received);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("vsize", value<std::size_t>()->default_value(vsize_default),
+         "number of doubles sent with each parcel (default: 1048576)")
+        ("parcels", value<std::size_t>()->default_value(numparcels_default),
+         "number of parcels sent to each locality (default: 4)")
+        ;
+
+    // This test is meaningful only if the IPC parcelport is used for
+    // localities running on the same host.
+    std::vector<std::string> const cfg = {
+        "hpx.parcel.ipc.enable! = 1"
+    };
+
+    HPX_TEST_EQ(hpx::init(desc_commandline, argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,145 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test sends parcels compressed with the LZ4 and Zstandard (block
+// compression) serialization filters to a remote locality, which verifies
+// that the decompressed arguments match what was sent.
+
+#include <hpx/hpx.hpp>
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/compression_registration.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// small payloads fit into a single compression block, large payloads span
+// several blocks (the default block size is 256kB)
+std::size_t const small_size = 16;
+std::size_t const large_size = 16384;
+std::size_t const numparcels_default = 10;
+
+std::vector<std::string> generate_data(std::size_t size, unsigned int seed)
+{
+    std::vector<std::string> data(size);
+    for (std::size_t i = 0; i != size; ++i)
+        data[i] = std::to_string(seed + i) + std::string(48, 'x');
+    return data;
+}
+
+bool verify_data(std::vector<std::string> const& data, unsigned int seed)
+{
+    return data == generate_data(data.size(), seed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+#if defined(HPX_HAVE_COMPRESSION_LZ4)
+bool verify_lz4(std::vector<std::string> const& data, unsigned int seed)
+{
+    return verify_data(data, seed);
+}
+
+HPX_DECLARE_PLAIN_ACTION(verify_lz4, verify_lz4_action);
+HPX_ACTION_USES_LZ4_COMPRESSION(verify_lz4_action)
+HPX_PLAIN_ACTION(verify_lz4, verify_lz4_action);
+#endif
+
+#if defined(HPX_HAVE_COMPRESSION_ZSTD)
+bool verify_zstd(std::vector<std::string> const& data, unsigned int seed)
+{
+    return verify_data(data, seed);
+}
+
+HPX_DECLARE_PLAIN_ACTION(verify_zstd, verify_zstd_action);
+HPX_ACTION_USES_ZSTD_COMPRESSION(verify_zstd_action)
+HPX_PLAIN_ACTION(verify_zstd, verify_zstd_action);
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Action>
+void test_round_trip(hpx::id_type const& id, std::size_t size)
+{
+    std::vector<hpx::future<bool> > results;
+    results.reserve(numparcels_default);
+
+    for (std::size_t i = 0; i != numparcels_default; ++i)
+    {
+        unsigned int seed = static_cast<unsigned int>(i * size);
+        results.push_back(
+            hpx::async<Action>(id, generate_data(size, seed), seed));
+    }
+
+    hpx::wait_all(results);
+
+    for (hpx::future<bool>& f : results)
+    {
+        HPX_TEST(f.get());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::int64_t sum_counters(char const* name)
+{
+    using namespace hpx::performance_counters;
+
+    std::int64_t result = 0;
+    for (performance_counter const& c : discover_counters(name))
+    {
+        result += c.get_value<std::int64_t>(hpx::launch::sync);
+    }
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_remote_localities();
+    HPX_TEST(!localities.empty());
+
+    for (hpx::id_type const& id : localities)
+    {
+#if defined(HPX_HAVE_COMPRESSION_LZ4)
+        test_round_trip<verify_lz4_action>(id, small_size);
+        test_round_trip<verify_lz4_action>(id, large_size);
+#endif
+#if defined(HPX_HAVE_COMPRESSION_ZSTD)
+        test_round_trip<verify_zstd_action>(id, small_size);
+        test_round_trip<verify_zstd_action>(id, large_size);
+#endif
+    }
+
+    // make sure compression was actually invoked, the payload is highly
+    // compressible and dominates the overall amount of data sent
+    std::int64_t data_sent =
+        sum_counters("/data{locality#0/total}/count/*/sent");
+    std::int64_t serialize_sent =
+        sum_counters("/serialize{locality#0/total}/count/*/sent");
+
+    hpx::cout << "data sent: " << data_sent
+              << ", serialized data sent: " << serialize_sent
+              << std::endl;
+
+    HPX_TEST_LT(serialize_sent, data_sent);
+
+    return hpx::finalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -11,7 +11,10 @@
 #include <hpx/include/compression_registration.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdlib>
+#include <ctime>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -34,7 +37,7 @@ generate_parcel(hpx::id_type const& dest_id, hpx::id_type const& cont, T && data
         std::true_type(), std::move(dest), std::move(addr),
         hpx::actions::typed_continuation<hpx::id_type>(cont),
         Action(), hpx::threads::thread_priority_normal,
-        std::forward<T>(data));
+        std::forward<T>(data)));
 
     p.set_source_id(hpx::find_here());
     p.size() = 4096;
@@ -68,6 +71,10 @@ HPX_ACTION_USES_BZIP2_COMPRESSION(test1_action)
 HPX_ACTION_USES_ZLIB_COMPRESSION(test1_action)
 #elif defined(HPX_HAVE_COMPRESSION_SNAPPY)
 HPX_ACTION_USES_SNAPPY_COMPRESSION(test1_action)
+#elif defined(HPX_HAVE_COMPRESSION_LZ4)
+HPX_ACTION_USES_LZ4_COMPRESSION(test1_action)
+#elif defined(HPX_HAVE_COMPRESSION_ZSTD)
+HPX_ACTION_USES_ZSTD_COMPRESSION(test1_action)
 #endif
 
 HPX_REGISTER_ACTION(test1_action);
@@ -123,6 +130,10 @@ HPX_ACTION_USES_BZIP2_COMPRESSION(test2_action)
 HPX_ACTION_USES_ZLIB_COMPRESSION(test2_action)
 #elif defined(HPX_HAVE_COMPRESSION_SNAPPY)
 HPX_ACTION_USES_SNAPPY_COMPRESSION(test2_action)
+#elif defined(HPX_HAVE_COMPRESSION_LZ4)
+HPX_ACTION_USES_LZ4_COMPRESSION(test2_action)
+#elif defined(HPX_HAVE_COMPRESSION_ZSTD)
+HPX_ACTION_USES_ZSTD_COMPRESSION(test2_action)
 #endif
 
 HPX_PLAIN_ACTION(test2, test2_action);
@@ -229,6 +240,64 @@ void test_mixed_arguments(hpx::id_type const& id)
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// the (non-zero-copy) data of this action spans several compression blocks
+hpx::id_type test3(std::vector<std::string> const& data)
+{
+    return hpx::find_here();
+}
+
+HPX_DECLARE_PLAIN_ACTION(test3, test3_action);
+
+#if defined(HPX_HAVE_COMPRESSION_BZIP2)
+HPX_ACTION_USES_BZIP2_COMPRESSION(test3_action)
+#elif defined(HPX_HAVE_COMPRESSION_ZLIB)
+HPX_ACTION_USES_ZLIB_COMPRESSION(test3_action)
+#elif defined(HPX_HAVE_COMPRESSION_SNAPPY)
+HPX_ACTION_USES_SNAPPY_COMPRESSION(test3_action)
+#elif defined(HPX_HAVE_COMPRESSION_LZ4)
+HPX_ACTION_USES_LZ4_COMPRESSION(test3_action)
+#elif defined(HPX_HAVE_COMPRESSION_ZSTD)
+HPX_ACTION_USES_ZSTD_COMPRESSION(test3_action)
+#endif
+
+HPX_PLAIN_ACTION(test3, test3_action);
+
+void test_large_argument(hpx::id_type const& id)
+{
+    std::vector<std::string> data(16384);
+    for (std::string& s : data)
+        s = std::to_string(std::rand()) + std::string(48, 'x');
+
+    std::vector<hpx::future<hpx::id_type> > results;
+    results.reserve(numparcels_default);
+
+    // create parcels
+    std::vector<hpx::parcelset::parcel> parcels;
+    for (std::size_t i = 0; i != numparcels_default; ++i)
+    {
+        hpx::lcos::promise<hpx::id_type> p;
+        auto f = p.get_future();
+
+        parcels.push_back(
+            generate_parcel<test3_action>(id, p.get_id(), data)
+        );
+
+        results.push_back(std::move(f));
+    }
+
+    // send parcels
+    hpx::get_runtime().get_parcel_handler().put_parcels(std::move(parcels));
+
+    // verify all messages got actually sent to the correct locality
+    hpx::wait_all(results);
+
+    for (hpx::future<hpx::id_type>& f : results)
+    {
+        HPX_TEST(f.get() == id);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void verify_counters()
 {
@@ -289,6 +358,7 @@ int hpx_main(boost::program_options::variables_map& vm)
         test_plain_argument(id);
         test_future_argument(id);
         test_mixed_arguments(id);
+        test_large_argument(id);
     }
 
     // make sure compression was actually invoked
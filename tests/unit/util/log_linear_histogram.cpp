@@ -0,0 +1,102 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/util/log_linear_histogram.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+typedef hpx::util::log_linear_histogram<> histogram_type;
+
+///////////////////////////////////////////////////////////////////////////////
+void bucket_boundaries()
+{
+    std::uint64_t const values[] =
+    {
+        0, 1, 7, 8, 9, 15, 16, 17, 100, 1000, 123456789,
+        std::uint64_t(1) << 40, ~std::uint64_t(0) >> 1
+    };
+
+    for (std::uint64_t value : values)
+    {
+        std::size_t index = histogram_type::bucket_index(value);
+        HPX_TEST_LT(index, histogram_type::num_buckets);
+        HPX_TEST_LTE(histogram_type::bucket_lower_bound(index), value);
+        HPX_TEST_LT(value, histogram_type::bucket_upper_bound(index));
+    }
+
+    // the largest value ends up in the last bucket
+    HPX_TEST_EQ(histogram_type::bucket_index(~std::uint64_t(0)),
+        histogram_type::num_buckets - 1);
+
+    // neighboring buckets are adjacent
+    for (std::size_t i = 0; i != histogram_type::num_buckets - 1; ++i)
+    {
+        HPX_TEST_EQ(histogram_type::bucket_upper_bound(i),
+            histogram_type::bucket_lower_bound(i + 1));
+    }
+}
+
+void collect_and_reset()
+{
+    histogram_type h;
+    for (std::uint64_t i = 0; i != 1000; ++i)
+        h.add(i);
+
+    std::vector<std::int64_t> data(histogram_type::num_buckets, 0);
+    h.collect(data, false);
+    HPX_TEST_EQ(std::accumulate(data.begin(), data.end(), std::int64_t(0)),
+        std::int64_t(1000));
+
+    // collecting adds to the given data
+    h.collect(data, true);
+    HPX_TEST_EQ(std::accumulate(data.begin(), data.end(), std::int64_t(0)),
+        std::int64_t(2000));
+
+    std::vector<std::int64_t> empty(histogram_type::num_buckets, 0);
+    h.collect(empty, false);
+    HPX_TEST_EQ(std::accumulate(empty.begin(), empty.end(), std::int64_t(0)),
+        std::int64_t(0));
+}
+
+void linear_conversion()
+{
+    histogram_type h;
+    for (std::uint64_t i = 0; i != 100; ++i)
+        h.add(5);
+    for (std::uint64_t i = 0; i != 50; ++i)
+        h.add(5000);
+
+    std::vector<std::int64_t> data(histogram_type::num_buckets, 0);
+    h.collect(data, false);
+
+    std::vector<std::int64_t> result =
+        histogram_type::to_linear(data, 0, 1000, 10);
+
+    // parameters, underflow bucket, 10 buckets, overflow bucket
+    HPX_TEST_EQ(result.size(), std::size_t(15));
+    HPX_TEST_EQ(result[0], std::int64_t(0));
+    HPX_TEST_EQ(result[1], std::int64_t(1000));
+    HPX_TEST_EQ(result[2], std::int64_t(10));
+    HPX_TEST_EQ(result[3], std::int64_t(0));
+    HPX_TEST_EQ(result[4], std::int64_t(100));
+    HPX_TEST_EQ(result[14], std::int64_t(50));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    {
+        bucket_boundaries();
+        collect_and_reset();
+        linear_conversion();
+    }
+
+    return hpx::util::report_errors();
+}